@@ -18,6 +18,8 @@
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_tools.h>
 
+#include <deal.II/lac/sparsity_pattern.h>
+
 #include <deal.II/hp/dof_handler.h>
 #include <deal.II/hp/q_collection.h>
 #include <deal.II/hp/mapping_collection.h>
@@ -39,6 +41,13 @@ catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(h
     hp::QCollection<2>& boundary_q_collection,
     const unsigned int n_element);
 
+// Sparsity pattern of a Catmull-Clark system built directly from the one-ring
+// patches of the cells, without a DynamicSparsityPattern. The rows are counted
+// and filled in parallel. Constraints are not condensed into the pattern, as
+// for DoFTools::make_sparsity_pattern with keep_constrained_dofs = true.
+void
+catmull_clark_make_sparsity_pattern(const hp::DoFHandler<2, 3> &dof_handler, SparsityPattern &sparsity_pattern);
+
 template<int dim, int spacedim>
 class CatmullClark{
 public:
@@ -46,35 +55,51 @@ public:
     
     CatmullClark(hp::DoFHandler<dim, spacedim> &dh);
     
+    // Persistent object for n_element components, set up on a mesh by reinit(). The FE, quadrature and mapping
+    // objects are kept across calls of reinit() and only extended when a new valence/orientation shows up, so
+    // after a topology change only the per-cell assignment is recomputed.
+    CatmullClark(const unsigned int n_element);
+    
+    // assigns the elements to the cells of the current mesh, distributes the dofs and
+    // sets vec_values to the control point coordinates
+    void reinit(hp::DoFHandler<dim, spacedim> &dof_handler, Vector<double> &vec_values);
+    
    void set_FECollection(hp::DoFHandler<dim, spacedim> &dof_handler, const unsigned int n_element);
     
     void set_MappingCollection(hp::DoFHandler<dim, spacedim> &dof_handler, Vector<double> &vec_values, const unsigned int n_element);
     
-    hp::FECollection<dim,spacedim> get_FECollection(){
+    const hp::FECollection<dim,spacedim> &get_FECollection() const{
         return fe_collection;
     }
     
-    hp::MappingCollection<dim,spacedim> get_MappingCollection(){
+    const hp::MappingCollection<dim,spacedim> &get_MappingCollection() const{
         return mapping_collection;
     }
         
-    hp::QCollection<dim> get_QCollection(){
+    const hp::QCollection<dim> &get_QCollection() const{
         return q_collection;
     }
     
-    hp::QCollection<dim> get_boundary_QCollection(){
+    const hp::QCollection<dim> &get_boundary_QCollection() const{
            return q_boundary_collection;
        }
     
-    std::map<unsigned int, unsigned int> dof_to_vert_indices_mapping(){
+    const std::map<unsigned int, unsigned int> &dof_to_vert_indices_mapping() const{
         return indices_mapping;
     }
     
     void new_dofs_for_cells(hp::DoFHandler<dim, spacedim> &dof_handler, unsigned int n_element);
 
 private:
+    const unsigned int n_element;
+    
+    // registry of the elements: valence -> (first vertex of the orientation, fe index)
     std::map<unsigned int, std::vector<std::pair<unsigned int, unsigned int>>> indices_mapping_valence_to_fe;
     
+    const hp::DoFHandler<dim, spacedim> *mapping_dof_handler = nullptr;
+    
+    const Vector<double> *mapping_euler_vector = nullptr;
+    
     std::vector<std::set<typename hp::DoFHandler<dim,spacedim>::active_cell_iterator>> cell_patch_vector;
     
     std::vector<std::set<typename hp::DoFHandler<dim,spacedim>::active_cell_iterator>> cell_patches(hp::DoFHandler<dim, spacedim> &dof_handler);
@@ -127,6 +152,16 @@ private:
 
 };
 
+// Same as catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs() above, but with a
+// CatmullClark object that is kept by the caller. Calling this again after the mesh has been refined keeps the
+// elements, quadratures and mappings set up before and only appends those for new valence/orientation pairs.
+void
+catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(CatmullClark<2, 3> &catmull_clark, hp::DoFHandler<2, 3> &dof_handler, hp::FECollection<2, 3>& fe_collection,
+    Vector<double> &vec_values,
+    hp::MappingCollection<2,3>& mapping_collection,
+    hp::QCollection<2>& q_collection,
+    hp::QCollection<2>& boundary_q_collection);
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif /* Catmull_Clark_DoFs_Implementation_hpp */
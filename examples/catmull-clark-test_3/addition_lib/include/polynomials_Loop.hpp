@@ -0,0 +1,107 @@
+//
+//  polynomials_Loop.hpp
+//  step-4
+//
+//  Quartic box-spline basis of a regular Loop subdivision patch, the
+//  triangular counterpart of polynomials_Catmull_Clark::regular.
+//
+
+#ifndef polynomials_Loop_hpp
+#define polynomials_Loop_hpp
+
+#include <stdio.h>
+#include <deal.II/base/config.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+
+#include <array>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+// A regular Loop patch is the triangle inside the 1-ring of its three
+// (valence 6) vertices, i.e. 12 control points. The unit point is
+// (v, w) with barycentric u = 1 - v - w, and the basis functions follow
+// the control point ordering of Stam, "Evaluation of Loop subdivision
+// surfaces" (1998).
+template<int dim>
+class polynomials_Loop
+{
+public:
+    polynomials_Loop(){};
+    
+    unsigned int
+    degree() const;
+    
+    std::string
+    name() const;
+    
+    // Loop's vertex weight beta(n) of a vertex with the given valence;
+    // the new vertex position is (1 - n beta) v + beta sum(neighbours).
+    static double vertex_weight(const unsigned int valence);
+    
+    class regular{
+    public:
+        regular(){};
+        
+        void compute(const Point<dim> &unit_point,
+        std::vector<double>&values,
+        std::vector<Tensor<1,dim>> &grads,
+        std::vector<Tensor<2,dim>> &grad_grads)const;
+        
+        double value( const unsigned int i, const Point<dim> &unit_point) const;
+        
+        Tensor<1,dim> grads( const unsigned int i, const Point<dim> &unit_point) const;
+        
+        Tensor<2,dim> grad_grads( const unsigned int i, const Point<dim> &unit_point) const;
+        
+        static const unsigned int n_functions = 12;
+        
+    private:
+        // coefficient (times 12) and exponents of u, v, w of one term
+        struct Monomial{
+            int coefficient;
+            std::array<unsigned int, 3> exponents;
+        };
+        
+        static const std::vector<Monomial> &terms(const unsigned int i);
+        
+        // value, first and second derivatives of basis function i with
+        // respect to (v, w), u eliminated by the chain rule
+        void evaluate(const unsigned int i,
+                      const Point<dim> &unit_point,
+                      double &value,
+                      Tensor<1,dim> &grad,
+                      Tensor<2,dim> &grad_grad) const;
+    };
+    
+private:
+    const unsigned int my_degree = 4;
+    
+
+};
+
+
+
+template <int dim>
+inline unsigned int
+polynomials_Loop<dim>::degree() const
+{
+    return my_degree;
+}
+
+
+
+template <int dim>
+inline std::string
+polynomials_Loop<dim>::name() const
+{
+    return "Loop";
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif /* polynomials_Loop_hpp */
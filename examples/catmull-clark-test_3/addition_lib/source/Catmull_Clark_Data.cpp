@@ -7,13 +7,17 @@
 
 #include "Catmull_Clark_Data.hpp"
 
+#include <deal.II/base/parallel.h>
+
+#include <numeric>
+
 DEAL_II_NAMESPACE_OPEN
 
 void
 catmull_clark_create_fecollection_and_distribute_dofs(hp::DoFHandler<2, 3> &dof_handler, hp::FECollection<2, 3>& fe_collection)
 {
     auto catmull_clark = std::make_shared <CatmullClark<2, 3>>(dof_handler);
-    fe_collection = catmull_clark->get_FECollection();
+    fe_collection = hp::FECollection<2, 3>(catmull_clark->get_FECollection());
 }
 
 
@@ -21,11 +25,90 @@ catmull_clark_create_fecollection_and_distribute_dofs(hp::DoFHandler<2, 3> &dof_
 void
 catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(hp::DoFHandler<2, 3> &dof_handler, hp::FECollection<2, 3>& fe_collection,Vector<double> &vec_values, hp::MappingCollection<2,3>& mapping_collection, hp::QCollection<2>& q_collection,hp::QCollection<2>& boundary_q_collection, const unsigned int n_element)
 {
-    auto catmull_clark = std::make_shared <CatmullClark<2, 3>>(dof_handler,vec_values, n_element);
-    fe_collection = catmull_clark->get_FECollection();
-    mapping_collection = catmull_clark->get_MappingCollection();
-    q_collection = catmull_clark->get_QCollection();
-    boundary_q_collection = catmull_clark->get_boundary_QCollection();
+    CatmullClark<2, 3> catmull_clark(n_element);
+    catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(catmull_clark, dof_handler, fe_collection, vec_values, mapping_collection, q_collection, boundary_q_collection);
+}
+
+
+
+void
+catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(CatmullClark<2, 3> &catmull_clark, hp::DoFHandler<2, 3> &dof_handler, hp::FECollection<2, 3>& fe_collection,Vector<double> &vec_values, hp::MappingCollection<2,3>& mapping_collection, hp::QCollection<2>& q_collection,hp::QCollection<2>& boundary_q_collection)
+{
+    catmull_clark.reinit(dof_handler, vec_values);
+    fe_collection = hp::FECollection<2, 3>(catmull_clark.get_FECollection());
+    mapping_collection = catmull_clark.get_MappingCollection();
+    q_collection = catmull_clark.get_QCollection();
+    boundary_q_collection = catmull_clark.get_boundary_QCollection();
+}
+
+
+
+void
+catmull_clark_make_sparsity_pattern(const hp::DoFHandler<2, 3> &dof_handler, SparsityPattern &sparsity_pattern)
+{
+    const types::global_dof_index n_dofs = dof_handler.n_dofs();
+    
+    // dofs of every cell (its one-ring patch) and, in compressed row storage, the cells every dof belongs to
+    std::vector<std::vector<types::global_dof_index>> cell_dof_indices(dof_handler.get_triangulation().n_active_cells());
+    std::vector<unsigned int> dof_to_cell_start(n_dofs + 1, 0);
+    for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+        std::vector<types::global_dof_index> &local_dof_indices = cell_dof_indices[cell->active_cell_index()];
+        local_dof_indices.resize(cell->get_fe().dofs_per_cell);
+        cell->get_dof_indices(local_dof_indices);
+        for (const types::global_dof_index dof : local_dof_indices)
+            ++dof_to_cell_start[dof + 1];
+    }
+    std::partial_sum(dof_to_cell_start.begin(), dof_to_cell_start.end(), dof_to_cell_start.begin());
+    
+    std::vector<unsigned int> dof_to_cells(dof_to_cell_start.back());
+    std::vector<unsigned int> next_entry(dof_to_cell_start.begin(), dof_to_cell_start.end() - 1);
+    for (unsigned int cell_index = 0; cell_index < cell_dof_indices.size(); ++cell_index)
+        for (const types::global_dof_index dof : cell_dof_indices[cell_index])
+            dof_to_cells[next_entry[dof]++] = cell_index;
+    
+    // the columns of a row are the union of the patches of all cells sharing the dof
+    const auto row_columns = [&](const types::global_dof_index row, std::vector<types::global_dof_index> &columns)
+    {
+        columns.clear();
+        for (unsigned int k = dof_to_cell_start[row]; k < dof_to_cell_start[row + 1]; ++k)
+        {
+            const std::vector<types::global_dof_index> &local_dof_indices = cell_dof_indices[dof_to_cells[k]];
+            columns.insert(columns.end(), local_dof_indices.begin(), local_dof_indices.end());
+        }
+        std::sort(columns.begin(), columns.end());
+        columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+    };
+    
+    const unsigned int grainsize = 64;
+    std::vector<unsigned int> row_lengths(n_dofs);
+    parallel::apply_to_subranges(types::global_dof_index(0), n_dofs,
+                                 [&](const types::global_dof_index begin, const types::global_dof_index end)
+                                 {
+                                     std::vector<types::global_dof_index> columns;
+                                     for (types::global_dof_index row = begin; row < end; ++row)
+                                     {
+                                         row_columns(row, columns);
+                                         row_lengths[row] = columns.size();
+                                     }
+                                 },
+                                 grainsize);
+    
+    sparsity_pattern.reinit(n_dofs, n_dofs, row_lengths);
+    
+    // every row is written by exactly one task
+    parallel::apply_to_subranges(types::global_dof_index(0), n_dofs,
+                                 [&](const types::global_dof_index begin, const types::global_dof_index end)
+                                 {
+                                     std::vector<types::global_dof_index> columns;
+                                     for (types::global_dof_index row = begin; row < end; ++row)
+                                     {
+                                         row_columns(row, columns);
+                                         sparsity_pattern.add_entries(row, columns.begin(), columns.end(), true);
+                                     }
+                                 },
+                                 grainsize);
+    sparsity_pattern.compress();
 }
 
 
@@ -107,21 +190,39 @@ CatmullClark<dim,spacedim>:: empty_boundary_quadrature()
 
 template<int dim, int spacedim>
 CatmullClark<dim,spacedim>::CatmullClark(hp::DoFHandler<dim, spacedim> &dof_handler,Vector<double> &vec_values, const unsigned int n_element)
+:
+n_element(n_element)
+{
+    reinit(dof_handler, vec_values);
+}
+
+
+
+template<int dim, int spacedim>
+CatmullClark<dim,spacedim>::CatmullClark(const unsigned int n_element)
+:
+n_element(n_element)
+{}
+
+
+
+template<int dim, int spacedim>
+void CatmullClark<dim,spacedim>::reinit(hp::DoFHandler<dim, spacedim> &dof_handler, Vector<double> &vec_values)
 {
     cell_patch_vector = cell_patches(dof_handler);
     set_FECollection(dof_handler,n_element);
     dof_handler.distribute_dofs(fe_collection);
+    indices_mapping.clear();
     new_dofs_for_cells(dof_handler,n_element);
     
     vec_values.reinit(dof_handler.n_dofs());
     auto vertices = dof_handler.get_triangulation().get_vertices();
 
-    for (unsigned int v_id = 0; v_id < indices_mapping.size(); ++v_id)
+    for (const auto &vertex_and_dof : indices_mapping)
     {
         for (unsigned int j = 0; j < n_element;++j)
         {
-            unsigned int first_dof_id = indices_mapping.find(v_id)->second;
-            vec_values[first_dof_id + j] = vertices[v_id][j];
+            vec_values[vertex_and_dof.second + j] = vertices[vertex_and_dof.first][j];
         }
     }
     
@@ -132,6 +233,8 @@ CatmullClark<dim,spacedim>::CatmullClark(hp::DoFHandler<dim, spacedim> &dof_hand
 
 template<int dim, int spacedim>
 CatmullClark<dim,spacedim>::CatmullClark(hp::DoFHandler<dim, spacedim> &dof_handler)
+:
+n_element(1)
 {
     cell_patch_vector = cell_patches(dof_handler);
     set_FECollection(dof_handler,1);
@@ -143,8 +246,9 @@ CatmullClark<dim,spacedim>::CatmullClark(hp::DoFHandler<dim, spacedim> &dof_hand
 
 template<int dim, int spacedim>
 void CatmullClark<dim,spacedim>::set_FECollection(hp::DoFHandler<dim, spacedim> &dof_handler, const unsigned int n_element){
-    std::map<unsigned int, std::vector<std::pair<unsigned int, unsigned int>>> map_valence_to_fe_indices;
-    unsigned int                i_fe = 0;
+    // elements registered by earlier calls are reused, new valence/orientation pairs are appended
+    std::map<unsigned int, std::vector<std::pair<unsigned int, unsigned int>>> &map_valence_to_fe_indices = indices_mapping_valence_to_fe;
+    unsigned int                i_fe = fe_collection.size();
     QGauss<dim> qpts(2);
     auto qpts_irreg = get_adaptive_quadrature(5,qpts);
     for (auto cell = dof_handler.begin_active(); cell != dof_handler.end();
@@ -276,7 +380,6 @@ void CatmullClark<dim,spacedim>::set_FECollection(hp::DoFHandler<dim, spacedim>
             ++i_fe;
         }
     }
-    indices_mapping_valence_to_fe = map_valence_to_fe_indices;
 }
 
 
@@ -287,15 +390,17 @@ CatmullClark<dim,spacedim>::set_MappingCollection(hp::DoFHandler<dim, spacedim>
     const ComponentMask mask(spacedim, true);
     AssertDimension(dof_handler.n_dofs(), indices_mapping.size()*n_element);
     
-    unsigned int fe_id = 0;
-    for (unsigned int iv = 0; iv < indices_mapping_valence_to_fe.size(); ++iv)
+    // the mappings refer to the dof handler and the euler vector, they only have to be rebuilt if those are different objects
+    if (&dof_handler != mapping_dof_handler || &vec_values != mapping_euler_vector)
     {
-        for (unsigned int i = 0; i < indices_mapping_valence_to_fe[iv].size(); ++i, ++fe_id){
-                MappingFEField_hp<dim,spacedim,Vector<double>,hp::DoFHandler<2,3>> mapping(dof_handler, vec_values, fe_id, mask);
-//                MappingQ<2, 3> mapping(3);
-
-                mapping_collection.push_back(mapping);
-        }
+        mapping_collection = hp::MappingCollection<dim,spacedim>();
+        mapping_dof_handler = &dof_handler;
+        mapping_euler_vector = &vec_values;
+    }
+    
+    for (unsigned int fe_id = mapping_collection.size(); fe_id < fe_collection.size(); ++fe_id){
+        MappingFEField_hp<dim,spacedim,Vector<double>,hp::DoFHandler<2,3>> mapping(dof_handler, vec_values, fe_id, mask);
+        mapping_collection.push_back(mapping);
     }
 }
 
@@ -324,11 +429,9 @@ std::set<typename hp::DoFHandler<dim,spacedim>::active_cell_iterator>> CatmullCl
     {
         std::set<typename hp::DoFHandler<dim,spacedim>::active_cell_iterator> cells_in_patch;
         for (unsigned int v=0; v< GeometryInfo<dim>::vertices_per_cell;++v){
-            typename std::multimap<unsigned int, typename hp::DoFHandler<dim,spacedim>::active_cell_iterator>::iterator map_it;
-            for (map_it = vertex_to_cell_map.begin();map_it!= vertex_to_cell_map.end();map_it++){
-                if(map_it->first == cell->vertex_index(v)){
-                    cells_in_patch.insert(map_it->second);
-                }
+            const auto cells_at_vertex = vertex_to_cell_map.equal_range(cell->vertex_index(v));
+            for (auto map_it = cells_at_vertex.first; map_it != cells_at_vertex.second; ++map_it){
+                cells_in_patch.insert(map_it->second);
             }
         }
         vector_of_sets.push_back(cells_in_patch);
@@ -893,6 +893,7 @@ private:
     hp::DoFHandler<dim,spacedim> dof_handler;
     hp::FECollection<dim,spacedim> fe_collection;
     hp::MappingCollection<dim,spacedim> mapping_collection;
+    CatmullClark<dim,spacedim> catmull_clark{3};
     hp::QCollection<dim> q_collection;
     hp::QCollection<dim> boundary_q_collection;
     SparsityPattern      sparsity_pattern;
@@ -1052,15 +1053,10 @@ double Nonlinear_shell<dim, spacedim> :: get_error_residual(){
 template <int dim, int spacedim>
 void Nonlinear_shell<dim, spacedim> :: setup_system()
 {
-    catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(dof_handler,fe_collection,vec_values,mapping_collection,q_collection,boundary_q_collection,3);
+    catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(catmull_clark,dof_handler,fe_collection,vec_values,mapping_collection,q_collection,boundary_q_collection);
     std::cout << "   Number of dofs: " << dof_handler.n_dofs()
     << std::endl;
-    DynamicSparsityPattern dynamic_sparsity_pattern(dof_handler.n_dofs());
-//    constraints.clear();
-    DoFTools::make_sparsity_pattern(dof_handler, dynamic_sparsity_pattern, constraints);
-    sparsity_pattern.copy_from(dynamic_sparsity_pattern);
-    std::ofstream out("CC_sparsity_pattern.svg");
-    sparsity_pattern.print_svg(out);
+    catmull_clark_make_sparsity_pattern(dof_handler, sparsity_pattern);
     tangent_matrix.reinit(sparsity_pattern);
     boundary_mass_matrix.reinit(sparsity_pattern);
     solution_increment.reinit(dof_handler.n_dofs());
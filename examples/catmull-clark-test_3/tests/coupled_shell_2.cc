@@ -432,12 +432,13 @@ int main()
     hp::DoFHandler<dim,spacedim> dof_handler(mesh);
     hp::FECollection<dim,spacedim> fe_collection;
     hp::MappingCollection<dim,spacedim> mapping_collection;
+    CatmullClark<dim,spacedim> catmull_clark{3};
     hp::QCollection<dim> q_collection;
     hp::QCollection<dim> boundary_q_collection;
     
     Vector<double> vec_values;
     
-    catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(dof_handler,fe_collection,vec_values,mapping_collection,q_collection,boundary_q_collection,3);
+    catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(catmull_clark,dof_handler,fe_collection,vec_values,mapping_collection,q_collection,boundary_q_collection);
     
 
     AffineConstraints<double> constraints;
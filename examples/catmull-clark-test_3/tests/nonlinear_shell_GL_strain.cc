@@ -37,6 +37,8 @@
 #include <deal.II/base/numbers.h>
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/quadrature_point_data.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/timer.h>
 
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/full_matrix.h>
@@ -53,6 +55,7 @@
 
 #include <deal.II/lac/solver_cg.h>
 #include <deal.II/lac/precondition.h>
+#include <deal.II/lac/diagonal_matrix.h>
 
 #include <deal.II/hp/dof_handler.h>
 #include <deal.II/hp/fe_values.h>
@@ -745,6 +748,15 @@ public:
         return material->get_deformed_covariant_bases_deriv();
     }
     
+    // copy of the material state advanced by a trial increment, the stored state is left untouched
+    material_neo_hookean<dim,spacedim> get_trial_material(const Tensor<1, dim, Tensor<1,spacedim>> delta_u_der, /* du_{,a} */
+                                                          const Tensor<2, dim, Tensor<1,spacedim>> delta_u_der2 /* du_{,ab} */) const
+    {
+        material_neo_hookean<dim,spacedim> trial_material(*material);
+        trial_material.update(delta_u_der, delta_u_der2);
+        return trial_material;
+    }
+    
 private:
     std::shared_ptr< material_neo_hookean<dim,spacedim> > material;
     std::string material_type = "neo_hookean";
@@ -870,20 +882,327 @@ private:
 
 
 
+// Matrix-free application of the linearised shell tangent. Per quadrature
+// point only the material state (resultants, D tensors, deformed bases) and
+// JxW are cached. The parametric shape function derivatives depend on the
+// Catmull-Clark element and the quadrature rule only, so they are stored once
+// per active fe index.
+template<int dim, int spacedim>
+class Shell_tangent_operator : public Subscriptor
+{
+public:
+    using value_type = double;
+
+    void reinit(const unsigned int n_cells, const unsigned int n_q_points, const unsigned int n_fe_indices, const types::global_dof_index n_dofs);
+
+    void set_cell(const unsigned int cell_index, const unsigned int fe_index, const unsigned int first_q_point, const unsigned int n_q_points, const std::vector<types::global_dof_index> &local_dof_indices);
+
+    void set_q_point_data(const unsigned int cell_index,
+                          const unsigned int q_point,
+                          const std::vector<double> &shape_vec,
+                          const std::vector<Tensor<1, dim>> &shape_der_vec,
+                          const std::vector<Tensor<2, dim>> &shape_der2_vec,
+                          const std::vector<Tensor<2,dim>> &resultants,
+                          const std::vector<Tensor<4,dim>> &D_tensors,
+                          const Tensor<2, spacedim> &a_cov_def,
+                          const Tensor<2, dim, Tensor<1,spacedim>> &da_cov_def,
+                          const double JxW);
+
+    types::global_dof_index m() const {return n_dofs;}
+    types::global_dof_index n() const {return n_dofs;}
+
+    void vmult(Vector<double> &dst, const Vector<double> &src) const;
+
+    void Tvmult(Vector<double> &dst, const Vector<double> &src) const;
+
+    void compute_diagonal(Vector<double> &diagonal) const;
+
+    std::size_t memory_consumption() const;
+
+private:
+    struct QPointData
+    {
+        Tensor<2,dim> resultants[2];
+        Tensor<4,dim> D_tensors[3];
+        Tensor<2, spacedim> a_cov_def;
+        Tensor<2, dim, Tensor<1,spacedim>> da_cov_def;
+        double JxW;
+    };
+
+    struct ShapeTable
+    {
+        // indexed by [q_point][i_shape]
+        Table<2, double> values;
+        Table<2, Tensor<1, dim>> ders;
+        Table<2, Tensor<2, dim>> ders2;
+    };
+
+    types::global_dof_index n_dofs;
+    std::vector<unsigned int> cell_fe_index;
+    std::vector<unsigned int> cell_first_q_point;
+    std::vector<std::vector<types::global_dof_index>> cell_dof_indices;
+    std::vector<QPointData> q_point_data;
+    std::vector<ShapeTable> shape_tables;
+    std::vector<bool> shape_table_filled;
+};
+
+
+
+template<int dim, int spacedim>
+void Shell_tangent_operator<dim,spacedim>::reinit(const unsigned int n_cells, const unsigned int n_q_points, const unsigned int n_fe_indices, const types::global_dof_index n_dofs)
+{
+    this->n_dofs = n_dofs;
+    cell_fe_index.resize(n_cells);
+    cell_first_q_point.resize(n_cells);
+    cell_dof_indices.resize(n_cells);
+    q_point_data.resize(n_q_points);
+    shape_tables.resize(n_fe_indices);
+    shape_table_filled.assign(n_fe_indices, false);
+}
+
+
+
+template<int dim, int spacedim>
+void Shell_tangent_operator<dim,spacedim>::set_cell(const unsigned int cell_index, const unsigned int fe_index, const unsigned int first_q_point, const unsigned int n_q_points, const std::vector<types::global_dof_index> &local_dof_indices)
+{
+    cell_fe_index[cell_index] = fe_index;
+    cell_first_q_point[cell_index] = first_q_point;
+    cell_dof_indices[cell_index] = local_dof_indices;
+    if (shape_table_filled[fe_index] == false) {
+        shape_tables[fe_index].values.reinit(n_q_points, local_dof_indices.size());
+        shape_tables[fe_index].ders.reinit(n_q_points, local_dof_indices.size());
+        shape_tables[fe_index].ders2.reinit(n_q_points, local_dof_indices.size());
+    }
+}
+
+
+
+template<int dim, int spacedim>
+void Shell_tangent_operator<dim,spacedim>::set_q_point_data(const unsigned int cell_index,
+                                                            const unsigned int q_point,
+                                                            const std::vector<double> &shape_vec,
+                                                            const std::vector<Tensor<1, dim>> &shape_der_vec,
+                                                            const std::vector<Tensor<2, dim>> &shape_der2_vec,
+                                                            const std::vector<Tensor<2,dim>> &resultants,
+                                                            const std::vector<Tensor<4,dim>> &D_tensors,
+                                                            const Tensor<2, spacedim> &a_cov_def,
+                                                            const Tensor<2, dim, Tensor<1,spacedim>> &da_cov_def,
+                                                            const double JxW)
+{
+    const unsigned int fe_index = cell_fe_index[cell_index];
+    ShapeTable &table = shape_tables[fe_index];
+    if (shape_table_filled[fe_index] == false) {
+        for (unsigned int i_shape = 0; i_shape < shape_vec.size(); ++i_shape) {
+            table.values[q_point][i_shape] = shape_vec[i_shape];
+            table.ders[q_point][i_shape] = shape_der_vec[i_shape];
+            table.ders2[q_point][i_shape] = shape_der2_vec[i_shape];
+        }
+        // the table of this fe index is complete once its last quadrature point is in
+        if (q_point + 1 == table.values.size(0)) {
+            shape_table_filled[fe_index] = true;
+        }
+    }
+
+    QPointData &data = q_point_data[cell_first_q_point[cell_index] + q_point];
+    data.resultants[0] = resultants[0];
+    data.resultants[1] = resultants[1];
+    for (unsigned int i = 0; i < 3; ++i) {
+        data.D_tensors[i] = D_tensors[i];
+    }
+    data.a_cov_def = a_cov_def;
+    data.da_cov_def = da_cov_def;
+    data.JxW = JxW;
+}
+
+
+
+template<int dim, int spacedim>
+void Shell_tangent_operator<dim,spacedim>::vmult(Vector<double> &dst, const Vector<double> &src) const
+{
+    dst = 0;
+    Vector<double> cell_src, cell_dst;
+    for (unsigned int cell_index = 0; cell_index < cell_dof_indices.size(); ++cell_index)
+    {
+        const std::vector<types::global_dof_index> &local_dof_indices = cell_dof_indices[cell_index];
+        const ShapeTable &table = shape_tables[cell_fe_index[cell_index]];
+        const unsigned int dofs_per_cell = local_dof_indices.size();
+        const unsigned int n_q_points = table.values.size(0);
+
+        cell_src.reinit(dofs_per_cell);
+        cell_dst.reinit(dofs_per_cell);
+        src.extract_subvector_to(local_dof_indices.begin(), local_dof_indices.end(), cell_src.begin());
+
+        for (unsigned int q_point = 0; q_point < n_q_points; ++q_point)
+        {
+            const QPointData &data = q_point_data[cell_first_q_point[cell_index] + q_point];
+
+            // direction of the linearisation, delta a_{,a} = sum N^s_{,a} x_s and delta a_{,ab} = sum N^s_{,ab} x_s
+            Tensor<1, dim, Tensor<1,spacedim>> delta_a_cov;
+            Tensor<2, dim, Tensor<1,spacedim>> delta_da_cov;
+            for (unsigned int s_shape = 0; s_shape < dofs_per_cell; ++s_shape) {
+                for (unsigned int ia = 0; ia < dim; ++ia){
+                    delta_a_cov[ia][s_shape%3] += table.ders[q_point][s_shape][ia] * cell_src[s_shape];
+                    for (unsigned int ib = 0; ib < dim; ++ib){
+                        delta_da_cov[ia][ib][s_shape%3] += table.ders2[q_point][s_shape][ia][ib] * cell_src[s_shape];
+                    }
+                }
+            }
+
+            // Everything that does not depend on the test function r is computed
+            // once per quadrature point: the normal, the s-side variations (the
+            // same expressions as in tangent_derivatives) and their contraction
+            // with the D tensors, n_ds = D0:membrane_strain_ds + D1:bending_strain_ds
+            // and m_ds = D1:membrane_strain_ds + D2:bending_strain_ds.
+            const Tensor<2, spacedim> &a_cov = data.a_cov_def;
+            const Tensor<2, dim, Tensor<1,spacedim>> &da_cov = data.da_cov_def;
+            const Tensor<1, spacedim> a3_t = cross_product_3d(a_cov[0], a_cov[1]);
+            const double a3_bar = a3_t.norm();
+            const Tensor<1, spacedim> a3_t_ds = cross_product_3d(delta_a_cov[0], a_cov[1]) + cross_product_3d(a_cov[0], delta_a_cov[1]);
+            const double a3_bar_ds = scalar_product(a3_t, a3_t_ds)/a3_bar;
+            const Tensor<1, spacedim> a3_ds = a3_t_ds / a3_bar - a3_bar_ds * a3_t/ (a3_bar * a3_bar);
+
+            Tensor<2, dim> membrane_strain_ds, bending_strain_ds;
+            for (unsigned int ia = 0; ia < dim; ++ia) {
+                for (unsigned int ib = 0; ib < dim; ++ib) {
+                    membrane_strain_ds[ia][ib] = 0.5 * ( scalar_product( delta_a_cov[ia], a_cov[ib]) +  scalar_product( delta_a_cov[ib], a_cov[ia]) );
+                    bending_strain_ds[ia][ib] = - ( scalar_product(delta_da_cov[ia][ib], a_cov[2]) + scalar_product(da_cov[ia][ib], a3_ds) );
+                }
+            }
+            Tensor<2, dim> n_ds, m_ds;
+            for (unsigned int ia = 0; ia < dim; ++ia) {
+                for (unsigned int ib = 0; ib < dim; ++ib) {
+                    for (unsigned int ic = 0; ic < dim; ++ic) {
+                        for (unsigned int id = 0; id < dim; ++id) {
+                            n_ds[ia][ib] += data.D_tensors[0][ia][ib][ic][id] * membrane_strain_ds[ic][id] + data.D_tensors[1][ia][ib][ic][id] * bending_strain_ds[ic][id];
+                            m_ds[ia][ib] += data.D_tensors[1][ia][ib][ic][id] * membrane_strain_ds[ic][id] + data.D_tensors[2][ia][ib][ic][id] * bending_strain_ds[ic][id];
+                        }
+                    }
+                }
+            }
+
+            // The r-side variation of a_{,a} is N^r_{,a} e_c with c = r%3, so the
+            // cross products with e_c are only needed for the three components.
+            Tensor<1, spacedim> e_x_a2[spacedim], a1_x_e[spacedim], e_x_delta_a2[spacedim], delta_a1_x_e[spacedim];
+            for (unsigned int ic = 0; ic < spacedim; ++ic) {
+                Tensor<1, spacedim> e;
+                e[ic] = 1.;
+                e_x_a2[ic] = cross_product_3d(e, a_cov[1]);
+                a1_x_e[ic] = cross_product_3d(a_cov[0], e);
+                e_x_delta_a2[ic] = cross_product_3d(e, delta_a_cov[1]);
+                delta_a1_x_e[ic] = cross_product_3d(delta_a_cov[0], e);
+            }
+
+            for (unsigned int r_shape = 0; r_shape < dofs_per_cell; ++r_shape) {
+                const unsigned int c = r_shape%3;
+                const Tensor<1, dim> &shape_r_der = table.ders[q_point][r_shape];
+                const Tensor<2, dim> &shape_r_der2 = table.ders2[q_point][r_shape];
+
+                const Tensor<1, spacedim> a3_t_dr = shape_r_der[0] * e_x_a2[c] + shape_r_der[1] * a1_x_e[c];
+                const double a3_bar_dr = scalar_product(a3_t, a3_t_dr)/a3_bar;
+                const Tensor<1, spacedim> a3_t_drs = shape_r_der[0] * e_x_delta_a2[c] + shape_r_der[1] * delta_a1_x_e[c];
+                const double a3_bar_drs = scalar_product(a3_t_ds, a3_t_dr)/ a3_bar + scalar_product(a3_t, a3_t_drs)/ a3_bar - (a3_bar_ds * a3_bar_dr)/ a3_bar;
+                const Tensor<1, spacedim> a3_dr = a3_t_dr / a3_bar - a3_bar_dr * a3_t/ (a3_bar * a3_bar);
+                const Tensor<1, spacedim> a3_drs = a3_t_drs / a3_bar - a3_bar_drs * a3_t /(a3_bar * a3_bar) - a3_bar_dr * a3_t_ds / (a3_bar * a3_bar) - a3_bar_ds * a3_t_dr / (a3_bar * a3_bar) + 2 * a3_bar_dr * a3_bar_ds * a3_t / (a3_bar * a3_bar * a3_bar);
+
+                double value = 0;
+                for (unsigned int ia = 0; ia < dim; ++ia) {
+                    for (unsigned int ib = 0; ib < dim; ++ib) {
+                        const double membrane_strain_dr = 0.5 * (shape_r_der[ia] * a_cov[ib][c] + shape_r_der[ib] * a_cov[ia][c]);
+                        const double membrane_strain_drs = 0.5 * (shape_r_der[ia] * delta_a_cov[ib][c] + shape_r_der[ib] * delta_a_cov[ia][c]);
+                        const double bending_strain_dr = - (shape_r_der2[ia][ib] * a_cov[2][c] + scalar_product(da_cov[ia][ib], a3_dr));
+                        const double bending_strain_drs = - (shape_r_der2[ia][ib] * a3_ds[c] + scalar_product(delta_da_cov[ia][ib], a3_dr) + scalar_product(da_cov[ia][ib], a3_drs));
+                        value += membrane_strain_drs * data.resultants[0][ia][ib] + bending_strain_drs * data.resultants[1][ia][ib]
+                        + membrane_strain_dr * n_ds[ia][ib] + bending_strain_dr * m_ds[ia][ib];
+                    }
+                }
+                cell_dst[r_shape] += value * data.JxW;
+            }
+        }
+        dst.add(local_dof_indices, cell_dst);
+    }
+}
+
+
+
+// the shell tangent is symmetric
+template<int dim, int spacedim>
+void Shell_tangent_operator<dim,spacedim>::Tvmult(Vector<double> &dst, const Vector<double> &src) const
+{
+    vmult(dst, src);
+}
+
+
+
+template<int dim, int spacedim>
+void Shell_tangent_operator<dim,spacedim>::compute_diagonal(Vector<double> &diagonal) const
+{
+    diagonal.reinit(n_dofs);
+    for (unsigned int cell_index = 0; cell_index < cell_dof_indices.size(); ++cell_index)
+    {
+        const std::vector<types::global_dof_index> &local_dof_indices = cell_dof_indices[cell_index];
+        const ShapeTable &table = shape_tables[cell_fe_index[cell_index]];
+        for (unsigned int q_point = 0; q_point < table.values.size(0); ++q_point)
+        {
+            const QPointData &data = q_point_data[cell_first_q_point[cell_index] + q_point];
+            for (unsigned int r_shape = 0; r_shape < local_dof_indices.size(); ++r_shape) {
+                tangent_derivatives<dim,spacedim> T_derivs(table.values[q_point][r_shape], table.ders[q_point][r_shape], table.ders2[q_point][r_shape], table.values[q_point][r_shape], table.ders[q_point][r_shape], table.ders2[q_point][r_shape], data.a_cov_def, data.da_cov_def, r_shape, r_shape);
+                Tensor<2, dim> membrane_strain_dr = T_derivs.get_membrane_strain_dr();
+                Tensor<2, dim> bending_strain_dr = T_derivs.get_bending_strain_dr();
+                Tensor<2, dim> membrane_strain_drs = T_derivs.get_membrane_strain_drs();
+                Tensor<2, dim> bending_strain_drs = T_derivs.get_bending_strain_drs();
+                double value = 0;
+                for (unsigned int ia = 0; ia < dim; ++ia) {
+                    for (unsigned int ib = 0; ib < dim; ++ib) {
+                        value += membrane_strain_drs[ia][ib] * data.resultants[0][ia][ib] + bending_strain_drs[ia][ib] * data.resultants[1][ia][ib];
+                        for (unsigned int ic = 0; ic < dim; ++ic) {
+                            for (unsigned int id = 0; id < dim; ++id) {
+                                value += membrane_strain_dr[ia][ib] * data.D_tensors[0][ia][ib][ic][id] * membrane_strain_dr[ic][id]
+                                + bending_strain_dr[ia][ib] * data.D_tensors[1][ia][ib][ic][id] * membrane_strain_dr[ic][id]
+                                + membrane_strain_dr[ia][ib] * data.D_tensors[1][ia][ib][ic][id] * bending_strain_dr[ic][id]
+                                + bending_strain_dr[ia][ib] * data.D_tensors[2][ia][ib][ic][id] * bending_strain_dr[ic][id];
+                            }
+                        }
+                    }
+                }
+                diagonal[local_dof_indices[r_shape]] += value * data.JxW;
+            }
+        }
+    }
+}
+
+
+
+template<int dim, int spacedim>
+std::size_t Shell_tangent_operator<dim,spacedim>::memory_consumption() const
+{
+    std::size_t memory = MemoryConsumption::memory_consumption(cell_fe_index) +
+    MemoryConsumption::memory_consumption(cell_first_q_point) +
+    MemoryConsumption::memory_consumption(cell_dof_indices) +
+    q_point_data.capacity() * sizeof(QPointData);
+    for (const auto &table : shape_tables) {
+        memory += table.values.memory_consumption() + table.ders.memory_consumption() + table.ders2.memory_consumption();
+    }
+    return memory;
+}
+
+
+
 template <int dim, int spacedim>
 class Nonlinear_shell
 {
 public:
-    Nonlinear_shell(Triangulation<dim,spacedim> &tria);
+    Nonlinear_shell(Triangulation<dim,spacedim> &tria, const bool matrix_free = false, const bool compare_matrix_free = false);
     ~Nonlinear_shell();
     void run();
 private:
     void   setup_system();
-    void   assemble_system(const bool initial_step = false);
+    void   assemble_system(const bool initial_step = false, const bool residual_only = false);
     void   assemble_boundary_mass_matrix_and_rhs();
     void   solve();
+    void   compare_tangent_operators();
     void   initialise_data(hp::FEValues<dim,spacedim> hp_fe_values);
     double get_error_residual();
+    double line_search(const double residual_norm);
     void   nonlinear_solver(const bool initial_step = false);
     void   make_constrains(const unsigned int newton_iteration);
 
@@ -891,13 +1210,16 @@ private:
     hp::DoFHandler<dim,spacedim> dof_handler;
     hp::FECollection<dim,spacedim> fe_collection;
     hp::MappingCollection<dim,spacedim> mapping_collection;
+    CatmullClark<dim,spacedim> catmull_clark{3};
     hp::QCollection<dim> q_collection;
     hp::QCollection<dim> boundary_q_collection;
     SparsityPattern      sparsity_pattern;
+    SparsityPattern      boundary_sparsity_pattern;
     AffineConstraints<double> constraints;
     std::vector<PointHistory<dim,spacedim>>  quadrature_point_history;
     std::string material_type = "neo_hookean";
     SparseMatrix<double> tangent_matrix;
+    Shell_tangent_operator<dim,spacedim> tangent_operator;
     SparseMatrix<double> boundary_mass_matrix;
     Vector<double> newton_update;
     Vector<double> present_solution;
@@ -918,15 +1240,26 @@ private:
     const double mu = 8e5, c_1 = 0.4375*mu, c_2 = 0.0625*mu;
     const QGauss<dim-1> Qthickness = QGauss<dim-1>(2);
     const double penalty_factor = 10e30;
+    const bool   use_line_search = true;
+    const double armijo_factor = 1e-4;
+    const std::vector<double> trial_step_lengths = {1., 0.5, 0.25, 0.125};
+    // apply the tangent matrix-free, tangent_matrix and sparsity_pattern are then never allocated
+    const bool   matrix_free;
+    // time and check the matrix-free tangent against the assembled one in every solve
+    const bool   compare_matrix_free;
 };
 
 
 
 template <int dim, int spacedim>
-Nonlinear_shell<dim, spacedim>::Nonlinear_shell(Triangulation<dim,spacedim> &tria)
+Nonlinear_shell<dim, spacedim>::Nonlinear_shell(Triangulation<dim,spacedim> &tria, const bool matrix_free, const bool compare_matrix_free)
 :
-dof_handler(tria)
-{}
+dof_handler(tria),
+matrix_free(matrix_free),
+compare_matrix_free(compare_matrix_free)
+{
+    Assert(matrix_free == false || compare_matrix_free == false, ExcMessage("The assembled tangent is needed for the comparison."));
+}
 
 
 
@@ -1044,17 +1377,31 @@ double Nonlinear_shell<dim, spacedim> :: get_error_residual(){
 template <int dim, int spacedim>
 void Nonlinear_shell<dim, spacedim> :: setup_system()
 {
-    catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(dof_handler,fe_collection,vec_values,mapping_collection,q_collection,boundary_q_collection,3);
+    catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(catmull_clark,dof_handler,fe_collection,vec_values,mapping_collection,q_collection,boundary_q_collection);
     std::cout << "   Number of dofs: " << dof_handler.n_dofs()
     << std::endl;
-    DynamicSparsityPattern dynamic_sparsity_pattern(dof_handler.n_dofs());
-//    constraints.clear();
-    DoFTools::make_sparsity_pattern(dof_handler, dynamic_sparsity_pattern, constraints);
-    sparsity_pattern.copy_from(dynamic_sparsity_pattern);
-    std::ofstream out("CC_sparsity_pattern.svg");
-    sparsity_pattern.print_svg(out);
-    tangent_matrix.reinit(sparsity_pattern);
-    boundary_mass_matrix.reinit(sparsity_pattern);
+    if (matrix_free == false) {
+        catmull_clark_make_sparsity_pattern(dof_handler, sparsity_pattern);
+        tangent_matrix.reinit(sparsity_pattern);
+    }
+    // the boundary mass matrix only couples equal components of the dofs of
+    // cells with boundary quadrature points, so it gets its own small pattern
+    DynamicSparsityPattern boundary_dsp(dof_handler.n_dofs());
+    std::vector<types::global_dof_index> local_dof_indices;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+        if (boundary_q_collection[cell->active_fe_index()].size() != 1) {
+            local_dof_indices.resize(cell->get_fe().dofs_per_cell);
+            cell->get_dof_indices(local_dof_indices);
+            for (unsigned int i_shape = 0; i_shape < local_dof_indices.size(); ++i_shape) {
+                for (unsigned int j_shape = i_shape%3; j_shape < local_dof_indices.size(); j_shape += 3) {
+                    boundary_dsp.add(local_dof_indices[i_shape], local_dof_indices[j_shape]);
+                }
+            }
+        }
+    }
+    boundary_sparsity_pattern.copy_from(boundary_dsp);
+    boundary_mass_matrix.reinit(boundary_sparsity_pattern);
     solution_increment.reinit(dof_handler.n_dofs());
     internal_force_rhs.reinit(dof_handler.n_dofs());
     external_force_rhs.reinit(dof_handler.n_dofs());
@@ -1113,8 +1460,11 @@ void Nonlinear_shell<dim, spacedim> :: initialise_data(hp::FEValues<dim,spacedim
 
 
 
+// With residual_only, only the internal force of the trial state advanced by
+// solution_increment is assembled: the tangent is skipped and the quadrature
+// point history is not modified.
 template <int dim, int spacedim>
-void Nonlinear_shell<dim, spacedim> :: assemble_system(const bool initial_step)
+void Nonlinear_shell<dim, spacedim> :: assemble_system(const bool initial_step, const bool residual_only)
 {
     hp::FEValues<dim,spacedim> hp_fe_values(mapping_collection, fe_collection, q_collection,update_values|update_quadrature_points|update_jacobians|update_jacobian_grads|update_inverse_jacobians| update_gradients|update_hessians|update_jacobian_pushed_forward_grads|update_JxW_values|update_normal_vectors);
     
@@ -1126,6 +1476,10 @@ void Nonlinear_shell<dim, spacedim> :: assemble_system(const bool initial_step)
     if(initial_step == true){
         initialise_data(hp_fe_values);
     }
+    const bool cache_tangent_data = (residual_only == false && (matrix_free == true || compare_matrix_free == true));
+    if (cache_tangent_data == true) {
+        tangent_operator.reinit(dof_handler.get_triangulation().n_active_cells(), total_q_points, fe_collection.size(), dof_handler.n_dofs());
+    }
     bool load = false;
     double area = 0;
     for (const auto &cell : dof_handler.active_cell_iterators())
@@ -1138,8 +1492,10 @@ void Nonlinear_shell<dim, spacedim> :: assemble_system(const bool initial_step)
         hp_fe_values.reinit(cell);
         const FEValues<dim,spacedim> &fe_values = hp_fe_values.get_present_fe_values();
         
-        cell_tangent_matrix.reinit(dofs_per_cell, dofs_per_cell);
-        cell_tangent_matrix = 0;
+        if (residual_only == false) {
+            cell_tangent_matrix.reinit(dofs_per_cell, dofs_per_cell);
+            cell_tangent_matrix = 0;
+        }
         cell_internal_force_rhs.reinit(dofs_per_cell);
         cell_internal_force_rhs = 0;
         cell_external_force_rhs.reinit(dofs_per_cell);
@@ -1149,6 +1505,10 @@ void Nonlinear_shell<dim, spacedim> :: assemble_system(const bool initial_step)
         Assert(lqph >= &quadrature_point_history.front(), ExcInternalError());
         Assert(lqph <= &quadrature_point_history.back(), ExcInternalError());
         
+        if (cache_tangent_data == true) {
+            tangent_operator.set_cell(cell->active_cell_index(), cell->active_fe_index(), lqph - &quadrature_point_history.front(), fe_values.n_quadrature_points, local_dof_indices);
+        }
+        
         for (unsigned int q_point = 0; q_point < fe_values.n_quadrature_points;
              ++q_point)
         {
@@ -1216,16 +1576,28 @@ void Nonlinear_shell<dim, spacedim> :: assemble_system(const bool initial_step)
                 }
             }
             
-            if (initial_step == false) {lqph[q_point].update_cell_qp(u_der,u_der2);}
-            
-            std::pair<std::vector<Tensor<2,dim>>, std::vector<Tensor<4,dim>>> integral_tensors = lqph[q_point].get_integral_tensors();
+            std::pair<std::vector<Tensor<2,dim>>, std::vector<Tensor<4,dim>>> integral_tensors;
+            Tensor<2, spacedim> a_cov_def;
+            Tensor<2, dim, Tensor<1,spacedim>> da_cov_def;
+            if (residual_only == true) {
+                material_neo_hookean<dim,spacedim> trial_material = lqph[q_point].get_trial_material(u_der, u_der2);
+                integral_tensors = trial_material.get_integral_tensors();
+                a_cov_def = trial_material.get_deformed_covariant_bases();
+                da_cov_def = trial_material.get_deformed_covariant_bases_deriv();
+            }else{
+                if (initial_step == false) {lqph[q_point].update_cell_qp(u_der,u_der2);}
+                integral_tensors = lqph[q_point].get_integral_tensors();
+                a_cov_def = lqph[q_point].get_deformed_covariant_bases();
+                da_cov_def = lqph[q_point].get_deformed_covariant_bases_deriv();
+            }
             std::vector<Tensor<2,dim>> resultants = integral_tensors.first;
             Tensor<4,dim> D0 = integral_tensors.second[0];
             Tensor<4,dim> D1 = integral_tensors.second[1];
             Tensor<4,dim> D2 = integral_tensors.second[2];
             
-            Tensor<2, spacedim> a_cov_def = lqph[q_point].get_deformed_covariant_bases();
-            Tensor<2, dim, Tensor<1,spacedim>> da_cov_def = lqph[q_point].get_deformed_covariant_bases_deriv();
+            if (cache_tangent_data == true) {
+                tangent_operator.set_q_point_data(cell->active_cell_index(), q_point, shape_vec, shape_der_vec, shape_der2_vec, resultants, integral_tensors.second, a_cov_def, da_cov_def, fe_values.JxW(q_point));
+            }
 
             for (unsigned int r_shape = 0; r_shape < dofs_per_cell; ++r_shape) {
                 double shape_r = shape_vec[r_shape];
@@ -1236,34 +1608,41 @@ void Nonlinear_shell<dim, spacedim> :: assemble_system(const bool initial_step)
                 Tensor<2, dim> membrane_strain_dr;
                 Tensor<2, dim> bending_strain_dr;
                 
-                for (unsigned int s_shape = 0; s_shape < dofs_per_cell; ++s_shape) {
-                    double shape_s = shape_vec[s_shape];
-                    Tensor<1, dim> shape_s_der = shape_der_vec[s_shape];
-                    Tensor<2, dim> shape_s_der2 = shape_der2_vec[s_shape];
+                if (residual_only == false && matrix_free == false) {
+                    for (unsigned int s_shape = 0; s_shape < dofs_per_cell; ++s_shape) {
+                        double shape_s = shape_vec[s_shape];
+                        Tensor<1, dim> shape_s_der = shape_der_vec[s_shape];
+                        Tensor<2, dim> shape_s_der2 = shape_der2_vec[s_shape];
                     
-                    tangent_derivatives<dim,spacedim> T_derivs(shape_r, shape_r_der, shape_r_der2, shape_s, shape_s_der, shape_s_der2, a_cov_def, da_cov_def, r_shape, s_shape);
-                    u_r = T_derivs.get_u_r();
-                    membrane_strain_dr = T_derivs.get_membrane_strain_dr();
-                    bending_strain_dr  = T_derivs.get_bending_strain_dr();
-                    Tensor<2, dim> membrane_strain_ds  = T_derivs.get_membrane_strain_ds();
-                    Tensor<2, dim> bending_strain_ds   = T_derivs.get_bending_strain_ds();
-                    Tensor<2, dim> membrane_strain_drs = T_derivs.get_membrane_strain_drs();
-                    Tensor<2, dim> bending_strain_drs  = T_derivs.get_bending_strain_drs();
+                        tangent_derivatives<dim,spacedim> T_derivs(shape_r, shape_r_der, shape_r_der2, shape_s, shape_s_der, shape_s_der2, a_cov_def, da_cov_def, r_shape, s_shape);
+                        u_r = T_derivs.get_u_r();
+                        membrane_strain_dr = T_derivs.get_membrane_strain_dr();
+                        bending_strain_dr  = T_derivs.get_bending_strain_dr();
+                        Tensor<2, dim> membrane_strain_ds  = T_derivs.get_membrane_strain_ds();
+                        Tensor<2, dim> bending_strain_ds   = T_derivs.get_bending_strain_ds();
+                        Tensor<2, dim> membrane_strain_drs = T_derivs.get_membrane_strain_drs();
+                        Tensor<2, dim> bending_strain_drs  = T_derivs.get_bending_strain_drs();
                     
-                    for (unsigned int ia = 0; ia < dim; ++ia) {
-                        for (unsigned int ib = 0; ib < dim; ++ib) {
-                            cell_tangent_matrix[r_shape][s_shape] += (membrane_strain_drs[ia][ib] * resultants[0][ia][ib] + bending_strain_drs[ia][ib] * resultants[1][ia][ib]) * fe_values.JxW(q_point) ;
-                            for (unsigned int ic = 0; ic < dim; ++ic) {
-                                for (unsigned int id = 0; id < dim; ++id) {
-                                    cell_tangent_matrix[r_shape][s_shape] += (membrane_strain_dr[ia][ib] * D0[ia][ib][ic][id] * membrane_strain_ds[ic][id]
-                                                                              + bending_strain_dr[ia][ib] * D1[ia][ib][ic][id] * membrane_strain_ds[ic][id]
-                                                                              + membrane_strain_dr[ia][ib] * D1[ia][ib][ic][id] * bending_strain_ds[ic][id]
-                                                                              + bending_strain_dr[ia][ib] * D2[ia][ib][ic][id] * bending_strain_ds[ic][id])
-                                                                            * fe_values.JxW(q_point);
+                        for (unsigned int ia = 0; ia < dim; ++ia) {
+                            for (unsigned int ib = 0; ib < dim; ++ib) {
+                                cell_tangent_matrix[r_shape][s_shape] += (membrane_strain_drs[ia][ib] * resultants[0][ia][ib] + bending_strain_drs[ia][ib] * resultants[1][ia][ib]) * fe_values.JxW(q_point) ;
+                                for (unsigned int ic = 0; ic < dim; ++ic) {
+                                    for (unsigned int id = 0; id < dim; ++id) {
+                                        cell_tangent_matrix[r_shape][s_shape] += (membrane_strain_dr[ia][ib] * D0[ia][ib][ic][id] * membrane_strain_ds[ic][id]
+                                                                                  + bending_strain_dr[ia][ib] * D1[ia][ib][ic][id] * membrane_strain_ds[ic][id]
+                                                                                  + membrane_strain_dr[ia][ib] * D1[ia][ib][ic][id] * bending_strain_ds[ic][id]
+                                                                                  + bending_strain_dr[ia][ib] * D2[ia][ib][ic][id] * bending_strain_ds[ic][id])
+                                                                                * fe_values.JxW(q_point);
+                                    }
                                 }
                             }
                         }
                     }
+                }else{
+                    // only the first variations are needed for the internal force
+                    tangent_derivatives<dim,spacedim> T_derivs(shape_r, shape_r_der, shape_r_der2, shape_r, shape_r_der, shape_r_der2, a_cov_def, da_cov_def, r_shape, r_shape);
+                    membrane_strain_dr = T_derivs.get_membrane_strain_dr();
+                    bending_strain_dr  = T_derivs.get_bending_strain_dr();
                 }
                 for (unsigned int ia = 0; ia < dim; ++ia) {
                     for (unsigned int ib = 0; ib < dim; ++ib) {
@@ -1276,7 +1655,9 @@ void Nonlinear_shell<dim, spacedim> :: assemble_system(const bool initial_step)
         }// loop over surface quadrature points
         internal_force_rhs.add(local_dof_indices, cell_internal_force_rhs);
 //        external_force_rhs.add(local_dof_indices, cell_external_force_rhs);
-        tangent_matrix.add(local_dof_indices, local_dof_indices, cell_tangent_matrix);
+        if (residual_only == false && matrix_free == false) {
+            tangent_matrix.add(local_dof_indices, local_dof_indices, cell_tangent_matrix);
+        }
         
 //        if (load == false) {
 //            for (unsigned int ivert = 0; ivert < 4; ++ivert) {
@@ -1309,6 +1690,30 @@ void Nonlinear_shell<dim, spacedim> :: assemble_system(const bool initial_step)
 
 
 
+// Backtracking line search along newton_update. The residual of each trial
+// step length is evaluated with a residual-only assembly; the longest step
+// with sufficient decrease of the residual norm is taken, otherwise the one
+// with the smallest residual.
+template <int dim, int spacedim>
+double Nonlinear_shell<dim, spacedim> :: line_search(const double residual_norm)
+{
+    std::vector<double> trial_residuals(trial_step_lengths.size());
+    for (unsigned int it = 0; it < trial_step_lengths.size(); ++it) {
+        solution_increment = newton_update;
+        solution_increment *= trial_step_lengths[it];
+        internal_force_rhs.reinit(dof_handler.n_dofs());
+        assemble_system(false, true);
+        trial_residuals[it] = get_error_residual();
+        if (trial_residuals[it] <= (1. - armijo_factor * trial_step_lengths[it]) * residual_norm) {
+            return trial_step_lengths[it];
+        }
+    }
+    const auto min_residual = std::min_element(trial_residuals.begin(), trial_residuals.end());
+    return trial_step_lengths[std::distance(trial_residuals.begin(), min_residual)];
+}
+
+
+
 template <int dim, int spacedim>
 void Nonlinear_shell<dim, spacedim>::assemble_boundary_mass_matrix_and_rhs()
 {
@@ -1425,7 +1830,12 @@ void Nonlinear_shell<dim, spacedim>::assemble_boundary_mass_matrix_and_rhs()
 template <int dim, int spacedim>
 void Nonlinear_shell<dim, spacedim>::make_constrains(const unsigned int newton_iteration){
     assemble_boundary_mass_matrix_and_rhs();
-    tangent_matrix.add(penalty_factor, boundary_mass_matrix);
+    if (matrix_free == false) {
+        // the boundary couplings are a subset of the couplings in tangent_matrix
+        for (const auto &entry : boundary_mass_matrix) {
+            tangent_matrix.add(entry.row(), entry.column(), penalty_factor * entry.value());
+        }
+    }
     if (newton_iteration == 0) {
         force_rhs.add(penalty_factor, boundary_value_rhs);
     }
@@ -1452,11 +1862,26 @@ void Nonlinear_shell<dim, spacedim>::solve()
 //    }
 //    std::cout << "] " << std::endl;
 
+  if (compare_matrix_free == true) {
+      compare_tangent_operators();
+  }
   SolverControl            solver_control(10000, 1e-6);
   SolverCG<Vector<double>> solver(solver_control);
-  PreconditionSSOR<SparseMatrix<double>> preconditioner;
-  preconditioner.initialize(tangent_matrix);
-  solver.solve(tangent_matrix, newton_update, force_rhs, preconditioner);
+  if (matrix_free == true) {
+      // K + penalty * M_b, preconditioned with the inverse of its diagonal
+      const auto shell_tangent = linear_operator(tangent_operator) + penalty_factor * linear_operator(boundary_mass_matrix);
+      DiagonalMatrix<Vector<double>> preconditioner;
+      tangent_operator.compute_diagonal(preconditioner.get_vector());
+      for (unsigned int i = 0; i < dof_handler.n_dofs(); ++i) {
+          const double diagonal = preconditioner.get_vector()[i] + penalty_factor * boundary_mass_matrix.diag_element(i);
+          preconditioner.get_vector()[i] = (diagonal != 0. ? 1./diagonal : 1.);
+      }
+      solver.solve(shell_tangent, newton_update, force_rhs, preconditioner);
+  }else{
+      PreconditionSSOR<SparseMatrix<double>> preconditioner;
+      preconditioner.initialize(tangent_matrix);
+      solver.solve(tangent_matrix, newton_update, force_rhs, preconditioner);
+  }
     
 //  SparseDirectUMFPACK A_direct;
 //  A_direct.initialize(boundary_mass_matrix);
@@ -1466,6 +1891,43 @@ void Nonlinear_shell<dim, spacedim>::solve()
 
 
 
+// Matvec throughput, memory and agreement of the matrix-free tangent against
+// the assembled tangent_matrix (both including the boundary penalty term).
+template <int dim, int spacedim>
+void Nonlinear_shell<dim, spacedim>::compare_tangent_operators()
+{
+    Assert(matrix_free == false, ExcMessage("The assembled tangent is needed for the comparison."));
+    const unsigned int n_vmults = 20;
+    const auto shell_tangent = linear_operator(tangent_operator) + penalty_factor * linear_operator(boundary_mass_matrix);
+    
+    Vector<double> src(dof_handler.n_dofs()), dst_assembled(dof_handler.n_dofs()), dst_matrix_free(dof_handler.n_dofs());
+    for (unsigned int i = 0; i < src.size(); ++i) {
+        src[i] = std::sin(1. + i);
+    }
+    
+    Timer timer;
+    for (unsigned int i = 0; i < n_vmults; ++i) {
+        tangent_matrix.vmult(dst_assembled, src);
+    }
+    const double time_assembled = timer.wall_time() / n_vmults;
+    
+    timer.restart();
+    for (unsigned int i = 0; i < n_vmults; ++i) {
+        shell_tangent.vmult(dst_matrix_free, src);
+    }
+    const double time_matrix_free = timer.wall_time() / n_vmults;
+    
+    const double norm_assembled = dst_assembled.l2_norm();
+    dst_matrix_free -= dst_assembled;
+    std::cout << "   tangent vmult, assembled:   " << time_assembled << " s, "
+    << (tangent_matrix.memory_consumption() + sparsity_pattern.memory_consumption()) / 1024 << " kB" << std::endl
+    << "   tangent vmult, matrix-free: " << time_matrix_free << " s, "
+    << tangent_operator.memory_consumption() / 1024 << " kB" << std::endl
+    << "   relative difference = " << dst_matrix_free.l2_norm() / norm_assembled << std::endl;
+}
+
+
+
 template <int dim, int spacedim>
 void Nonlinear_shell<dim, spacedim> ::run()
 {    setup_system();
@@ -1517,7 +1979,9 @@ void Nonlinear_shell<dim, spacedim> ::nonlinear_solver(const bool initial_load_s
 
         if (residual_error < 1e-6 && newton_update.l2_norm() < 1e-6) {
             std::cout << "converged.\n";
-            tangent_matrix.reinit(sparsity_pattern);
+            if (matrix_free == false) {
+                tangent_matrix = 0;
+            }
             internal_force_rhs.reinit(dof_handler.n_dofs());
             external_force_rhs.reinit(dof_handler.n_dofs());
             newton_update.reinit(dof_handler.n_dofs());
@@ -1529,10 +1993,20 @@ void Nonlinear_shell<dim, spacedim> ::nonlinear_solver(const bool initial_load_s
         }
         std::cout << "newton_update_error = " << newton_update.l2_norm() <<std::endl;
 
+        // the first iteration carries the penalty load of the prescribed displacements, no line search there
+        double step_length = 1.;
+        if (use_line_search == true && newton_iteration != 0) {
+            step_length = line_search(residual_norm);
+            std::cout << "line search step length = " << step_length << std::endl;
+        }
+
         solution_increment = newton_update;
-        present_solution = present_solution + newton_update;
+        solution_increment *= step_length;
+        present_solution.add(step_length, newton_update);
         
-        tangent_matrix.reinit(sparsity_pattern);
+        if (matrix_free == false) {
+            tangent_matrix = 0;
+        }
         internal_force_rhs.reinit(dof_handler.n_dofs());
         external_force_rhs.reinit(dof_handler.n_dofs());
         newton_update.reinit(dof_handler.n_dofs());
@@ -1541,11 +2015,16 @@ void Nonlinear_shell<dim, spacedim> ::nonlinear_solver(const bool initial_load_s
 
 
 
-int main()
+// The optional argument selects the tangent: "assembled" (default),
+// "matrix-free", or "compare" to assemble it and check the matrix-free
+// tangent against it in every solve.
+int main(int argc, char **argv)
 {
+    const std::string tangent_type = (argc > 1 ? argv[1] : "assembled");
+    AssertThrow(tangent_type == "assembled" || tangent_type == "matrix-free" || tangent_type == "compare", ExcMessage("Unknown tangent type " + tangent_type));
     const int dim = 2, spacedim = 3;
     Triangulation<dim,spacedim> mesh = set_mesh<dim,spacedim>("plate");
-    Nonlinear_shell<dim, spacedim> nonlinear_thin_shell(mesh);
+    Nonlinear_shell<dim, spacedim> nonlinear_thin_shell(mesh, tangent_type == "matrix-free", tangent_type == "compare");
     nonlinear_thin_shell.run();
     
     std::cout <<"finished.\n";
@@ -0,0 +1,124 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 1999 - 2019 by the deal.II authors
+ *
+ * This file is part of the deal.II library.
+ *
+ * The deal.II library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE.md at
+ * the top level directory of deal.II.
+ *
+ * ---------------------------------------------------------------------
+ */
+// Checks of the regular Loop basis: partition of unity, first and second
+// derivatives against central differences, the limit position mask at a
+// vertex of the patch, and Loop's vertex weight beta(n).
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/numbers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "polynomials_Loop.hpp"
+
+using namespace dealii;
+
+int main()
+{
+    const int dim = 2;
+    const unsigned int n_functions = polynomials_Loop<dim>::regular::n_functions;
+    const polynomials_Loop<dim>::regular basis;
+
+    // points (v, w) inside the patch triangle u + v + w = 1, u = 1 - v - w
+    const std::vector<Point<dim>> points = {{0.2, 0.3}, {0.1, 0.1}, {0.6, 0.25}, {1./3., 1./3.}, {0.05, 0.9}};
+    const double h = 1e-5;
+
+    double unity_error = 0, grad_sum_error = 0, hessian_sum_error = 0;
+    double grad_error = 0, hessian_error = 0;
+    for (const auto &p : points) {
+        std::vector<double> values(n_functions);
+        std::vector<Tensor<1,dim>> grads(n_functions);
+        std::vector<Tensor<2,dim>> grad_grads(n_functions);
+        basis.compute(p, values, grads, grad_grads);
+
+        double value_sum = 0;
+        Tensor<1,dim> grad_sum;
+        Tensor<2,dim> hessian_sum;
+        for (unsigned int i = 0; i < n_functions; ++i) {
+            value_sum += values[i];
+            grad_sum += grads[i];
+            hessian_sum += grad_grads[i];
+
+            // compute() and the single function evaluations must agree
+            AssertThrow(std::abs(basis.value(i, p) - values[i]) < 1e-14 &&
+                        (basis.grads(i, p) - grads[i]).norm() < 1e-14 &&
+                        (basis.grad_grads(i, p) - grad_grads[i]).norm() < 1e-14,
+                        ExcInternalError());
+
+            for (unsigned int d = 0; d < dim; ++d) {
+                Point<dim> p_plus = p, p_minus = p;
+                p_plus[d] += h;
+                p_minus[d] -= h;
+                const double fd_grad = (basis.value(i, p_plus) - basis.value(i, p_minus)) / (2 * h);
+                const Tensor<1,dim> fd_hessian = (basis.grads(i, p_plus) - basis.grads(i, p_minus)) / (2 * h);
+                grad_error = std::max(grad_error, std::abs(fd_grad - grads[i][d]));
+                for (unsigned int e = 0; e < dim; ++e) {
+                    hessian_error = std::max(hessian_error, std::abs(fd_hessian[e] - grad_grads[i][d][e]));
+                }
+            }
+        }
+        unity_error = std::max(unity_error, std::abs(value_sum - 1.));
+        grad_sum_error = std::max(grad_sum_error, grad_sum.norm());
+        hessian_sum_error = std::max(hessian_sum_error, hessian_sum.norm());
+    }
+    std::cout << "partition of unity: max |sum N - 1| = " << unity_error
+              << ", max |sum grad N| = " << grad_sum_error
+              << ", max |sum hessian N| = " << hessian_sum_error << std::endl;
+    std::cout << "central differences: max gradient error = " << grad_error
+              << ", max hessian error = " << hessian_error << std::endl;
+    AssertThrow(unity_error < 1e-12 && grad_sum_error < 1e-12 && hessian_sum_error < 1e-12, ExcMessage("The basis is not a partition of unity."));
+    AssertThrow(grad_error < 1e-8 && hessian_error < 1e-8, ExcMessage("The derivatives do not match the central differences."));
+
+    // At a corner of the patch the surface interpolates the limit position
+    // of the vertex: 1/2 for the vertex and 1/12 for each of its six
+    // neighbours, all other functions vanish.
+    {
+        std::vector<double> values(n_functions);
+        for (unsigned int i = 0; i < n_functions; ++i) {
+            values[i] = basis.value(i, Point<dim>(0, 0));
+        }
+        std::sort(values.begin(), values.end());
+        std::vector<double> expected(n_functions, 0.);
+        std::fill(expected.end() - 7, expected.end() - 1, 1./12.);
+        expected.back() = 0.5;
+        double mask_error = 0;
+        for (unsigned int i = 0; i < n_functions; ++i) {
+            mask_error = std::max(mask_error, std::abs(values[i] - expected[i]));
+        }
+        std::cout << "limit mask at the corner (0,0): max error = " << mask_error << std::endl;
+        AssertThrow(mask_error < 1e-14, ExcMessage("Wrong limit position mask."));
+    }
+
+    // beta(3) = 3/16 and beta(6) = 1/16 are Loop's original weights, and the
+    // weights of a vertex must keep the new position an affine combination
+    // with a positive weight of the vertex itself.
+    {
+        AssertThrow(std::abs(polynomials_Loop<dim>::vertex_weight(3) - 3./16.) < 1e-15, ExcMessage("Wrong beta(3)."));
+        AssertThrow(std::abs(polynomials_Loop<dim>::vertex_weight(6) - 1./16.) < 1e-15, ExcMessage("Wrong beta(6)."));
+        for (const unsigned int valence : {3, 4, 5, 6, 7, 8, 12}) {
+            const double beta = polynomials_Loop<dim>::vertex_weight(valence);
+            std::cout << "beta(" << valence << ") = " << beta
+                      << ", vertex weight 1 - n beta = " << 1. - valence * beta << std::endl;
+            AssertThrow(beta > 0 && 1. - valence * beta > 0, ExcMessage("Vertex weights out of range."));
+        }
+    }
+
+    std::cout << "OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,150 @@
+/* ---------------------------------------------------------------------
+ *
+ * Copyright (C) 1999 - 2019 by the deal.II authors
+ *
+ * This file is part of the deal.II library.
+ *
+ * The deal.II library is free software; you can use it, redistribute
+ * it, and/or modify it under the terms of the GNU Lesser General
+ * Public License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * The full text of the license can be found in the file LICENSE.md at
+ * the top level directory of deal.II.
+ *
+ * ---------------------------------------------------------------------
+ */
+// A CatmullClark object kept across remeshing: after every global refinement
+// the elements, quadratures and mappings of the previous meshes must still be
+// the same objects at the same indices, new valence/orientation pairs must be
+// appended, and the dofs and control point coordinates must be the same as
+// those of a CatmullClark object built from scratch on the refined mesh. The
+// hp::DoFHandler may number the dofs differently when the elements have other
+// fe indices, so the dofs are compared through the map from the dof indices of
+// the kept object to those of the fresh one, which must be a permutation.
+#include <deal.II/base/point.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/mapping_collection.h>
+#include <deal.II/hp/q_collection.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <iostream>
+#include <vector>
+
+#include "Catmull_Clark_Data.hpp"
+
+using namespace dealii;
+
+int main()
+{
+    Triangulation<2,3> mesh;
+    GridGenerator::subdivided_hyper_cube(mesh, 2);
+    
+    hp::DoFHandler<2,3> dof_handler(mesh);
+    Vector<double> vec_values;
+    hp::FECollection<2,3> fe_collection;
+    hp::MappingCollection<2,3> mapping_collection;
+    hp::QCollection<2> q_collection;
+    hp::QCollection<2> boundary_q_collection;
+    CatmullClark<2,3> catmull_clark(3);
+    
+    // the objects set up for the previous meshes
+    std::vector<const FiniteElement<2,3> *> previous_fes;
+    std::vector<const Mapping<2,3> *> previous_mappings;
+    std::vector<const Quadrature<2> *> previous_quadratures;
+    
+    const std::vector<Point<2>> points = {{0.2, 0.3}, {0.7, 0.6}};
+    
+    for (unsigned int cycle = 0; cycle < 3; ++cycle) {
+        if (cycle > 0) {
+            mesh.refine_global(1);
+        }
+        catmull_clark_create_fe_quadrature_and_mapping_collections_and_distribute_dofs(catmull_clark,dof_handler,fe_collection,vec_values,mapping_collection,q_collection,boundary_q_collection);
+        
+        AssertThrow(fe_collection.size() == mapping_collection.size() &&
+                    fe_collection.size() == q_collection.size() &&
+                    fe_collection.size() == boundary_q_collection.size(),
+                    ExcInternalError());
+        
+        bool kept = (fe_collection.size() >= previous_fes.size());
+        for (unsigned int i = 0; kept && i < previous_fes.size(); ++i) {
+            kept = (&fe_collection[i] == previous_fes[i] &&
+                    &mapping_collection[i] == previous_mappings[i] &&
+                    &q_collection[i] == previous_quadratures[i]);
+        }
+        
+        // a fresh build on the same mesh
+        hp::DoFHandler<2,3> fresh_dof_handler(mesh);
+        Vector<double> fresh_vec_values;
+        CatmullClark<2,3> fresh_catmull_clark(fresh_dof_handler, fresh_vec_values, 3);
+        
+        bool same_dofs = (dof_handler.n_dofs() == fresh_dof_handler.n_dofs());
+        std::vector<types::global_dof_index> dof_map(dof_handler.n_dofs(), numbers::invalid_dof_index);
+        std::vector<bool> fresh_dof_used(fresh_dof_handler.n_dofs(), false);
+        auto fresh_cell = fresh_dof_handler.begin_active();
+        for (const auto &cell : dof_handler.active_cell_iterators()) {
+            if (!same_dofs) {
+                break;
+            }
+            const FiniteElement<2,3> &fe = cell->get_fe();
+            const FiniteElement<2,3> &fresh_fe = fresh_cell->get_fe();
+            if (fe.dofs_per_cell != fresh_fe.dofs_per_cell) {
+                same_dofs = false;
+                break;
+            }
+            std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell), fresh_dof_indices(fe.dofs_per_cell);
+            cell->get_dof_indices(dof_indices);
+            fresh_cell->get_dof_indices(fresh_dof_indices);
+            for (unsigned int i = 0; i < fe.dofs_per_cell; ++i) {
+                if (dof_map[dof_indices[i]] == numbers::invalid_dof_index && !fresh_dof_used[fresh_dof_indices[i]]) {
+                    dof_map[dof_indices[i]] = fresh_dof_indices[i];
+                    fresh_dof_used[fresh_dof_indices[i]] = true;
+                } else if (dof_map[dof_indices[i]] != fresh_dof_indices[i]) {
+                    same_dofs = false;
+                }
+            }
+            // the fe indices differ since the elements have been registered in another order, but the
+            // elements on the cell must be the same
+            for (unsigned int i = 0; i < fe.dofs_per_cell; ++i) {
+                for (const auto &p : points) {
+                    if (fe.system_to_component_index(i) != fresh_fe.system_to_component_index(i) ||
+                        fe.shape_value(i, p) != fresh_fe.shape_value(i, p)) {
+                        same_dofs = false;
+                    }
+                }
+            }
+            if (q_collection[cell->active_fe_index()].size() != fresh_catmull_clark.get_QCollection()[fresh_cell->active_fe_index()].size()) {
+                same_dofs = false;
+            }
+            ++fresh_cell;
+        }
+        for (unsigned int i = 0; same_dofs && i < dof_handler.n_dofs(); ++i) {
+            same_dofs = (dof_map[i] != numbers::invalid_dof_index &&
+                         vec_values[i] == fresh_vec_values[dof_map[i]]);
+        }
+        
+        std::cout << "cycle " << cycle << ": " << mesh.n_active_cells() << " cells, "
+                  << dof_handler.n_dofs() << " dofs, " << fe_collection.size() << " elements ("
+                  << fresh_catmull_clark.get_FECollection().size() << " in a fresh build), previous elements "
+                  << (kept ? "kept" : "NOT kept") << ", dofs "
+                  << (same_dofs ? "match" : "do NOT match") << " a fresh build" << std::endl;
+        AssertThrow(kept, ExcMessage("The elements of the previous mesh have not been kept."));
+        AssertThrow(same_dofs, ExcMessage("The dofs differ from those of a fresh build."));
+        
+        previous_fes.clear();
+        previous_mappings.clear();
+        previous_quadratures.clear();
+        for (unsigned int i = 0; i < fe_collection.size(); ++i) {
+            previous_fes.push_back(&fe_collection[i]);
+            previous_mappings.push_back(&mapping_collection[i]);
+            previous_quadratures.push_back(&q_collection[i]);
+        }
+    }
+    
+    std::cout << "OK" << std::endl;
+    return 0;
+}
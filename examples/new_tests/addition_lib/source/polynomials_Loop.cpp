@@ -0,0 +1,264 @@
+//
+//  polynomials_Loop.cpp
+//  step-4
+//
+
+#include "polynomials_Loop.hpp"
+
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+template<int dim>
+double polynomials_Loop<dim>::vertex_weight(const unsigned int valence)
+{
+    Assert(valence >= 3, ExcMessage("Loop subdivision needs a valence of at least 3."));
+    const double n = valence;
+    const double c = 3./8. + 1./4. * std::cos(2. * numbers::PI / n);
+    return (5./8. - c * c) / n;
+}
+
+
+
+template<int dim>
+const std::vector<typename polynomials_Loop<dim>::regular::Monomial> &
+polynomials_Loop<dim>::regular::terms(const unsigned int i)
+{
+    AssertIndexRange(i, n_functions);
+    static const std::vector<Monomial> table[n_functions] = {
+        // N_1
+        {
+            {1, {{4, 0, 0}}},
+            {2, {{3, 1, 0}}}
+        },
+        // N_2
+        {
+            {1, {{4, 0, 0}}},
+            {2, {{3, 0, 1}}}
+        },
+        // N_3
+        {
+            {1, {{4, 0, 0}}},
+            {2, {{3, 0, 1}}},
+            {6, {{3, 1, 0}}},
+            {6, {{2, 1, 1}}},
+            {12, {{2, 2, 0}}},
+            {6, {{1, 2, 1}}},
+            {6, {{1, 3, 0}}},
+            {2, {{0, 3, 1}}},
+            {1, {{0, 4, 0}}}
+        },
+        // N_4
+        {
+            {6, {{4, 0, 0}}},
+            {24, {{3, 0, 1}}},
+            {24, {{2, 0, 2}}},
+            {8, {{1, 0, 3}}},
+            {1, {{0, 0, 4}}},
+            {24, {{3, 1, 0}}},
+            {60, {{2, 1, 1}}},
+            {36, {{1, 1, 2}}},
+            {6, {{0, 1, 3}}},
+            {24, {{2, 2, 0}}},
+            {36, {{1, 2, 1}}},
+            {12, {{0, 2, 2}}},
+            {8, {{1, 3, 0}}},
+            {6, {{0, 3, 1}}},
+            {1, {{0, 4, 0}}}
+        },
+        // N_5
+        {
+            {1, {{4, 0, 0}}},
+            {6, {{3, 0, 1}}},
+            {12, {{2, 0, 2}}},
+            {6, {{1, 0, 3}}},
+            {1, {{0, 0, 4}}},
+            {2, {{3, 1, 0}}},
+            {6, {{2, 1, 1}}},
+            {6, {{1, 1, 2}}},
+            {2, {{0, 1, 3}}}
+        },
+        // N_6
+        {
+            {2, {{1, 3, 0}}},
+            {1, {{0, 4, 0}}}
+        },
+        // N_7
+        {
+            {1, {{4, 0, 0}}},
+            {6, {{3, 0, 1}}},
+            {12, {{2, 0, 2}}},
+            {6, {{1, 0, 3}}},
+            {1, {{0, 0, 4}}},
+            {8, {{3, 1, 0}}},
+            {36, {{2, 1, 1}}},
+            {36, {{1, 1, 2}}},
+            {8, {{0, 1, 3}}},
+            {24, {{2, 2, 0}}},
+            {60, {{1, 2, 1}}},
+            {24, {{0, 2, 2}}},
+            {24, {{1, 3, 0}}},
+            {24, {{0, 3, 1}}},
+            {6, {{0, 4, 0}}}
+        },
+        // N_8
+        {
+            {1, {{4, 0, 0}}},
+            {8, {{3, 0, 1}}},
+            {24, {{2, 0, 2}}},
+            {24, {{1, 0, 3}}},
+            {6, {{0, 0, 4}}},
+            {6, {{3, 1, 0}}},
+            {36, {{2, 1, 1}}},
+            {60, {{1, 1, 2}}},
+            {24, {{0, 1, 3}}},
+            {12, {{2, 2, 0}}},
+            {36, {{1, 2, 1}}},
+            {24, {{0, 2, 2}}},
+            {6, {{1, 3, 0}}},
+            {8, {{0, 3, 1}}},
+            {1, {{0, 4, 0}}}
+        },
+        // N_9
+        {
+            {2, {{1, 0, 3}}},
+            {1, {{0, 0, 4}}}
+        },
+        // N_10
+        {
+            {2, {{0, 3, 1}}},
+            {1, {{0, 4, 0}}}
+        },
+        // N_11
+        {
+            {2, {{1, 0, 3}}},
+            {1, {{0, 0, 4}}},
+            {6, {{1, 1, 2}}},
+            {6, {{0, 1, 3}}},
+            {6, {{1, 2, 1}}},
+            {12, {{0, 2, 2}}},
+            {2, {{1, 3, 0}}},
+            {6, {{0, 3, 1}}},
+            {1, {{0, 4, 0}}}
+        },
+        // N_12
+        {
+            {1, {{0, 0, 4}}},
+            {2, {{0, 1, 3}}}
+        }
+    };
+    return table[i];
+}
+
+
+
+template<int dim>
+void polynomials_Loop<dim>::regular::
+evaluate(const unsigned int i,
+         const Point<dim> &unit_point,
+         double &value,
+         Tensor<1,dim> &grad,
+         Tensor<2,dim> &grad_grad) const
+{
+    AssertDimension(dim, 2);
+    const double b[3] = {1. - unit_point[0] - unit_point[1], unit_point[0], unit_point[1]};
+    
+    // powers b[k]^e for e = 0..4
+    double pw[3][5];
+    for (unsigned int k = 0; k < 3; ++k){
+        pw[k][0] = 1.;
+        for (unsigned int e = 1; e < 5; ++e)
+            pw[k][e] = pw[k][e-1] * b[k];
+    }
+    
+    // value, gradient and hessian with respect to (u, v, w)
+    double f = 0.;
+    double df[3] = {0., 0., 0.};
+    double ddf[3][3] = {{0., 0., 0.}, {0., 0., 0.}, {0., 0., 0.}};
+    for (const auto &t : terms(i)){
+        const auto &e = t.exponents;
+        f += t.coefficient * pw[0][e[0]] * pw[1][e[1]] * pw[2][e[2]];
+        for (unsigned int k = 0; k < 3; ++k){
+            if (e[k] == 0)
+                continue;
+            double d = t.coefficient * e[k];
+            for (unsigned int m = 0; m < 3; ++m)
+                d *= pw[m][m == k ? e[m] - 1 : e[m]];
+            df[k] += d;
+            for (unsigned int l = 0; l < 3; ++l){
+                const unsigned int el = (l == k ? e[l] - 1 : e[l]);
+                if (el == 0)
+                    continue;
+                double dd = t.coefficient * e[k] * el;
+                for (unsigned int m = 0; m < 3; ++m){
+                    unsigned int em = e[m];
+                    if (m == k) --em;
+                    if (m == l) --em;
+                    dd *= pw[m][em];
+                }
+                ddf[k][l] += dd;
+            }
+        }
+    }
+    
+    // d/dv = d_v - d_u, d/dw = d_w - d_u
+    value = f / 12.;
+    grad[0] = (df[1] - df[0]) / 12.;
+    grad[1] = (df[2] - df[0]) / 12.;
+    grad_grad[0][0] = (ddf[1][1] - 2. * ddf[0][1] + ddf[0][0]) / 12.;
+    grad_grad[1][1] = (ddf[2][2] - 2. * ddf[0][2] + ddf[0][0]) / 12.;
+    grad_grad[0][1] = (ddf[1][2] - ddf[0][1] - ddf[0][2] + ddf[0][0]) / 12.;
+    grad_grad[1][0] = grad_grad[0][1];
+}
+
+
+
+template<int dim>
+void polynomials_Loop<dim>::regular::
+compute(const Point<dim> &unit_point,
+        std::vector<double>&values,
+        std::vector<Tensor<1,dim>> &grads,
+        std::vector<Tensor<2,dim>> &grad_grads)const
+{
+    AssertDimension(values.size(), n_functions);
+    AssertDimension(grads.size(), n_functions);
+    AssertDimension(grad_grads.size(), n_functions);
+    for (unsigned int i = 0; i < n_functions; ++i)
+        evaluate(i, unit_point, values[i], grads[i], grad_grads[i]);
+};
+
+
+
+template<int dim>
+double polynomials_Loop<dim>::regular::value(const unsigned int i, const Point<dim> &unit_point) const
+{
+    double value;
+    Tensor<1,dim> grad;
+    Tensor<2,dim> grad_grad;
+    evaluate(i, unit_point, value, grad, grad_grad);
+    return value;
+}
+
+template<int dim>
+Tensor<1,dim> polynomials_Loop<dim>::regular::grads( const unsigned int i, const Point<dim> &unit_point) const
+{
+    double value;
+    Tensor<1,dim> grad;
+    Tensor<2,dim> grad_grad;
+    evaluate(i, unit_point, value, grad, grad_grad);
+    return grad;
+}
+
+template<int dim>
+Tensor<2,dim> polynomials_Loop<dim>::regular::grad_grads( const unsigned int i, const Point<dim> &unit_point) const
+{
+    double value;
+    Tensor<1,dim> grad;
+    Tensor<2,dim> grad_grad;
+    evaluate(i, unit_point, value, grad, grad_grad);
+    return grad_grad;
+}
+
+template class polynomials_Loop<2>;
+
+DEAL_II_NAMESPACE_CLOSE
@@ -566,6 +566,40 @@ namespace DoFTools
     const bool                       keep_constrained_dofs = true,
     const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
 
+  /**
+   * Compute the same entries as the make_sparsity_pattern() function above
+   * (see there for a description of all of the common arguments), but
+   * build the compressed SparsityPattern @p sparsity_pattern directly,
+   * rather than going through a DynamicSparsityPattern and
+   * SparsityPattern::copy_from(). Previous content of @p sparsity_pattern
+   * is lost; it is resized to the number of degrees of freedom and is in
+   * compressed mode afterwards.
+   *
+   * The pattern is set up in two passes over the cells, both of which run
+   * in parallel on the available threads. The first pass only counts how
+   * many column indices each row receives, including those introduced
+   * through @p constraints. The second pass writes the column indices into
+   * the slots of one large array reserved for each row, after which the rows
+   * are sorted and stripped of duplicates in place. In contrast to a
+   * DynamicSparsityPattern, no memory is allocated for individual rows.
+   *
+   * The price for this is that the array of the second pass holds every
+   * coupling once for each cell on which it appears, before duplicates are
+   * removed. For continuous elements of low degree, its peak memory
+   * consumption can therefore be several times that of the final sparsity
+   * pattern.
+   *
+   * @ingroup constraints
+   */
+  template <typename DoFHandlerType, typename number = double>
+  void
+  make_compressed_sparsity_pattern(
+    const DoFHandlerType &           dof_handler,
+    SparsityPattern &                sparsity_pattern,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const bool                       keep_constrained_dofs = true,
+    const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
+
   /**
    * Compute which entries of a matrix built on the given @p dof_handler may
    * possibly be nonzero, and create a sparsity pattern object that represents
@@ -457,6 +457,38 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &                                     p) const = 0;
 
+  /**
+   * Map the points @p real_points on the real @p cell to the corresponding
+   * points on the unit cell, and store their coordinates in @p unit_points.
+   * This does the same as calling transform_real_to_unit_cell() for each of
+   * the points, except that no exception is thrown for points for which the
+   * transformation fails. Instead, the first coordinate of the corresponding
+   * entry of @p unit_points is set to
+   * <code>std::numeric_limits<double>::infinity()</code>, which places the
+   * point outside of the reference cell.
+   *
+   * The default implementation simply calls transform_real_to_unit_cell()
+   * for one point after the other. Derived classes can share the work that
+   * only depends on the cell between all points: MappingQGeneric, for
+   * example, computes the support points of the cell only once and runs the
+   * Newton iterations for several points at once. For points far outside of
+   * the cell, where the inverse of the mapping need not be unique, the
+   * points returned by such an implementation may differ from the ones
+   * computed by transform_real_to_unit_cell(), or be returned where the
+   * latter throws an exception. They still lie outside of the reference
+   * cell, which is usually all one wants to know about such points.
+   *
+   * @param cell Iterator to the cell that will be used to define the mapping.
+   * @param real_points Locations of the points in real space.
+   * @param unit_points Output: the reference cell locations of the points.
+   * Must have the same size as @p real_points.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const;
+
   /**
    * Transform the point @p p on the real @p cell to the corresponding point
    * on the unit cell, and then projects it to a dim-1  point on the face with
@@ -1435,6 +1435,12 @@ namespace GridGenerator
    * This will merge any vertices that are closer than any pair of vertices on
    * the input meshes.
    *
+   * Since a vertex in the interior of one input triangulation can only
+   * coincide with a vertex of another one if the two overlap, only vertices
+   * at the boundaries of the input triangulations are considered for
+   * merging. The descriptions of the input triangulations are set up in
+   * parallel.
+   *
    * @note The two input triangulations must be
    * @ref GlossCoarseMesh "coarse meshes", i.e., they can not have any
    * refined cells.
@@ -1813,6 +1819,39 @@ namespace GridGenerator
                         const std::set<types::boundary_id> &boundary_ids =
                           std::set<types::boundary_id>());
 
+  /**
+   * Like extract_boundary_mesh(), but build the surface mesh directly as a
+   * @ref GlossCoarseMesh "coarse mesh"
+   * with one cell for each selected active boundary face of the volume
+   * mesh, rather than from the faces of the coarse cells followed by
+   * refining the surface mesh level by level. For a refined volume mesh, the
+   * result is a flat mesh of the same cells as the active cells of the
+   * surface mesh created by extract_boundary_mesh(), which is much cheaper
+   * to create since no refinement has to be executed, and whose vertices
+   * are exactly the vertices of the volume mesh, regardless of the
+   * manifolds attached to @p surface_mesh. Boundary and manifold indicators
+   * are copied from the active faces and their edges, so they may also
+   * differ from those of the coarse faces.
+   *
+   * The selected active boundary faces must not have hanging nodes, since
+   * a coarse mesh can not represent them. This is always the case in 2d,
+   * and in 3d if the volume mesh is globally refined or refined only away
+   * from the selected boundary.
+   *
+   * @return A map that for each cell of the surface mesh (key) returns an
+   * iterator to the corresponding active face of a cell of the volume mesh
+   * (value). The same remarks about the order of vertices apply as for
+   * extract_boundary_mesh().
+   */
+  template <int dim, int spacedim>
+  std::map<typename Triangulation<dim - 1, spacedim>::cell_iterator,
+           typename Triangulation<dim, spacedim>::face_iterator>
+  extract_active_boundary_mesh(
+    const Triangulation<dim, spacedim> &volume_mesh,
+    Triangulation<dim - 1, spacedim> &  surface_mesh,
+    const std::set<types::boundary_id> &boundary_ids =
+      std::set<types::boundary_id>());
+
   ///@}
 
 
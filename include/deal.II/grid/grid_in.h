@@ -154,7 +154,8 @@ struct CellData;
  *
  * <li> <tt>Gmsh 2.0 mesh</tt> format: this is a variant of the above format.
  * The read_msh() function automatically determines whether an input file is
- * version 1 or version 2.
+ * version 1 or version 2. Version 4.1 of the format can also be read if
+ * Gmsh wrote it in binary form.
  *
  * <li> <tt>Tecplot</tt> format: this format is used by @p TECPLOT and often
  * serves as a basis for data exchange between different applications. Note,
@@ -490,6 +491,12 @@ public:
    * @note The input function of deal.II does not distinguish between newline
    * and other whitespace. Therefore, deal.II will be able to read files in a
    * slightly more general format than Gmsh.
+   *
+   * Files in the binary variant of version 4.1 of the format are read in
+   * one piece, after which the nodes and elements are converted in
+   * parallel. Such files have to be opened with <tt>std::ios::binary</tt>
+   * on systems that distinguish between text and binary streams; read()
+   * does this for files of format msh.
    */
   void
   read_msh(std::istream &in);
@@ -56,7 +56,9 @@
 #  endif
 
 
+#  include <array>
 #  include <bitset>
+#  include <cstdint>
 #  include <list>
 #  include <set>
 
@@ -374,13 +376,17 @@ namespace GridTools
    *
    * This function is called by some <tt>GridIn::read_*</tt> functions. Only
    * the vertices with indices in @p considered_vertices are tested for
-   * equality. This speeds up the algorithm, which is quadratic and thus quite
-   * slow to begin with. However, if you wish to consider all vertices, simply
-   * pass an empty vector. In that case, the function fills
-   * @p considered_vertices with all vertices.
+   * equality. This speeds up the algorithm. However, if you wish to consider
+   * all vertices, simply pass an empty vector. In that case, the function
+   * fills @p considered_vertices with all vertices.
    *
    * Two vertices are considered equal if their difference in each coordinate
-   * direction is less than @p tol.
+   * direction is less than @p tol. If several vertices are equal, they are
+   * all replaced by the one that comes first in @p considered_vertices. The
+   * vertices are sorted into a grid of buckets of width comparable to
+   * @p tol, so that each vertex is only compared with the ones close to it,
+   * and the cost of the function grows essentially linearly with the number
+   * of considered vertices.
    */
   template <int dim, int spacedim>
   void
@@ -390,6 +396,51 @@ namespace GridTools
                              std::vector<unsigned int> &   considered_vertices,
                              const double                  tol = 1e-12);
 
+  /**
+   * Renumber the cells and vertices of a coarse mesh description so that
+   * cells that are close to each other in space are also close to each other
+   * in the list of cells. Meshes read from files, in particular those
+   * generated by unstructured mesh generators, often come with an ordering
+   * in which neighboring cells are far apart; since the cells of a
+   * Triangulation are traversed in the order in which they were created,
+   * such an ordering leads to poor cache utilization in all loops over
+   * cells.
+   *
+   * The cells are sorted by the position of their centers along a Hilbert
+   * space filling curve, see Utilities::inverse_Hilbert_space_filling_curve().
+   * The vertices are then numbered in the order in which they are first
+   * used by the sorted cells, followed by the vertices not used by any cell.
+   * The vertex indices stored in @p cells and @p subcelldata are changed
+   * accordingly. The order of the vertices within each cell is not changed,
+   * so cells that have been oriented by GridReordering::reorder_cells()
+   * keep their orientation.
+   *
+   * This function is meant to be called before
+   * Triangulation::create_triangulation(), in the same way as
+   * delete_duplicated_vertices().
+   */
+  template <int dim, int spacedim>
+  void
+  reorder_hilbert(std::vector<Point<spacedim>> &vertices,
+                  std::vector<CellData<dim>> &  cells,
+                  SubCellData &                 subcelldata);
+
+  /**
+   * Renumber the coarse cells and the vertices of @p triangulation along a
+   * Hilbert space filling curve, as described in the function above. The
+   * triangulation is recreated from its coarse mesh description, keeping
+   * material, boundary, and manifold indicators as well as the manifold
+   * objects attached to it.
+   *
+   * The triangulation must not be refined and must not be a parallel
+   * triangulation. Since all cells are recreated, objects that refer to the
+   * triangulation, such as DoFHandler objects, need to be set up again
+   * afterwards, and user data stored on cells, faces, and lines is lost.
+   */
+  template <int dim, int spacedim>
+  void
+  reorder_hilbert(Triangulation<dim, spacedim> &triangulation);
+
   /*@}*/
   /**
    * @name Rotating, stretching and otherwise transforming meshes
@@ -862,6 +913,53 @@ namespace GridTools
       &cell_hint =
         typename Triangulation<dim, spacedim>::active_cell_iterator());
 
+  /**
+   * This function does the same as
+   * GridTools::compute_point_locations_try_all(), but it is designed for
+   * large sets of points, say thousands or more, that are not given in any
+   * particular order. The cells and the reference coordinates it returns are
+   * the same up to the order of the entries and, for points on faces or
+   * vertices shared by several cells, the choice of the cell.
+   *
+   * Rather than searching for one point after the other, the function
+   * works in the following steps:
+   * - The points are sorted along a Morton (Z-order) space-filling curve,
+   *   so that points close to each other in space are processed together.
+   * - For groups of consecutive points in this order, a single query to
+   *   the rtree returned by GridTools::Cache::get_cell_bounding_boxes_rtree()
+   *   collects the cells whose bounding boxes intersect the bounding box of
+   *   the group. Each point then only keeps the cells whose bounding box
+   *   contains it.
+   * - All points that have the same candidate cell are transformed to its
+   *   reference cell by a single call to
+   *   Mapping::transform_points_real_to_unit_cell(), which for
+   *   MappingQGeneric computes the support points of the cell only once and
+   *   runs the Newton iteration for several points at once, using the
+   *   vector units of the processor.
+   *
+   * Points that are not found in any of their candidate cells are searched
+   * for with GridTools::find_active_cell_around_point(), as in
+   * GridTools::compute_point_locations_try_all().
+   *
+   * @return A tuple with the same four elements as the one returned by
+   * GridTools::compute_point_locations_try_all(). The cells are sorted by the
+   * smallest index of a point they contain, the indices of the points within
+   * every cell as well as the indices of the points not found are sorted in
+   * ascending order.
+   */
+  template <int dim, int spacedim>
+#  ifndef DOXYGEN
+  std::tuple<
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>,
+    std::vector<std::vector<Point<dim>>>,
+    std::vector<std::vector<unsigned int>>,
+    std::vector<unsigned int>>
+#  else
+  return_type
+#  endif
+  batched_compute_point_locations(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points);
+
   /**
    * Given a @p cache and a list of
    * @p local_points for each process, find the points lying on the locally
@@ -2554,7 +2652,10 @@ namespace GridTools
    *
    * This function tries to match all faces belonging to the first boundary
    * with faces belonging to the second boundary with the help of
-   * orthogonal_equality().
+   * orthogonal_equality(). To avoid comparing each face of the first
+   * boundary with every face of the second one, the faces are first sorted
+   * into buckets by the location of their centers, ignoring the component
+   * @p direction, and only faces in neighboring buckets are compared.
    *
    * The bitset that is returned inside of PeriodicFacePair encodes the
    * _relative_ orientation of the first face with respect to the second face,
@@ -3013,6 +3114,74 @@ namespace GridTools
     BOOST_SERIALIZATION_SPLIT_MEMBER()
   };
 
+
+
+  namespace internal
+  {
+    /**
+     * A uniform grid of buckets into which a set of points is sorted, so
+     * that all points that are close to a given point can be found in
+     * expected constant time instead of comparing with every point. This
+     * is used by delete_duplicated_vertices() and collect_periodic_faces()
+     * to match vertices and faces in near-linear time.
+     *
+     * The width of the buckets is at least twice the tolerance given to
+     * the constructor. Consequently, all points whose difference to a
+     * query point is at most the tolerance in each coordinate direction
+     * are located in the bucket of the query point or in one of its
+     * neighbors. Callers need to check the candidates returned by
+     * get_candidates() with their own criterion.
+     */
+    template <int spacedim>
+    class PointBucketGrid
+    {
+    public:
+      /**
+       * Sort the given @p points into buckets. The points are not copied.
+       */
+      PointBucketGrid(const std::vector<Point<spacedim>> &points,
+                      const double                        tolerance);
+
+      /**
+       * Return the indices of all points that lie in the bucket of
+       * @p point or in one of the neighboring buckets, in ascending order.
+       * This is a superset of the indices of all points whose difference to
+       * @p point is at most the tolerance in each coordinate direction.
+       */
+      void
+      get_candidates(const Point<spacedim> &    point,
+                     std::vector<unsigned int> &candidates) const;
+
+    private:
+      /**
+       * Integer coordinates of a bucket.
+       */
+      using BucketIndex = std::array<std::int64_t, spacedim>;
+
+      /**
+       * Return the coordinates of the bucket that contains @p point.
+       */
+      BucketIndex
+      bucket_of(const Point<spacedim> &point) const;
+
+      /**
+       * Lower left corner of the bounding box of the points.
+       */
+      Point<spacedim> origin;
+
+      /**
+       * The width of the buckets.
+       */
+      double bucket_width;
+
+      /**
+       * The bucket coordinates and the index of each point, sorted
+       * lexicographically by bucket.
+       */
+      std::vector<std::pair<BucketIndex, unsigned int>> sorted_points;
+    };
+  } // namespace internal
+
   /**
    * @name Exceptions
    */
@@ -62,12 +62,62 @@ namespace GridTools
    * obsolete, and you will have to mark them as outdated, by calling the
    * method mark_for_update() manually.
    *
+   * <h3>Incremental updates after local refinement</h3>
+   *
+   * When only a few cells are refined or coarsened, recomputing all cached
+   * objects would cost as much as computing them for a new mesh. This class
+   * therefore also listens to the signals the Triangulation triggers for every
+   * cell that is refined or coarsened, and remembers which cells and vertices
+   * changed. The vertex to cell map, the map of used vertices, and the RTree
+   * objects of used vertices and of cell bounding boxes are then updated the
+   * next time one of them is requested, by recomputing only the entries that
+   * belong to the changed vertices, and by removing and inserting only the
+   * changed cells and vertices in the RTree objects. All other objects are
+   * rebuilt from scratch as before.
+   *
+   * Incremental updates are only done for objects that were up to date when
+   * the refinement started, and only if the changed cells make up a small
+   * fraction of the mesh: beyond that, rebuilding the objects is cheaper
+   * than updating them entry by entry. They are also not done for
+   * parallel::TriangulationBase objects, where a refinement step changes the
+   * set of artificial cells without the corresponding signals, nor for
+   * mappings that move vertices, for which the cached objects depend on more
+   * than the Triangulation. The counters returned by get_statistics() tell
+   * how often the cached objects could be reused, and how often they had to
+   * be updated incrementally or rebuilt.
+   *
    * @author Luca Heltai, 2017.
    */
   template <int dim, int spacedim = dim>
   class Cache : public Subscriptor
   {
   public:
+    /**
+     * Counters of how often the objects cached by this class were reused,
+     * updated incrementally, or rebuilt, as returned by get_statistics().
+     */
+    struct Statistics
+    {
+      /**
+       * Number of calls to one of the `get_*` functions that returned the
+       * cached object without any work. Calls that the `get_*` functions
+       * make to each other are counted as well.
+       */
+      unsigned int n_hits = 0;
+
+      /**
+       * Number of times the cached objects were updated incrementally after
+       * a refinement step. All objects updated incrementally after the same
+       * step are counted once.
+       */
+      unsigned int n_incremental_updates = 0;
+
+      /**
+       * Number of times one of the cached objects was rebuilt from scratch.
+       */
+      unsigned int n_full_updates = 0;
+    };
+
     /**
      * Constructor.
      *
@@ -186,12 +236,124 @@ namespace GridTools
     get_vertex_kdtree() const;
 #endif
 
+    /**
+     * Return the counters of how often the cached objects were reused,
+     * updated incrementally, or rebuilt since this object was created.
+     */
+    const Statistics &
+    get_statistics() const;
+
   private:
+    /**
+     * The cells and vertices changed by the refinement of the Triangulation
+     * since the objects listed in @p flags were last brought up to date.
+     */
+    struct MeshChanges
+    {
+      /**
+       * The objects that are to be updated incrementally.
+       */
+      CacheUpdateFlags flags = update_nothing;
+
+      /**
+       * The number of cells refined or coarsened so far, and the number
+       * beyond which the changes are no longer tracked.
+       */
+      unsigned int n_changed_cells     = 0;
+      unsigned int max_n_changed_cells = 0;
+
+      /**
+       * The vertices whose entries in the vertex to cell map and the map of
+       * used vertices need to be recomputed. The same vertex may appear
+       * more than once.
+       */
+      std::vector<unsigned int> vertices;
+
+      /**
+       * The cells that were refined, and the cells whose children were
+       * removed.
+       */
+      std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+        refined_cells;
+      std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+        coarsened_cells;
+
+      /**
+       * The cells that were active before the refinement and are no longer,
+       * together with their bounding boxes.
+       */
+      std::set<typename Triangulation<dim, spacedim>::cell_iterator>
+        removed_cells;
+      std::vector<
+        std::pair<BoundingBox<spacedim>,
+                  typename Triangulation<dim, spacedim>::cell_iterator>>
+        removed_bounding_boxes;
+    };
+
+    /**
+     * Prepare for tracking the cells changed by the refinement that is about
+     * to start, connected to Triangulation::Signals::pre_refinement.
+     */
+    void
+    start_tracking_changes();
+
+    /**
+     * Record that the children of @p cell are going to be removed.
+     */
+    void
+    track_coarsening(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+    /**
+     * Record that @p cell has just been refined.
+     */
+    void
+    track_refinement(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+    /**
+     * Add the vertices to the list of changed vertices whose entries in the
+     * vertex to cell map may contain @p cell.
+     */
+    void
+    add_changed_vertices(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+    /**
+     * Apply the changes recorded in #mesh_changes to the objects that are
+     * updated incrementally. Return whether there was anything to do.
+     */
+    bool
+    update_incrementally() const;
+
     /**
      * Keep track of what needs to be updated next.
      */
     mutable CacheUpdateFlags update_flags;
 
+    /**
+     * The changes of the Triangulation not yet applied to the objects
+     * updated incrementally.
+     */
+    mutable MeshChanges mesh_changes;
+
+    /**
+     * Whether the Triangulation is between the pre_refinement and the
+     * any_change signals of a refinement step.
+     */
+    bool refinement_in_progress;
+
+    /**
+     * Whether changes are tracked at all, see the documentation of this
+     * class.
+     */
+    bool track_changes;
+
+    /**
+     * How often the cached objects were reused, updated, or rebuilt.
+     */
+    mutable Statistics statistics;
+
     /**
      * A pointer to the Triangulation.
      */
@@ -252,9 +414,9 @@ namespace GridTools
       cell_bounding_boxes_rtree;
 
     /**
-     * Storage for the status of the triangulation signal.
+     * Storage for the status of the triangulation signals.
      */
-    boost::signals2::connection tria_signal;
+    std::vector<boost::signals2::connection> tria_signals;
   };
 
 
@@ -275,6 +437,15 @@ namespace GridTools
   {
     return *mapping;
   }
+
+
+
+  template <int dim, int spacedim>
+  inline const typename Cache<dim, spacedim>::Statistics &
+  Cache<dim, spacedim>::get_statistics() const
+  {
+    return statistics;
+  }
 } // namespace GridTools
 
 
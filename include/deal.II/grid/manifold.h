@@ -327,6 +327,26 @@ namespace Manifolds
  * approximate the limit process, and derived classes should do so.
  *
  *
+ * <h3>Thread safety</h3>
+ *
+ * Triangulation::execute_coarsening_and_refinement() can compute the
+ * locations of the new vertices on different lines, quads, and cells in
+ * parallel, using the task-based parallelism described in the
+ * @ref threads "Parallel computing with multiple processors" module. It
+ * only does so if all manifolds attached to the triangulation declare, by
+ * returning true from is_thread_safe(), that their functions
+ * get_new_point(), get_new_points(), get_intermediate_point(), and
+ * project_to_manifold() may be called concurrently from several threads on
+ * the same object. This requires that these functions do not modify member
+ * variables, e.g., to cache data, unless that access is protected by a
+ * mutex. Otherwise, the new points are computed sequentially.
+ *
+ * This class returns false from is_thread_safe(). FlatManifold and most of
+ * the classes in manifold_lib.h return true. Classes derived from one of
+ * the latter that compute points differently must override
+ * is_thread_safe() again unless their implementation is thread-safe as
+ * well.
+ *
  * @ingroup manifold
  * @author Luca Heltai, Wolfgang Bangerth, 2014, 2016
  */
@@ -369,6 +389,20 @@ public:
   virtual std::unique_ptr<Manifold<dim, spacedim>>
   clone() const = 0;
 
+  /**
+   * Return whether the functions that compute new points, i.e.,
+   * get_intermediate_point(), get_new_point(), get_new_points(), and
+   * project_to_manifold(), may be called concurrently from several threads
+   * on the same object. Triangulation::execute_coarsening_and_refinement()
+   * only computes the locations of new vertices in parallel if all
+   * manifolds attached to the triangulation return true here; see the
+   * section on thread safety in the documentation of this class.
+   *
+   * The default implementation returns false.
+   */
+  virtual bool
+  is_thread_safe() const;
+
   /**
    * @name Computing the location of points.
    */
@@ -718,6 +752,12 @@ public:
   virtual std::unique_ptr<Manifold<dim, spacedim>>
   clone() const override;
 
+  /**
+   * Return true: the functions of this class do not modify the object.
+   */
+  virtual bool
+  is_thread_safe() const override;
+
   /**
    * Let the new point be the average sum of surrounding vertices.
    *
@@ -79,6 +79,12 @@ public:
   virtual std::unique_ptr<Manifold<dim, spacedim>>
   clone() const override;
 
+  /**
+   * Return true: the functions of this class do not modify the object.
+   */
+  virtual bool
+  is_thread_safe() const override;
+
   /**
    * Pull back the given point from the Euclidean space. Will return the polar
    * coordinates associated with the point @p space_point. Only used when
@@ -234,6 +240,12 @@ public:
   virtual std::unique_ptr<Manifold<dim, spacedim>>
   clone() const override;
 
+  /**
+   * Return true: the functions of this class do not modify the object.
+   */
+  virtual bool
+  is_thread_safe() const override;
+
   /**
    * Given any two points in space, first project them on the surface
    * of a sphere with unit radius, then connect them with a geodesic
@@ -405,6 +417,12 @@ public:
   virtual std::unique_ptr<Manifold<dim, spacedim>>
   clone() const override;
 
+  /**
+   * Return true: the functions of this class do not modify the object.
+   */
+  virtual bool
+  is_thread_safe() const override;
+
   /**
    * Compute the cylindrical coordinates $(r, \phi, \lambda)$ for the given
    * space point where $r$ denotes the distance from the axis,
@@ -440,6 +458,18 @@ public:
   get_new_point(const ArrayView<const Point<spacedim>> &surrounding_points,
                 const ArrayView<const double> &         weights) const override;
 
+  /**
+   * Compute a new set of points that interpolate between the given points @p
+   * surrounding_points, with the same result as calling get_new_point() for
+   * each row of @p weights. The surrounding points are pulled back only once,
+   * and the averages in cylindrical coordinates as well as their push forward
+   * are computed for several rows at once using VectorizedArray.
+   */
+  virtual void
+  get_new_points(const ArrayView<const Point<spacedim>> &surrounding_points,
+                 const Table<2, double> &                weights,
+                 ArrayView<Point<spacedim>> new_points) const override;
+
 protected:
   /**
    * A vector orthogonal to the normal direction.
@@ -519,6 +549,12 @@ public:
   virtual std::unique_ptr<Manifold<dim, spacedim>>
   clone() const override;
 
+  /**
+   * Return true: the functions of this class do not modify the object.
+   */
+  virtual bool
+  is_thread_safe() const override;
+
   /**
    * @copydoc ChartManifold::pull_back()
    */
@@ -775,6 +811,12 @@ public:
   virtual std::unique_ptr<Manifold<dim, 3>>
   clone() const override;
 
+  /**
+   * Return true: the functions of this class do not modify the object.
+   */
+  virtual bool
+  is_thread_safe() const override;
+
   /**
    * Pull back operation.
    */
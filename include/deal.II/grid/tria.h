@@ -2265,6 +2265,10 @@ public:
      *
      * @note The signal parameter @p cell corresponds to the immediate parent
      * cell of a set of newly created active cells.
+     *
+     * @note The signal is triggered after all cells of the current
+     * refinement step have been refined and the locations of all new
+     * vertices have been computed.
      */
     boost::signals2::signal<void(
       const typename Triangulation<dim, spacedim>::cell_iterator &cell)>
@@ -3442,6 +3446,34 @@ public:
   virtual std::size_t
   memory_consumption() const;
 
+  /**
+   * Release memory that is not needed to represent the current mesh,
+   * without changing the mesh or the way it is accessed through iterators.
+   *
+   * Refinement leaves the arrays storing the cells, faces and vertices with
+   * capacity beyond their size, and stores data for every object that only
+   * few objects need. This function trims all arrays to their size and
+   * releases the arrays storing the children and refinement cases of all
+   * cells, faces and edges of a kind that have no children, as well as the
+   * arrays storing user pointers or indices if none of them is set. For a
+   * mesh that consists of a single level, this includes the children of all
+   * cells and faces; the parent indices of the coarsest level are released
+   * in any case, since its cells have no parents. On such meshes, the
+   * function reduces memory consumption by about a quarter in 2d and by
+   * about a third in 3d.
+   *
+   * To obtain a mesh with a single level from a refined one, i.e., to drop
+   * the coarser levels of the refinement history, use
+   * GridGenerator::flatten_triangulation() before calling this function.
+   *
+   * The mesh may still be refined, and user pointers or indices may still
+   * be set after calling this function. The first such change recreates the
+   * released arrays, so it must not happen concurrently on different threads
+   * even for different cells.
+   */
+  void
+  compact_storage();
+
   /**
    * Write the data of this object to a stream for the purpose of
    * serialization.
@@ -3473,6 +3505,56 @@ public:
   void
   load(Archive &ar, const unsigned int version);
 
+  /**
+   * Write the triangulation to the file @p filename in a compact binary
+   * format, for example to restart a computation later on with
+   * load_checkpoint().
+   *
+   * The file contains the same information as the one written by save(),
+   * i.e., all cells on all levels together with their vertices, material,
+   * boundary, manifold, and subdomain ids, refinement and coarsening flags,
+   * and user flags and indices. Since these are stored as the internal
+   * arrays of the triangulation are laid out in memory, loading the file
+   * only copies these arrays back rather than rebuilding the mesh
+   * hierarchy by refining the coarse mesh again, and is considerably faster
+   * than going through BOOST serialization.
+   *
+   * The file starts with a header that identifies the format, its version,
+   * the dimensions of the triangulation, and the byte order and size of the
+   * types stored. It can therefore only be read on machines with the same
+   * data layout. Every array in the file starts at an offset that is a
+   * multiple of eight bytes.
+   *
+   * @note As for save(), manifold objects, signals, and periodic faces are
+   * not stored. They have to be attached again after loading.
+   *
+   * @note This function only stores the part of a
+   * parallel::distributed::Triangulation owned by the current process,
+   * and the file can not be used to restore such a triangulation. Use
+   * parallel::distributed::Triangulation::save() instead.
+   */
+  void
+  save_checkpoint(const std::string &filename) const;
+
+  /**
+   * Read a triangulation from a file written by save_checkpoint(), after
+   * throwing away the previous content. The file is read into memory in a
+   * single operation.
+   *
+   * An exception is thrown if the file has not been written by
+   * save_checkpoint(), if it has been written for a triangulation of other
+   * dimensions or with a different version of the format, or if it is
+   * incomplete or otherwise corrupted. All data is read and checked before
+   * the previous content is thrown away, so the triangulation is left
+   * unchanged in these cases.
+   *
+   * @note Like load(), this function calls the Triangulation::clear()
+   * function and consequently triggers the "clear" signal. After loading
+   * all data, it then triggers the "create" signal.
+   */
+  void
+  load_checkpoint(const std::string &filename);
+
 
   /**
    * Declare the (coarse) face pairs given in the argument of this function as
@@ -1464,7 +1464,7 @@ TriaAccessor<structdim, dim, spacedim>::refinement_case() const
     {
       case 1:
         return (RefinementCase<structdim>(
-          this->objects().children[this->present_index] != -1 ?
+          this->has_children() ?
             // cast the branches
             // here first to uchar
             // and then (above) to
@@ -1480,6 +1480,11 @@ TriaAccessor<structdim, dim, spacedim>::refinement_case() const
             static_cast<std::uint8_t>(RefinementCase<1>::no_refinement)));
 
       default:
+        // the refinement cases may have been released by
+        // Triangulation::compact_storage() if no object has children
+        if (this->objects().refinement_cases.empty())
+          return RefinementCase<structdim>::no_refinement;
+
         Assert(static_cast<unsigned int>(this->present_index) <
                  this->objects().refinement_cases.size(),
                ExcIndexRange(this->present_index,
@@ -1589,7 +1594,12 @@ TriaAccessor<structdim, dim, spacedim>::has_children() const
   // the location of the set of children
   const unsigned int n_sets_of_two =
     GeometryInfo<structdim>::max_children_per_cell / 2;
-  return (this->objects().children[n_sets_of_two * this->present_index] != -1);
+  const std::vector<int> &children = this->objects().children;
+
+  // the children may have been released by
+  // Triangulation::compact_storage() if no object has children
+  return (!children.empty() &&
+          children[n_sets_of_two * this->present_index] != -1);
 }
 
 
@@ -1611,6 +1621,7 @@ TriaAccessor<structdim, dim, spacedim>::set_refinement_case(
   Assert(this->state() == IteratorState::valid,
          TriaAccessorExceptions::ExcDereferenceInvalidObject<TriaAccessor>(
            *this));
+  this->objects().allocate_children();
   Assert(static_cast<unsigned int>(this->present_index) <
            this->objects().refinement_cases.size(),
          ExcIndexRange(this->present_index,
@@ -1628,6 +1639,8 @@ TriaAccessor<structdim, dim, spacedim>::clear_refinement_case() const
   Assert(this->state() == IteratorState::valid,
          TriaAccessorExceptions::ExcDereferenceInvalidObject<TriaAccessor>(
            *this));
+  if (this->objects().refinement_cases.empty())
+    return;
   Assert(static_cast<unsigned int>(this->present_index) <
            this->objects().refinement_cases.size(),
          ExcIndexRange(this->present_index,
@@ -1668,6 +1681,12 @@ TriaAccessor<structdim, dim, spacedim>::set_children(const unsigned int i,
          -1),
     TriaAccessorExceptions::ExcCantSetChildren(index));
 
+  // clearing the children of an object is a no-op if they have been
+  // released by Triangulation::compact_storage()
+  if (index == -1 && this->objects().children.empty())
+    return;
+  this->objects().allocate_children();
+
   this->objects().children[n_sets_of_two * this->present_index + i / 2] = index;
 }
 
@@ -1780,7 +1799,10 @@ void *
 TriaAccessor<structdim, dim, spacedim>::user_pointer() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->objects().user_pointer(this->present_index);
+  // read through the const overload, which does not recreate user data
+  // released by Triangulation::compact_storage()
+  const auto &objects = this->objects();
+  return const_cast<void *>(objects.user_pointer(this->present_index));
 }
 
 
@@ -1837,7 +1859,8 @@ unsigned int
 TriaAccessor<structdim, dim, spacedim>::user_index() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->objects().user_index(this->present_index);
+  const auto &objects = this->objects();
+  return objects.user_index(this->present_index);
 }
 
 
@@ -69,6 +69,13 @@ namespace internal
     class TriaFaces<1>
     {
     public:
+      /**
+       * Release memory not needed to represent the faces. Of course this
+       * does nothing.
+       */
+      void
+      compact_storage();
+
       /**
        * Determine an estimate for the memory consumption (in bytes) of this
        * object. Of course this returns 0.
@@ -98,6 +105,13 @@ namespace internal
       TriaObjects<TriaObject<1>> lines;
 
     public:
+      /**
+       * Release memory not needed to represent the faces, see
+       * TriaObjects::compact_storage().
+       */
+      void
+      compact_storage();
+
       /**
        * Determine an estimate for the memory consumption (in bytes) of this
        * object.
@@ -134,6 +148,13 @@ namespace internal
       TriaObjects<TriaObject<1>> lines;
 
     public:
+      /**
+       * Release memory not needed to represent the faces, see
+       * TriaObjects::compact_storage().
+       */
+      void
+      compact_storage();
+
       /**
        * Determine an estimate for the memory consumption (in bytes) of this
        * object.
@@ -178,6 +178,14 @@ namespace internal
                     const unsigned int dimension,
                     const unsigned int space_dimension);
 
+      /**
+       * Release the capacity of all arrays beyond their size, and the data of
+       * the cells on this level that is not needed to represent them, see
+       * TriaObjects::compact_storage().
+       */
+      void
+      compact_storage();
+
       /**
        * Check the memory consistency of the different containers. Should only
        * be called with the preprocessor flag @p DEBUG set. The function
@@ -246,6 +254,8 @@ namespace internal
                     const unsigned int dimension,
                     const unsigned int space_dimension);
       void
+      compact_storage();
+      void
       monitor_memory(const unsigned int true_dimension) const;
       std::size_t
       memory_consumption() const;
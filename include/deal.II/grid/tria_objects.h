@@ -236,6 +236,35 @@ namespace internal
       void
       clear();
 
+      /**
+       * Release memory that is not needed to represent the present objects:
+       * the capacity of all arrays beyond their size, the arrays #children
+       * and #refinement_cases if none of the objects has children, and the
+       * array #user_data if all user pointers and indices are zero.
+       *
+       * Released arrays are empty while #cells is not. Functions reading
+       * them treat this like an array filled with the default values, and
+       * functions writing to them recreate the full array first by calling
+       * allocate_children() and allocate_user_data(), respectively.
+       */
+      void
+      compact_storage();
+
+      /**
+       * Recreate the arrays #children and #refinement_cases if they have
+       * been released by compact_storage(), with all objects having no
+       * children.
+       */
+      void
+      allocate_children();
+
+      /**
+       * Recreate the array #user_data if it has been released by
+       * compact_storage(), with all entries being zero.
+       */
+      void
+      allocate_user_data();
+
       /**
        * The orientation of the face number <code>face</code> of the cell with
        * number <code>cell</code>. The return value is <code>true</code>, if
@@ -484,6 +513,13 @@ namespace internal
       void
       clear();
 
+      /**
+       * Release memory not needed to represent the present hexes, see
+       * TriaObjects::compact_storage().
+       */
+      void
+      compact_storage();
+
       /**
        * Check the memory consistency of the different containers. Should only
        * be called with the preprocessor flag @p DEBUG set. The function
@@ -552,6 +588,13 @@ namespace internal
       void
       clear();
 
+      /**
+       * Release memory not needed to represent the present quads, see
+       * TriaObjects::compact_storage().
+       */
+      void
+      compact_storage();
+
       /**
        * Check the memory consistency of the different containers. Should only
        * be called with the preprocessor flag @p DEBUG set. The function
@@ -635,6 +678,7 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
+      allocate_user_data();
       Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
       return user_data[i].p;
     }
@@ -648,6 +692,8 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
+      if (user_data.empty())
+        return nullptr;
       Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
       return user_data[i].p;
     }
@@ -661,6 +707,7 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
+      allocate_user_data();
       Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
       return user_data[i].i;
     }
@@ -670,6 +717,8 @@ namespace internal
     inline void
     TriaObjects<G>::clear_user_data(const unsigned int i)
     {
+      if (user_data.empty())
+        return;
       Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
       user_data[i].i = 0;
     }
@@ -692,6 +741,8 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
+      if (user_data.empty())
+        return 0;
       Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
       return user_data[i].i;
     }
@@ -707,6 +758,32 @@ namespace internal
     }
 
 
+    template <typename G>
+    inline void
+    TriaObjects<G>::allocate_children()
+    {
+      if (children.empty() && !cells.empty())
+        {
+          children.resize(GeometryInfo<G::dimension>::max_children_per_cell /
+                            2 * cells.size(),
+                          -1);
+          if (G::dimension > 1)
+            refinement_cases.resize(
+              cells.size(),
+              RefinementCase<G::dimension>::no_refinement);
+        }
+    }
+
+
+    template <typename G>
+    inline void
+    TriaObjects<G>::allocate_user_data()
+    {
+      if (user_data.empty() && !cells.empty())
+        user_data.resize(cells.size());
+    }
+
+
     template <typename G>
     inline void
     TriaObjects<G>::clear_user_flags()
@@ -633,6 +633,45 @@ public:
   void
   resolve_indices(std::vector<types::global_dof_index> &indices) const;
 
+  /**
+   * Return the degrees of freedom of @p cell together with all degrees of
+   * freedom the constrained ones among them are constrained to, i.e., the
+   * rows of the global matrix and the entries of the global vector that
+   * distribute_local_to_global() may write to for this cell.
+   *
+   * This is the set of conflict indicators to be passed to
+   * GraphColoring::make_graph_coloring() if the copier of an assembly loop
+   * calls distribute_local_to_global(): cells of the same color then write
+   * into disjoint rows, so that WorkStream::run() with colored iterators
+   * may run the copiers of all cells of one color concurrently without any
+   * locking, rather than calling them one after the other:
+   * @code
+   * const auto colored_cells = GraphColoring::make_graph_coloring(
+   *   dof_handler.begin_active(),
+   *   dof_handler.end(),
+   *   [&constraints](
+   *     const typename DoFHandler<dim>::active_cell_iterator &cell) {
+   *     return constraints.get_conflict_indices(cell);
+   *   });
+   *
+   * WorkStream::run(colored_cells, worker, copier, scratch_data, copy_data);
+   * @endcode
+   * The degrees of freedom of the cell alone are not sufficient for this
+   * purpose if there are hanging node or other constraints, since two cells
+   * without common degrees of freedom may still write into the same rows
+   * through them.
+   *
+   * @note The cells of one color are spread over the whole mesh, so the
+   * copier accesses the rows of the matrix in a less cache friendly order
+   * than in the serial case, and the coloring itself is considerably more
+   * expensive than one pass of copying. Coloring is thus only worthwhile if
+   * the same coloring is used for many assemblies and several cores would
+   * otherwise wait for the copier.
+   */
+  template <typename CellIteratorType>
+  std::vector<types::global_dof_index>
+  get_conflict_indices(const CellIteratorType &cell) const;
+
   /**
    * @}
    */
@@ -1799,6 +1838,18 @@ AffineConstraints<number>::get_local_lines() const
   return local_lines;
 }
 
+template <typename number>
+template <typename CellIteratorType>
+inline std::vector<types::global_dof_index>
+AffineConstraints<number>::get_conflict_indices(
+  const CellIteratorType &cell) const
+{
+  std::vector<types::global_dof_index> indices(cell->get_fe().dofs_per_cell);
+  cell->get_dof_indices(indices);
+  resolve_indices(indices);
+  return indices;
+}
+
 template <typename number>
 template <class VectorType>
 inline void
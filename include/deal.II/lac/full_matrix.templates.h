@@ -29,6 +29,7 @@
 #include <deal.II/base/template_constraints.h>
 
 #include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/full_matrix_kernels.h>
 #include <deal.II/lac/lapack_full_matrix.h>
 #include <deal.II/lac/lapack_templates.h>
 #include <deal.II/lac/vector.h>
@@ -42,6 +43,166 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+namespace internal
+{
+  namespace FullMatrixImplementation
+  {
+    // Hand products to the kernels in FullMatrixKernels if both operands
+    // are of the same type and VectorizedArray has more than one lane for
+    // it. The general template covers mixed and complex types, which keep
+    // the plain loops in FullMatrix and never call the functions below.
+    template <typename number, typename number2>
+    struct SmallKernels
+    {
+      static const bool applies = false;
+
+      template <bool transpose_a>
+      static void
+      gemm(const unsigned int,
+           const unsigned int,
+           const unsigned int,
+           const number *,
+           const number2 *,
+           number2 *,
+           const bool)
+      {
+        Assert(false, ExcInternalError());
+      }
+
+      static void
+      gemm_transpose_b(const unsigned int,
+                       const unsigned int,
+                       const unsigned int,
+                       const number *,
+                       const number2 *,
+                       number2 *,
+                       const bool)
+      {
+        Assert(false, ExcInternalError());
+      }
+
+      static void
+      gemv(const unsigned int,
+           const unsigned int,
+           const number *,
+           const number2 *,
+           number2 *,
+           const bool)
+      {
+        Assert(false, ExcInternalError());
+      }
+
+      static void
+      gemv_transpose(const unsigned int,
+                     const unsigned int,
+                     const number *,
+                     const number2 *,
+                     number2 *,
+                     const bool)
+      {
+        Assert(false, ExcInternalError());
+      }
+    };
+
+
+
+    // all matrices are stored contiguously, so the distance between two rows
+    // is the number of columns
+    template <typename number>
+    struct SmallKernels<number, number>
+    {
+      static const bool applies =
+        (VectorizedArray<number>::n_array_elements > 1);
+
+      // C = op(A) B with op(A) of size m x l and B of size l x n
+      template <bool transpose_a>
+      static void
+      gemm(const unsigned int m,
+           const unsigned int n,
+           const unsigned int l,
+           const number *     a,
+           const number *     b,
+           number *           c,
+           const bool         adding)
+      {
+        FullMatrixKernels::gemm<transpose_a>(
+          m, n, l, a, transpose_a ? m : l, b, n, c, n, adding);
+      }
+
+      // C = A B^T with A of size m x l and B of size n x l
+      static void
+      gemm_transpose_b(const unsigned int m,
+                       const unsigned int n,
+                       const unsigned int l,
+                       const number *     a,
+                       const number *     b,
+                       number *           c,
+                       const bool         adding)
+      {
+        FullMatrixKernels::gemm_transpose_b(m, n, l, a, l, b, l, c, n, adding);
+      }
+
+      static void
+      gemv(const unsigned int m,
+           const unsigned int n,
+           const number *     a,
+           const number *     x,
+           number *           y,
+           const bool         adding)
+      {
+        FullMatrixKernels::gemv(m, n, a, n, x, y, adding);
+      }
+
+      static void
+      gemv_transpose(const unsigned int m,
+                     const unsigned int n,
+                     const number *     a,
+                     const number *     x,
+                     number *           y,
+                     const bool         adding)
+      {
+        FullMatrixKernels::gemv_transpose(m, n, a, n, x, y, adding);
+      }
+    };
+
+
+
+    // whether a matrix-matrix product with the given dimensions should go to
+    // the kernels in FullMatrixKernels rather than to BLAS gemm. without
+    // BLAS, the kernels are always faster than the plain loops
+    inline bool
+    use_small_kernels(const types::global_dof_index m,
+                      const types::global_dof_index n,
+                      const types::global_dof_index l)
+    {
+      if (m * n * l == 0)
+        return false;
+#ifdef DEAL_II_WITH_LAPACK
+      return m * n * l <= FullMatrixKernels::max_product_size_below_blas;
+#else
+      return true;
+#endif
+    }
+
+
+
+    // whether a matrix-vector product with an m x n matrix should go to the
+    // kernels in FullMatrixKernels. there is no BLAS path for vmult(), but the
+    // kernels sum in another order than the plain loops, so we use them only
+    // up to the same product size as mmult() does with BLAS and leave the
+    // results of larger products unchanged
+    inline bool
+    use_small_gemv_kernels(const types::global_dof_index m,
+                           const types::global_dof_index n)
+    {
+      return (m * n != 0 &&
+              m * n <= FullMatrixKernels::max_product_size_below_blas);
+    }
+  } // namespace FullMatrixImplementation
+} // namespace internal
+
+
+
 template <typename number>
 FullMatrix<number>::FullMatrix(const size_type n)
   : Table<2, number>(n, n)
@@ -183,6 +344,16 @@ FullMatrix<number>::vmult(Vector<number2> &      dst,
 
   Assert(&src != &dst, ExcSourceEqualsDestination());
 
+  using Kernels =
+    internal::FullMatrixImplementation::SmallKernels<number, number2>;
+  if (Kernels::applies &&
+      internal::FullMatrixImplementation::use_small_gemv_kernels(m(), n()))
+    {
+      Kernels::gemv(
+        m(), n(), this->values.data(), src.begin(), dst.begin(), adding);
+      return;
+    }
+
   const number *e = this->values.data();
   // get access to the data in order to
   // avoid copying it when using the ()
@@ -214,6 +385,16 @@ FullMatrix<number>::Tvmult(Vector<number2> &      dst,
 
   Assert(&src != &dst, ExcSourceEqualsDestination());
 
+  using Kernels =
+    internal::FullMatrixImplementation::SmallKernels<number, number2>;
+  if (Kernels::applies &&
+      internal::FullMatrixImplementation::use_small_gemv_kernels(m(), n()))
+    {
+      Kernels::gemv_transpose(
+        m(), n(), this->values.data(), src.begin(), dst.begin(), adding);
+      return;
+    }
+
   const number *  e       = this->values.data();
   number2 *       dst_ptr = &dst(0);
   const size_type size_m = m(), size_n = n();
@@ -525,6 +706,20 @@ FullMatrix<number>::mmult(FullMatrix<number2> &      dst,
   Assert(dst.n() == src.n(), ExcDimensionMismatch(dst.n(), src.n()));
   Assert(dst.m() == m(), ExcDimensionMismatch(m(), dst.m()));
 
+  // small products go to the register-blocked kernels, for which BLAS
+  // would spend more time in its calling overhead than in the product
+  using Kernels =
+    internal::FullMatrixImplementation::SmallKernels<number, number2>;
+  if (Kernels::applies &&
+      internal::FullMatrixImplementation::use_small_kernels(m(),
+                                                            src.n(),
+                                                            n()))
+    {
+      Kernels::template gemm<false>(
+        m(), src.n(), n(), this->values.data(), &src(0, 0), &dst(0, 0), adding);
+      return;
+    }
+
   // see if we can use BLAS algorithms for this and if the type for 'number'
   // works for us (it is usually not efficient to use BLAS for very small
   // matrices):
@@ -607,6 +802,19 @@ FullMatrix<number>::Tmmult(FullMatrix<number2> &      dst,
   Assert(n() == dst.m(), ExcDimensionMismatch(n(), dst.m()));
   Assert(src.n() == dst.n(), ExcDimensionMismatch(src.n(), dst.n()));
 
+  // small products go to the register-blocked kernels, for which BLAS
+  // would spend more time in its calling overhead than in the product
+  using Kernels =
+    internal::FullMatrixImplementation::SmallKernels<number, number2>;
+  if (Kernels::applies &&
+      internal::FullMatrixImplementation::use_small_kernels(n(),
+                                                            src.n(),
+                                                            m()))
+    {
+      Kernels::template gemm<true>(
+        n(), src.n(), m(), this->values.data(), &src(0, 0), &dst(0, 0), adding);
+      return;
+    }
 
   // see if we can use BLAS algorithms for this and if the type for 'number'
   // works for us (it is usually not efficient to use BLAS for very small
@@ -712,6 +920,20 @@ FullMatrix<number>::mTmult(FullMatrix<number2> &      dst,
   Assert(dst.n() == src.m(), ExcDimensionMismatch(dst.n(), src.m()));
   Assert(dst.m() == m(), ExcDimensionMismatch(m(), dst.m()));
 
+  // small products go to the register-blocked kernels, for which BLAS
+  // would spend more time in its calling overhead than in the product
+  using Kernels =
+    internal::FullMatrixImplementation::SmallKernels<number, number2>;
+  if (Kernels::applies &&
+      internal::FullMatrixImplementation::use_small_kernels(m(),
+                                                            src.m(),
+                                                            n()))
+    {
+      Kernels::gemm_transpose_b(
+        m(), src.m(), n(), this->values.data(), &src(0, 0), &dst(0, 0), adding);
+      return;
+    }
+
   // see if we can use BLAS algorithms for this and if the type for 'number'
   // works for us (it is usually not efficient to use BLAS for very small
   // matrices):
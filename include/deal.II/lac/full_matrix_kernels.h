@@ -0,0 +1,316 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_full_matrix_kernels_h
+#define dealii_full_matrix_kernels_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/vectorization.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  /**
+   * Kernels for products of small dense matrices stored row by row, as in
+   * FullMatrix. Products of the size of element matrices are too small for
+   * BLAS to pay off its calling overhead, but the plain triple loops spend
+   * most of their time waiting for loads. The kernels below keep a block of
+   * the result in registers while running over the inner dimension, and
+   * operate on VectorizedArray lanes along the rows of the matrices.
+   *
+   * All matrices are given by a pointer to their first element and the
+   * distance between the starts of two consecutive rows. If @p adding is
+   * true, the product is added to the previous content of the result,
+   * otherwise the result is overwritten.
+   */
+  namespace FullMatrixKernels
+  {
+    /**
+     * Matrix-matrix products for which the product of the three dimensions
+     * is at most this number are computed with the kernels below also when
+     * BLAS is available. Measured against OpenBLAS, the kernels are faster
+     * up to sizes of about 8x8, break even around there, and fall behind
+     * beyond it because they do not block for the caches.
+     */
+    static const unsigned int max_product_size_below_blas = 512;
+
+
+
+    /**
+     * Compute a block of @p n_rows rows and @p n_vectors times the
+     * VectorizedArray width columns of the product op(A) B, where op(A) is A
+     * or its transpose.
+     */
+    template <int n_rows, int n_vectors, bool transpose_a, typename Number>
+    inline void
+    gemm_block(const unsigned int inner_size,
+               const Number *     a,
+               const unsigned int lda,
+               const Number *     b,
+               const unsigned int ldb,
+               Number *           c,
+               const unsigned int ldc,
+               const bool         adding)
+    {
+      constexpr unsigned int width = VectorizedArray<Number>::n_array_elements;
+
+      VectorizedArray<Number> sums[n_rows][n_vectors];
+      for (int r = 0; r < n_rows; ++r)
+        for (int v = 0; v < n_vectors; ++v)
+          if (adding)
+            sums[r][v].load(c + r * ldc + v * width);
+          else
+            sums[r][v] = Number();
+
+      for (unsigned int k = 0; k < inner_size; ++k)
+        {
+          VectorizedArray<Number> b_k[n_vectors];
+          for (int v = 0; v < n_vectors; ++v)
+            b_k[v].load(b + k * ldb + v * width);
+          for (int r = 0; r < n_rows; ++r)
+            {
+              const Number a_rk = transpose_a ? a[k * lda + r] : a[r * lda + k];
+              for (int v = 0; v < n_vectors; ++v)
+                sums[r][v] += a_rk * b_k[v];
+            }
+        }
+
+      for (int r = 0; r < n_rows; ++r)
+        for (int v = 0; v < n_vectors; ++v)
+          sums[r][v].store(c + r * ldc + v * width);
+    }
+
+
+
+    /**
+     * Compute the rows of the product op(A) B for the columns that are
+     * multiples of @p n_vectors times the VectorizedArray width, starting at
+     * column @p begin_col. Return the first column not computed.
+     */
+    template <int n_vectors, bool transpose_a, typename Number>
+    inline unsigned int
+    gemm_columns(const unsigned int m,
+                 const unsigned int n,
+                 const unsigned int inner_size,
+                 const Number *     a,
+                 const unsigned int lda,
+                 const Number *     b,
+                 const unsigned int ldb,
+                 Number *           c,
+                 const unsigned int ldc,
+                 const bool         adding,
+                 const unsigned int begin_col)
+    {
+      constexpr unsigned int block_size =
+        n_vectors * VectorizedArray<Number>::n_array_elements;
+      // four rows at a time, so that every column block of B loaded from
+      // memory is used four times
+      constexpr int n_rows = 4;
+
+      unsigned int j = begin_col;
+      for (; j + block_size <= n; j += block_size)
+        {
+          unsigned int i = 0;
+          for (; i + n_rows <= m; i += n_rows)
+            gemm_block<n_rows, n_vectors, transpose_a>(
+              inner_size,
+              transpose_a ? a + i : a + i * lda,
+              lda,
+              b + j,
+              ldb,
+              c + i * ldc + j,
+              ldc,
+              adding);
+          for (; i < m; ++i)
+            gemm_block<1, n_vectors, transpose_a>(inner_size,
+                                                  transpose_a ? a + i :
+                                                                a + i * lda,
+                                                  lda,
+                                                  b + j,
+                                                  ldb,
+                                                  c + i * ldc + j,
+                                                  ldc,
+                                                  adding);
+        }
+      return j;
+    }
+
+
+
+    /**
+     * Compute the m-by-n matrix C = op(A) B, where B has @p inner_size rows
+     * and op(A) is the m-by-@p inner_size matrix A or, if @p transpose_a is
+     * true, the transpose of the @p inner_size-by-m matrix A.
+     */
+    template <bool transpose_a, typename Number>
+    void
+    gemm(const unsigned int m,
+         const unsigned int n,
+         const unsigned int inner_size,
+         const Number *     a,
+         const unsigned int lda,
+         const Number *     b,
+         const unsigned int ldb,
+         Number *           c,
+         const unsigned int ldc,
+         const bool         adding)
+    {
+      // wide column blocks first, then a single vector, then the columns
+      // left over that do not fill a VectorizedArray
+      unsigned int j = gemm_columns<2, transpose_a>(
+        m, n, inner_size, a, lda, b, ldb, c, ldc, adding, 0);
+      j = gemm_columns<1, transpose_a>(
+        m, n, inner_size, a, lda, b, ldb, c, ldc, adding, j);
+
+      for (unsigned int i = 0; i < m; ++i)
+        for (unsigned int jj = j; jj < n; ++jj)
+          {
+            Number sum = adding ? c[i * ldc + jj] : Number();
+            for (unsigned int k = 0; k < inner_size; ++k)
+              sum += (transpose_a ? a[k * lda + i] : a[i * lda + k]) *
+                     b[k * ldb + jj];
+            c[i * ldc + jj] = sum;
+          }
+    }
+
+
+
+    /**
+     * Compute @p n_rows entries of the matrix-vector product A x as scalar
+     * products between rows of A and x.
+     */
+    template <int n_rows, typename Number>
+    inline void
+    gemv_block(const unsigned int n,
+               const Number *     a,
+               const unsigned int lda,
+               const Number *     x,
+               Number *           y,
+               const bool         adding)
+    {
+      constexpr unsigned int width = VectorizedArray<Number>::n_array_elements;
+
+      VectorizedArray<Number> sums[n_rows];
+      for (int r = 0; r < n_rows; ++r)
+        sums[r] = Number();
+
+      unsigned int k = 0;
+      for (; k + width <= n; k += width)
+        {
+          VectorizedArray<Number> x_k;
+          x_k.load(x + k);
+          for (int r = 0; r < n_rows; ++r)
+            {
+              VectorizedArray<Number> a_k;
+              a_k.load(a + r * lda + k);
+              sums[r] += a_k * x_k;
+            }
+        }
+
+      for (int r = 0; r < n_rows; ++r)
+        {
+          Number sum = adding ? y[r] : Number();
+          for (unsigned int v = 0; v < width; ++v)
+            sum += sums[r][v];
+          for (unsigned int kk = k; kk < n; ++kk)
+            sum += a[r * lda + kk] * x[kk];
+          y[r] = sum;
+        }
+    }
+
+
+
+    /**
+     * Compute y = A x for the m-by-n matrix A.
+     */
+    template <typename Number>
+    void
+    gemv(const unsigned int m,
+         const unsigned int n,
+         const Number *     a,
+         const unsigned int lda,
+         const Number *     x,
+         Number *           y,
+         const bool         adding)
+    {
+      unsigned int i = 0;
+      for (; i + 4 <= m; i += 4)
+        gemv_block<4>(n, a + i * lda, lda, x, y + i, adding);
+      for (; i < m; ++i)
+        gemv_block<1>(n, a + i * lda, lda, x, y + i, adding);
+    }
+
+
+
+    /**
+     * Compute y = A^T x for the m-by-n matrix A. This is the product of the
+     * row vector x^T with A, for which the kernel gemm() runs along the rows
+     * of A.
+     */
+    template <typename Number>
+    void
+    gemv_transpose(const unsigned int m,
+                   const unsigned int n,
+                   const Number *     a,
+                   const unsigned int lda,
+                   const Number *     x,
+                   Number *           y,
+                   const bool         adding)
+    {
+      gemm<false>(1, n, m, x, m, a, lda, y, n, adding);
+    }
+
+
+
+    /**
+     * Compute the m-by-n matrix C = A B^T, where A is m-by-@p inner_size and
+     * B is n-by-@p inner_size.
+     *
+     * Scalar products between rows of A and B would end every entry with a
+     * sum over the lanes of a VectorizedArray, which is as expensive as the
+     * products themselves for small sizes. Instead, B is transposed into a
+     * temporary array, after which gemm() can work along its rows.
+     */
+    template <typename Number>
+    void
+    gemm_transpose_b(const unsigned int m,
+                     const unsigned int n,
+                     const unsigned int inner_size,
+                     const Number *     a,
+                     const unsigned int lda,
+                     const Number *     b,
+                     const unsigned int ldb,
+                     Number *           c,
+                     const unsigned int ldc,
+                     const bool         adding)
+    {
+      std::vector<Number> b_transpose(inner_size * n);
+      for (unsigned int j = 0; j < n; ++j)
+        for (unsigned int k = 0; k < inner_size; ++k)
+          b_transpose[k * n + j] = b[j * ldb + k];
+      gemm<false>(
+        m, n, inner_size, a, lda, b_transpose.data(), n, c, ldc, adding);
+    }
+  } // namespace FullMatrixKernels
+} // namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -31,6 +31,7 @@
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/diagonal_matrix.h>
 #include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/triangular_level_schedule.h>
 #include <deal.II/lac/vector_memory.h>
 
 DEAL_II_NAMESPACE_OPEN
@@ -728,6 +729,13 @@ private:
    * the diagonal is located.
    */
   std::vector<std::size_t> pos_right_of_diagonal;
+
+  /**
+   * Level schedule of the forward and backward sweeps, set up in
+   * initialize() in case the matrix is a SparseMatrix. With it, the sweeps
+   * are run in parallel over the rows of each level.
+   */
+  TriangularLevelSchedule level_schedule;
 };
 
 
@@ -1562,6 +1570,49 @@ PreconditionSOR<MatrixType>::Tstep(VectorType &dst, const VectorType &src) const
 
 //---------------------------------------------------------------------------
 
+namespace internal
+{
+  namespace PreconditionSSORImplementation
+  {
+    /**
+     * Apply the SSOR preconditioner of a general matrix type, which does not
+     * know about level schedules.
+     */
+    template <typename MatrixType, typename VectorType>
+    void
+    precondition_SSOR(const MatrixType &              A,
+                      VectorType &                    dst,
+                      const VectorType &              src,
+                      const double                    omega,
+                      const std::vector<std::size_t> &pos_right_of_diagonal,
+                      const TriangularLevelSchedule &)
+    {
+      A.precondition_SSOR(dst, src, omega, pos_right_of_diagonal);
+    }
+
+
+
+    /**
+     * Apply the SSOR preconditioner of a SparseMatrix along the level
+     * schedule of its sweeps.
+     */
+    template <typename number, typename somenumber>
+    void
+    precondition_SSOR(const SparseMatrix<number> &    A,
+                      Vector<somenumber> &            dst,
+                      const Vector<somenumber> &      src,
+                      const double                    omega,
+                      const std::vector<std::size_t> &pos_right_of_diagonal,
+                      const TriangularLevelSchedule & level_schedule)
+    {
+      A.precondition_SSOR(
+        dst, src, number(omega), pos_right_of_diagonal, level_schedule);
+    }
+  } // namespace PreconditionSSORImplementation
+} // namespace internal
+
+
+
 template <typename MatrixType>
 inline void
 PreconditionSSOR<MatrixType>::initialize(
@@ -1594,7 +1645,10 @@ PreconditionSSOR<MatrixType>::initialize(
               break;
           pos_right_of_diagonal[row] = it - mat->begin();
         }
+      level_schedule.initialize(mat->get_sparsity_pattern());
     }
+  else
+    level_schedule.clear();
 }
 
 
@@ -1610,7 +1664,13 @@ PreconditionSSOR<MatrixType>::vmult(VectorType &      dst,
     "PreconditionSSOR and VectorType must have the same size_type.");
 
   Assert(this->A != nullptr, ExcNotInitialized());
-  this->A->precondition_SSOR(dst, src, this->relaxation, pos_right_of_diagonal);
+  internal::PreconditionSSORImplementation::precondition_SSOR(
+    *this->A,
+    dst,
+    src,
+    this->relaxation,
+    pos_right_of_diagonal,
+    level_schedule);
 }
 
 
@@ -1627,7 +1687,13 @@ PreconditionSSOR<MatrixType>::Tvmult(VectorType &      dst,
     "PreconditionSSOR and VectorType must have the same size_type.");
 
   Assert(this->A != nullptr, ExcNotInitialized());
-  this->A->precondition_SSOR(dst, src, this->relaxation, pos_right_of_diagonal);
+  internal::PreconditionSSORImplementation::precondition_SSOR(
+    *this->A,
+    dst,
+    src,
+    this->relaxation,
+    pos_right_of_diagonal,
+    level_schedule);
 }
 
 
@@ -0,0 +1,300 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_precondition_mixed_precision_h
+#define dealii_precondition_mixed_precision_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <mutex>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Preconditioners
+ *@{
+ */
+
+/**
+ * A wrapper that applies a preconditioner in a lower precision than the
+ * one of the outer solver. On initialization, the given SparseMatrix (e.g.
+ * SparseMatrix<double>) is copied into a SparseMatrix<number> (by default
+ * SparseMatrix<float>) that shares the SparsityPattern of the original
+ * matrix, and the preconditioner of type @p PreconditionerType is set up
+ * with this copy. In vmult() and Tvmult(), the source vector is converted
+ * to Vector<number>, the preconditioner is applied, and the result is
+ * converted back.
+ *
+ * Since preconditioners like SparseILU or PreconditionSSOR are limited by
+ * the memory bandwidth, storing the matrix (and the ILU factors) in single
+ * precision makes their application almost twice as fast. The outer
+ * iterative solver keeps working in double precision, so the accuracy of
+ * the solution is not affected; only the quality of the preconditioner
+ * changes, which is usually negligible. A typical use is
+ * @code
+ * PreconditionMixedPrecision<SparseILU<float>> preconditioner;
+ * preconditioner.initialize(system_matrix);
+ *
+ * SolverControl            solver_control(1000, 1e-12);
+ * SolverCG<Vector<double>> solver(solver_control);
+ * solver.solve(system_matrix, solution, system_rhs, preconditioner);
+ * @endcode
+ * and in the same way with PreconditionSSOR<SparseMatrix<float>>,
+ * PreconditionJacobi<SparseMatrix<float>> or SparseMIC<float>, and with
+ * SolverGMRES or SolverFGMRES as outer solvers.
+ *
+ * The preconditioner needs to provide a function
+ * <tt>initialize(const SparseMatrix<number>&, const AdditionalData&)</tt> and
+ * vmult() (and Tvmult() if the transpose is used) for Vector<number>.
+ * SparseDirectUMFPACK does not fit in here: UMFPACK only works with double
+ * precision and converts the matrix on factorization anyway.
+ *
+ * Since the matrix copy refers to the SparsityPattern of the matrix passed
+ * to initialize(), that sparsity pattern must live at least as long as this
+ * object.
+ */
+template <typename PreconditionerType, typename number = float>
+class PreconditionMixedPrecision : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Parameters of the wrapped preconditioner.
+   */
+  using AdditionalData = typename PreconditionerType::AdditionalData;
+
+  /**
+   * Copy the entries of @p matrix into the low-precision matrix and
+   * initialize the preconditioner with it. The storage of the low-precision
+   * matrix is reused as long as it is large enough, so this function can
+   * also be called to update the preconditioner after the values or the
+   * sparsity pattern of the matrix have changed.
+   */
+  template <typename number2>
+  void
+  initialize(const SparseMatrix<number2> &matrix,
+             const AdditionalData &       additional_data = AdditionalData());
+
+  /**
+   * Release the low-precision matrix and the temporary vectors, and clear
+   * the wrapped preconditioner.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the preconditioner in precision @p number to @p src and store the
+   * result in @p dst.
+   */
+  template <typename number2>
+  void
+  vmult(Vector<number2> &dst, const Vector<number2> &src) const;
+
+  /**
+   * Apply the transpose of the preconditioner in precision @p number.
+   */
+  template <typename number2>
+  void
+  Tvmult(Vector<number2> &dst, const Vector<number2> &src) const;
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the low-precision copy of the matrix.
+   */
+  const SparseMatrix<number> &
+  get_matrix() const;
+
+  /**
+   * Return the wrapped preconditioner.
+   */
+  const PreconditionerType &
+  get_preconditioner() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of the
+   * low-precision matrix and the temporary vectors. The memory of the
+   * wrapped preconditioner is not included.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The copy of the matrix in precision @p number.
+   */
+  SparseMatrix<number> matrix;
+
+  /**
+   * The wrapped preconditioner, set up with #matrix.
+   */
+  PreconditionerType preconditioner;
+
+  /**
+   * Temporary vectors in precision @p number for the source and destination
+   * of the preconditioner.
+   */
+  mutable Vector<number> src_low, dst_low;
+
+  /**
+   * Mutex guarding the temporary vectors in case vmult() is called from
+   * several threads at once.
+   */
+  mutable Threads::Mutex mutex;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename PreconditionerType, typename number>
+template <typename number2>
+inline void
+PreconditionMixedPrecision<PreconditionerType, number>::initialize(
+  const SparseMatrix<number2> &original_matrix,
+  const AdditionalData &       additional_data)
+{
+  // the sparsity pattern may have been reinitialized in place since the last
+  // call, so always reinit the matrix. this only allocates memory if the
+  // number of entries has grown
+  matrix.reinit(original_matrix.get_sparsity_pattern());
+  matrix.copy_from(original_matrix);
+
+  src_low.reinit(matrix.n(), true);
+  dst_low.reinit(matrix.m(), true);
+
+  preconditioner.initialize(matrix, additional_data);
+}
+
+
+
+template <typename PreconditionerType, typename number>
+inline void
+PreconditionMixedPrecision<PreconditionerType, number>::clear()
+{
+  preconditioner.clear();
+  matrix.clear();
+  src_low.reinit(0);
+  dst_low.reinit(0);
+}
+
+
+
+template <typename PreconditionerType, typename number>
+template <typename number2>
+inline void
+PreconditionMixedPrecision<PreconditionerType, number>::vmult(
+  Vector<number2> &      dst,
+  const Vector<number2> &src) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  src_low = src;
+  preconditioner.vmult(dst_low, src_low);
+  dst = dst_low;
+}
+
+
+
+template <typename PreconditionerType, typename number>
+template <typename number2>
+inline void
+PreconditionMixedPrecision<PreconditionerType, number>::Tvmult(
+  Vector<number2> &      dst,
+  const Vector<number2> &src) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  dst_low = src;
+  preconditioner.Tvmult(src_low, dst_low);
+  dst = src_low;
+}
+
+
+
+template <typename PreconditionerType, typename number>
+inline typename PreconditionMixedPrecision<PreconditionerType,
+                                           number>::size_type
+PreconditionMixedPrecision<PreconditionerType, number>::m() const
+{
+  return matrix.m();
+}
+
+
+
+template <typename PreconditionerType, typename number>
+inline typename PreconditionMixedPrecision<PreconditionerType,
+                                           number>::size_type
+PreconditionMixedPrecision<PreconditionerType, number>::n() const
+{
+  return matrix.n();
+}
+
+
+
+template <typename PreconditionerType, typename number>
+inline const SparseMatrix<number> &
+PreconditionMixedPrecision<PreconditionerType, number>::get_matrix() const
+{
+  return matrix;
+}
+
+
+
+template <typename PreconditionerType, typename number>
+inline const PreconditionerType &
+PreconditionMixedPrecision<PreconditionerType, number>::get_preconditioner()
+  const
+{
+  return preconditioner;
+}
+
+
+
+template <typename PreconditionerType, typename number>
+inline std::size_t
+PreconditionMixedPrecision<PreconditionerType, number>::memory_consumption()
+  const
+{
+  return sizeof(*this) + matrix.memory_consumption() +
+         src_low.memory_consumption() + dst_low.memory_consumption();
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,739 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sliced_ellpack_matrix_h
+#define dealii_sliced_ellpack_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/template_constraints.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Matrix1
+ *@{
+ */
+
+/**
+ * A sparse matrix in the sliced ELLPACK format with row sorting, often
+ * called SELL-C-$\sigma$. It stores the same entries as a SparseMatrix but
+ * arranges them such that the matrix-vector product can be computed with
+ * SIMD instructions.
+ *
+ * The rows of the matrix are grouped into slices of $C$ consecutive rows,
+ * where $C$ is the number of lanes of VectorizedArray<Number>. Inside a slice,
+ * all rows are padded to the length of the longest row of the slice, and
+ * the $k$-th entries of the $C$ rows are stored next to each other. A
+ * matrix-vector product then processes one slice at a time with one vector
+ * register holding the $C$ row sums, loading the matrix entries with
+ * aligned loads and the source vector entries with gather instructions.
+ *
+ * In order to limit the amount of padding, rows can be sorted by their
+ * length within windows of $\sigma$ consecutive rows before being assigned
+ * to slices. $\sigma=1$ keeps the original row order; larger values reduce
+ * the padding for meshes with varying row lengths (e.g., at boundaries or
+ * hanging nodes). The sorting is internal to this class: vectors are always
+ * indexed in the original numbering. For FE_Q discretizations with eight
+ * lanes, $\sigma=1$ stores up to twice as many entries as there are nonzero
+ * entries, whereas $\sigma=64$ limits the padding to 20 percent; only
+ * with the latter is the matrix-vector product consistently faster than the
+ * one of SparseMatrix.
+ *
+ * The matrix is set up from a SparsityPattern (with all entries zero) or
+ * directly from a SparseMatrix, and the values of a SparseMatrix with the
+ * same sparsity pattern can be copied in later on with copy_from() without
+ * rebuilding the structure. The class provides the interface expected by
+ * the iterative solvers, LinearOperator and PreconditionChebyshev, i.e.,
+ * vmult(), Tvmult(), their adding variants, residual(), m(), n() and access
+ * to the diagonal through diag_element() and el().
+ *
+ * The source vector of a product is read with gather instructions if its
+ * begin() function returns a pointer to contiguous entries of type Number,
+ * as is the case for Vector<Number> and the serial
+ * LinearAlgebra::distributed::Vector<Number>. Other vectors, e.g., with a
+ * different value type or block vectors, are read entry by entry through
+ * their <tt>operator()</tt>.
+ *
+ * vmult() and vmult_add() run in parallel over the slices. The transposed
+ * products Tvmult() and Tvmult_add() scatter the entries of each slice into
+ * the destination vector and are therefore sequential; for symmetric
+ * matrices, vmult() gives the same result.
+ */
+template <typename Number>
+class SlicedEllpackMatrix : public Subscriptor
+{
+public:
+  /**
+   * Declare the type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = Number;
+
+  /**
+   * Number of rows per slice, i.e., the width of the vector registers used
+   * in the matrix-vector product.
+   */
+  static const unsigned int slice_size =
+    VectorizedArray<Number>::n_array_elements;
+
+  /**
+   * Constructor. The object needs to be initialized with reinit() before
+   * it can be used.
+   */
+  SlicedEllpackMatrix();
+
+  /**
+   * Constructor setting up the matrix from the given SparseMatrix, see
+   * reinit().
+   */
+  template <typename number2>
+  explicit SlicedEllpackMatrix(const SparseMatrix<number2> &matrix,
+                               const unsigned int           sigma = 1);
+
+  /**
+   * Set up the storage for the structure of @p sparsity and set all entries
+   * to zero. Rows are sorted by length within windows of @p sigma rows
+   * before being grouped into slices. The sparsity pattern is not
+   * referenced after this call.
+   */
+  void
+  reinit(const SparsityPattern &sparsity, const unsigned int sigma = 1);
+
+  /**
+   * Set up the storage for the sparsity pattern of @p matrix and copy its
+   * entries.
+   */
+  template <typename number2>
+  void
+  reinit(const SparseMatrix<number2> &matrix, const unsigned int sigma = 1);
+
+  /**
+   * Copy the entries of @p matrix, which must have the same sparsity pattern
+   * as the one this object was set up with.
+   */
+  template <typename number2>
+  void
+  copy_from(const SparseMatrix<number2> &matrix);
+
+  /**
+   * Release all memory and return to the state after the default
+   * constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return the number of rows of this matrix.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the number of columns of this matrix.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of nonzero entries of the sparsity pattern this
+   * matrix was set up from.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of stored entries including the padding of the
+   * slices. The ratio to n_nonzero_elements() is the storage and work
+   * overhead of this format compared to SparseMatrix.
+   */
+  std::size_t
+  n_stored_elements() const;
+
+  /**
+   * Return the entry (<i>i,j</i>), or zero if it is not part of the sparsity
+   * pattern. This function searches the sorting window and the row of
+   * <i>i</i> and is therefore slower than the corresponding SparseMatrix
+   * function.
+   */
+  Number
+  el(const size_type i, const size_type j) const;
+
+  /**
+   * Return the diagonal entry of row <i>i</i>. The matrix needs to be
+   * square.
+   */
+  Number
+  diag_element(const size_type i) const;
+
+  /**
+   * Matrix-vector multiplication <i>dst = M*src</i>.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding matrix-vector multiplication <i>dst += M*src</i>.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Transpose matrix-vector multiplication <i>dst =
+   * M<sup>T</sup>*src</i>. Since the entries of a slice are scattered into
+   * the destination, this operation is sequential. Use vmult() for
+   * symmetric matrices.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding transpose matrix-vector multiplication <i>dst +=
+   * M<sup>T</sup>*src</i>. Like Tvmult(), this operation is sequential.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Compute the residual <i>dst = b - M*x</i> and return its $l_2$ norm, like
+   * SparseMatrix::residual().
+   */
+  template <typename VectorType>
+  Number
+  residual(VectorType &dst, const VectorType &x, const VectorType &b) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcDifferentSparsityPattern,
+                   "The given matrix does not have the sparsity pattern this "
+                   "object was set up with.");
+
+private:
+  /**
+   * Compute <i>dst = M*src</i> (or <i>dst += M*src</i> if @p add is set) for
+   * the slices in the range [@p begin_slice, @p end_slice).
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_on_subrange(const unsigned int begin_slice,
+                    const unsigned int end_slice,
+                    OutVector &        dst,
+                    const InVector &   src,
+                    const bool         add) const;
+
+  /**
+   * Number of rows.
+   */
+  size_type n_rows;
+
+  /**
+   * Number of columns.
+   */
+  size_type n_cols;
+
+  /**
+   * Number of nonzero entries of the original sparsity pattern.
+   */
+  std::size_t n_nonzero;
+
+  /**
+   * Size of the windows within which rows are sorted by length.
+   */
+  unsigned int sigma;
+
+  /**
+   * Original row index of each slot of the slices, i.e., the row stored in
+   * lane <i>l</i> of slice <i>s</i> is <tt>rows[s*slice_size+l]</tt>. Slots
+   * past the last row of the matrix contain numbers::invalid_dof_index.
+   */
+  std::vector<size_type> rows;
+
+  /**
+   * Position of the first entry of each slice within #values, plus one
+   * past the end. The width of slice <i>s</i> is
+   * <tt>slice_start[s+1]-slice_start[s]</tt>.
+   */
+  std::vector<std::size_t> slice_start;
+
+  /**
+   * The matrix entries: entry <i>k</i> of all rows of slice <i>s</i> is
+   * stored in <tt>values[slice_start[s]+k]</tt>, one row per lane. Padding
+   * entries are zero.
+   */
+  AlignedVector<VectorizedArray<Number>> values;
+
+  /**
+   * Column indices matching #values, <tt>slice_size</tt> per entry of
+   * #values. Padding entries repeat a valid column index of the same row
+   * (or zero for empty rows) so that gathering from them is safe.
+   */
+  std::vector<unsigned int> columns;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename Number>
+const unsigned int SlicedEllpackMatrix<Number>::slice_size;
+
+
+
+template <typename Number>
+inline SlicedEllpackMatrix<Number>::SlicedEllpackMatrix()
+  : n_rows(0)
+  , n_cols(0)
+  , n_nonzero(0)
+  , sigma(1)
+{}
+
+
+
+template <typename Number>
+template <typename number2>
+inline SlicedEllpackMatrix<Number>::SlicedEllpackMatrix(
+  const SparseMatrix<number2> &matrix,
+  const unsigned int           sigma)
+  : SlicedEllpackMatrix()
+{
+  reinit(matrix, sigma);
+}
+
+
+
+template <typename Number>
+inline void
+SlicedEllpackMatrix<Number>::reinit(const SparsityPattern &sparsity,
+                                    const unsigned int     window)
+{
+  Assert(window > 0, ExcMessage("The sorting window must not be empty."));
+  Assert(sparsity.is_compressed(), SparsityPattern::ExcNotCompressed());
+  AssertThrow(sparsity.n_cols() <
+                static_cast<size_type>(numbers::invalid_unsigned_int),
+              ExcMessage("SlicedEllpackMatrix stores column indices as "
+                         "unsigned int."));
+
+  n_rows    = sparsity.n_rows();
+  n_cols    = sparsity.n_cols();
+  n_nonzero = sparsity.n_nonzero_elements();
+  sigma     = window;
+
+  // sort rows by decreasing length within each window of sigma rows; the
+  // stable sort keeps the original order of rows of equal length
+  const unsigned int n_slices = (n_rows + slice_size - 1) / slice_size;
+  rows.resize(static_cast<std::size_t>(n_slices) * slice_size);
+  std::iota(rows.begin(), rows.begin() + n_rows, size_type(0));
+  std::fill(rows.begin() + n_rows, rows.end(), numbers::invalid_dof_index);
+  for (size_type begin = 0; begin < n_rows; begin += sigma)
+    std::stable_sort(rows.begin() + begin,
+                     rows.begin() + std::min<size_type>(begin + sigma, n_rows),
+                     [&sparsity](const size_type a, const size_type b) {
+                       return sparsity.row_length(a) > sparsity.row_length(b);
+                     });
+
+  slice_start.resize(n_slices + 1);
+  slice_start[0] = 0;
+  for (unsigned int s = 0; s < n_slices; ++s)
+    {
+      unsigned int width = 0;
+      for (unsigned int l = 0; l < slice_size; ++l)
+        if (rows[s * slice_size + l] != numbers::invalid_dof_index)
+          width = std::max(width, sparsity.row_length(rows[s * slice_size + l]));
+      slice_start[s + 1] = slice_start[s] + width;
+    }
+
+  values.resize_fast(slice_start[n_slices]);
+  columns.resize(slice_start[n_slices] * slice_size);
+  for (unsigned int s = 0; s < n_slices; ++s)
+    for (unsigned int l = 0; l < slice_size; ++l)
+      {
+        const size_type row = rows[s * slice_size + l];
+        const unsigned int length =
+          (row != numbers::invalid_dof_index) ? sparsity.row_length(row) : 0;
+        unsigned int last_column = 0;
+        for (std::size_t k = slice_start[s]; k < slice_start[s + 1]; ++k)
+          {
+            values[k][l] = Number();
+            if (k - slice_start[s] < length)
+              last_column = sparsity.column_number(row, k - slice_start[s]);
+            columns[k * slice_size + l] = last_column;
+          }
+      }
+}
+
+
+
+template <typename Number>
+template <typename number2>
+inline void
+SlicedEllpackMatrix<Number>::reinit(const SparseMatrix<number2> &matrix,
+                                    const unsigned int           sigma)
+{
+  reinit(matrix.get_sparsity_pattern(), sigma);
+  copy_from(matrix);
+}
+
+
+
+template <typename Number>
+template <typename number2>
+inline void
+SlicedEllpackMatrix<Number>::copy_from(const SparseMatrix<number2> &matrix)
+{
+  AssertDimension(matrix.m(), m());
+  AssertDimension(matrix.n(), n());
+  Assert(matrix.n_nonzero_elements() == n_nonzero,
+         ExcDifferentSparsityPattern());
+
+  const unsigned int n_slices = slice_start.size() - 1;
+  for (unsigned int s = 0; s < n_slices; ++s)
+    for (unsigned int l = 0; l < slice_size; ++l)
+      {
+        const size_type row = rows[s * slice_size + l];
+        if (row == numbers::invalid_dof_index)
+          continue;
+        std::size_t k = slice_start[s];
+        for (auto entry = matrix.begin(row); entry != matrix.end(row);
+             ++entry, ++k)
+          {
+            Assert(columns[k * slice_size + l] == entry->column(),
+                   ExcDifferentSparsityPattern());
+            values[k][l] = entry->value();
+          }
+      }
+}
+
+
+
+template <typename Number>
+inline void
+SlicedEllpackMatrix<Number>::clear()
+{
+  n_rows    = 0;
+  n_cols    = 0;
+  n_nonzero = 0;
+  sigma     = 1;
+  rows.clear();
+  slice_start.clear();
+  values.clear();
+  columns.clear();
+}
+
+
+
+template <typename Number>
+inline typename SlicedEllpackMatrix<Number>::size_type
+SlicedEllpackMatrix<Number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename Number>
+inline typename SlicedEllpackMatrix<Number>::size_type
+SlicedEllpackMatrix<Number>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename Number>
+inline std::size_t
+SlicedEllpackMatrix<Number>::n_nonzero_elements() const
+{
+  return n_nonzero;
+}
+
+
+
+template <typename Number>
+inline std::size_t
+SlicedEllpackMatrix<Number>::n_stored_elements() const
+{
+  return values.size() * slice_size;
+}
+
+
+
+template <typename Number>
+inline Number
+SlicedEllpackMatrix<Number>::el(const size_type i, const size_type j) const
+{
+  AssertIndexRange(i, m());
+  AssertIndexRange(j, n());
+
+  // find the slot of row i, which is inside the sorting window of i; the
+  // padding of a row repeats one of its column indices with a zero value, so
+  // summing over all matches is safe
+  const size_type   window_start = i - i % sigma;
+  const std::size_t slot =
+    std::find(rows.begin() + window_start,
+              rows.begin() + std::min<size_type>(window_start + sigma, m()),
+              i) -
+    rows.begin();
+  const unsigned int s = slot / slice_size;
+  const unsigned int l = slot % slice_size;
+
+  Number value = Number();
+  for (std::size_t k = slice_start[s]; k < slice_start[s + 1]; ++k)
+    if (columns[k * slice_size + l] == j)
+      value += values[k][l];
+  return value;
+}
+
+
+
+template <typename Number>
+inline Number
+SlicedEllpackMatrix<Number>::diag_element(const size_type i) const
+{
+  Assert(m() == n(), ExcNotQuadratic());
+  return el(i, i);
+}
+
+
+
+namespace internal
+{
+  namespace SlicedEllpackMatrixImplementation
+  {
+    /**
+     * Load the entries of @p src at the @p columns of one slice into @p x,
+     * with a gather instruction for vectors whose entries are a contiguous
+     * array of type Number.
+     */
+    template <typename Number, class InVector>
+    inline void
+    gather(VectorizedArray<Number> &x,
+           const InVector &         src,
+           const unsigned int *     columns,
+           std::true_type)
+    {
+      x.gather(src.begin(), columns);
+    }
+
+
+
+    /**
+     * Same as above for all other vectors, which are read entry by entry.
+     */
+    template <typename Number, class InVector>
+    inline void
+    gather(VectorizedArray<Number> &x,
+           const InVector &         src,
+           const unsigned int *     columns,
+           std::false_type)
+    {
+      for (unsigned int l = 0; l < VectorizedArray<Number>::n_array_elements;
+           ++l)
+        x[l] = src(columns[l]);
+    }
+  } // namespace SlicedEllpackMatrixImplementation
+} // namespace internal
+
+
+
+template <typename Number>
+template <class OutVector, class InVector>
+inline void
+SlicedEllpackMatrix<Number>::vmult_on_subrange(const unsigned int begin_slice,
+                                               const unsigned int end_slice,
+                                               OutVector &        dst,
+                                               const InVector &   src,
+                                               const bool         add) const
+{
+  using contiguous_source = std::integral_constant<
+    bool,
+    std::is_same<decltype(std::declval<const InVector &>().begin()),
+                 const Number *>::value>;
+  for (unsigned int s = begin_slice; s < end_slice; ++s)
+    {
+      VectorizedArray<Number> sum = Number();
+      for (std::size_t k = slice_start[s]; k < slice_start[s + 1]; ++k)
+        {
+          VectorizedArray<Number> x;
+          internal::SlicedEllpackMatrixImplementation::gather(
+            x, src, &columns[k * slice_size], contiguous_source());
+          sum += values[k] * x;
+        }
+      for (unsigned int l = 0; l < slice_size; ++l)
+        {
+          const size_type row = rows[s * slice_size + l];
+          if (row == numbers::invalid_dof_index)
+            break;
+          if (add)
+            dst(row) += sum[l];
+          else
+            dst(row) = sum[l];
+        }
+    }
+}
+
+
+
+template <typename Number>
+template <class OutVector, class InVector>
+inline void
+SlicedEllpackMatrix<Number>::vmult(OutVector &dst, const InVector &src) const
+{
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+  Assert(!PointerComparison::equal(&src, &dst),
+         typename SparseMatrix<Number>::ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(slice_start.size() - 1),
+    [this, &src, &dst](const unsigned int begin_slice,
+                       const unsigned int end_slice) {
+      vmult_on_subrange(begin_slice, end_slice, dst, src, false);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+        slice_size +
+      1);
+}
+
+
+
+template <typename Number>
+template <class OutVector, class InVector>
+inline void
+SlicedEllpackMatrix<Number>::vmult_add(OutVector &dst, const InVector &src) const
+{
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+  Assert(!PointerComparison::equal(&src, &dst),
+         typename SparseMatrix<Number>::ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(slice_start.size() - 1),
+    [this, &src, &dst](const unsigned int begin_slice,
+                       const unsigned int end_slice) {
+      vmult_on_subrange(begin_slice, end_slice, dst, src, true);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+        slice_size +
+      1);
+}
+
+
+
+template <typename Number>
+template <class OutVector, class InVector>
+inline void
+SlicedEllpackMatrix<Number>::Tvmult(OutVector &dst, const InVector &src) const
+{
+  dst = 0;
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename Number>
+template <class OutVector, class InVector>
+inline void
+SlicedEllpackMatrix<Number>::Tvmult_add(OutVector &     dst,
+                                        const InVector &src) const
+{
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), m());
+  Assert(!PointerComparison::equal(&src, &dst),
+         typename SparseMatrix<Number>::ExcSourceEqualsDestination());
+
+  const unsigned int n_slices = slice_start.size() - 1;
+  for (unsigned int s = 0; s < n_slices; ++s)
+    for (unsigned int l = 0; l < slice_size; ++l)
+      {
+        const size_type row = rows[s * slice_size + l];
+        if (row == numbers::invalid_dof_index)
+          break;
+        const Number src_row = src(row);
+        for (std::size_t k = slice_start[s]; k < slice_start[s + 1]; ++k)
+          dst(columns[k * slice_size + l]) += values[k][l] * src_row;
+      }
+}
+
+
+
+template <typename Number>
+template <typename VectorType>
+inline Number
+SlicedEllpackMatrix<Number>::residual(VectorType &      dst,
+                                      const VectorType &x,
+                                      const VectorType &b) const
+{
+  vmult(dst, x);
+  dst.sadd(-1., 1., b);
+  return dst.l2_norm();
+}
+
+
+
+template <typename Number>
+inline std::size_t
+SlicedEllpackMatrix<Number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(rows) +
+         MemoryConsumption::memory_consumption(slice_start) +
+         values.memory_consumption() +
+         MemoryConsumption::memory_consumption(columns);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
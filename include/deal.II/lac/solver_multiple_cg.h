@@ -0,0 +1,436 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_multiple_cg_h
+#define dealii_solver_multiple_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class BlockVector;
+template <typename number>
+class SparseMatrix;
+template <typename number>
+class Vector;
+#endif
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+namespace internal
+{
+  namespace SolverMultipleCGImplementation
+  {
+    /**
+     * Multiply @p A with each of the vectors in @p src. The general version
+     * calls A.vmult() once for each vector.
+     */
+    template <typename MatrixType, typename VectorType>
+    void
+    vmult_multiple(const MatrixType &                      A,
+                   const std::vector<VectorType *> &       dst,
+                   const std::vector<const VectorType *> &src)
+    {
+      for (unsigned int c = 0; c < src.size(); ++c)
+        A.vmult(*dst[c], *src[c]);
+    }
+
+
+
+    /**
+     * Multiply a SparseMatrix with several vectors at once, reading the
+     * matrix only once for every few vectors.
+     */
+    template <typename number, typename number2>
+    void
+    vmult_multiple(const SparseMatrix<number> &                 A,
+                   const std::vector<Vector<number2> *> &       dst,
+                   const std::vector<const Vector<number2> *> &src)
+    {
+      A.vmult_multiple(dst, src);
+    }
+
+
+
+    /**
+     * Return the $l_2$ norm of the residual of a multi-vector whose blocks
+     * have the residual norms @p residuals.
+     */
+    inline double
+    total_residual(const std::vector<double> &residuals)
+    {
+      double sum = 0.;
+      for (const double r : residuals)
+        sum += r * r;
+      return std::sqrt(sum);
+    }
+
+
+
+    /**
+     * Return the residual norms below which the blocks with the initial
+     * residual norms @p initial_residuals are deflated: the tolerance of
+     * @p control or, for a ReductionControl, the larger of the tolerance and
+     * the reduction times the initial residual of the block, divided by the
+     * square root of the number of blocks.
+     */
+    inline std::vector<double>
+    deflation_tolerances(const SolverControl &      control,
+                         const std::vector<double> &initial_residuals)
+    {
+      const unsigned int      n_blocks = initial_residuals.size();
+      const ReductionControl *reduction_control =
+        dynamic_cast<const ReductionControl *>(&control);
+
+      std::vector<double> tolerances(n_blocks);
+      for (unsigned int c = 0; c < n_blocks; ++c)
+        {
+          double tolerance = control.tolerance();
+          if (reduction_control != nullptr)
+            tolerance =
+              std::max(tolerance,
+                       reduction_control->reduction() * initial_residuals[c]);
+          tolerances[c] = tolerance / std::sqrt(1. * n_blocks);
+        }
+      return tolerances;
+    }
+  } // namespace SolverMultipleCGImplementation
+} // namespace internal
+
+
+
+/**
+ * This class implements the preconditioned Conjugate Gradients method for
+ * several right-hand sides with the same matrix at once, as they appear for
+ * several load cases, for the tangent and load vector solves of arc-length
+ * methods, or for adjoint sensitivities. The right-hand sides and the
+ * solutions are stored as the blocks of a multi-vector, by default a
+ * BlockVector<double> with one block per right-hand side.
+ *
+ * The iteration for each block is the same as the one of SolverCG, so the
+ * iterates are the same as when solving for each right-hand side separately.
+ * However, the matrix-vector products of all blocks are done together in
+ * each iteration. For a SparseMatrix, this uses
+ * SparseMatrix::vmult_multiple(), which reads the matrix once for every four
+ * vectors instead of once for every vector. For other matrix types, vmult()
+ * is called for each block.
+ *
+ * <h3>Convergence and deflation</h3>
+ *
+ * The SolverControl object is given the $l_2$ norm of the residuals of all
+ * blocks together, i.e., the norm of the residual of the multi-vector, and
+ * decides when the iteration stops. Each block is also checked on its own
+ * with the criterion of the SolverControl object: once the norm of its
+ * residual is below $\tau/\sqrt{k}$, where $\tau$ is the tolerance of the
+ * SolverControl object and $k$ the number of blocks, the block is deflated,
+ * i.e., it is not updated any more and takes no part in the matrix-vector
+ * products and preconditioner applications. For a ReductionControl, $\tau$
+ * is the larger of its tolerance and its reduction times the initial
+ * residual of the block, so every block is reduced relative to its own
+ * right-hand side. Easy right-hand sides thus do not cost any work once they
+ * are solved. Once all blocks are deflated, the iteration stops even if the
+ * SolverControl object has not reported convergence yet, as happens for an
+ * IterationNumberControl, since there is nothing left to iterate on.
+ *
+ * A block Krylov method in the strict sense, which builds a joint Krylov
+ * space from all right-hand sides, may need fewer iterations, but needs
+ * small dense factorizations and a careful treatment of linearly dependent
+ * blocks, and is not implemented. For nonsymmetric matrices, see
+ * SolverMultipleGMRES.
+ */
+template <typename MultiVectorType = BlockVector<double>>
+class SolverMultipleCG : public SolverBase<MultiVectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   * Here, it doesn't store anything but just exists for consistency
+   * with the other solver classes.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverMultipleCG(SolverControl &                cn,
+                   VectorMemory<MultiVectorType> &mem,
+                   const AdditionalData &         data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverMultipleCG(SolverControl &       cn,
+                   const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverMultipleCG() override = default;
+
+  /**
+   * Solve the linear systems $Ax_i=b_i$ for all blocks $x_i$ of @p x and
+   * $b_i$ of @p b. @p A and @p preconditioner work on the blocks of the
+   * multi-vectors.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        MultiVectorType &         x,
+        const MultiVectorType &   b,
+        const PreconditionerType &preconditioner);
+
+  /**
+   * Return the number of blocks that had not been deflated when the last
+   * call to solve() ended.
+   */
+  unsigned int
+  n_active_blocks() const;
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The control object, whose tolerance and, for a ReductionControl,
+   * reduction determine when a block is deflated.
+   */
+  SmartPointer<const SolverControl, SolverMultipleCG<MultiVectorType>>
+    solver_control;
+
+  /**
+   * The blocks that have not been deflated yet.
+   */
+  std::vector<unsigned int> active_blocks;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename MultiVectorType>
+SolverMultipleCG<MultiVectorType>::SolverMultipleCG(
+  SolverControl &                cn,
+  VectorMemory<MultiVectorType> &mem,
+  const AdditionalData &         data)
+  : SolverBase<MultiVectorType>(cn, mem)
+  , additional_data(data)
+  , solver_control(&cn)
+{}
+
+
+
+template <typename MultiVectorType>
+SolverMultipleCG<MultiVectorType>::SolverMultipleCG(SolverControl &       cn,
+                                                    const AdditionalData &data)
+  : SolverBase<MultiVectorType>(cn)
+  , additional_data(data)
+  , solver_control(&cn)
+{}
+
+
+
+template <typename MultiVectorType>
+unsigned int
+SolverMultipleCG<MultiVectorType>::n_active_blocks() const
+{
+  return active_blocks.size();
+}
+
+
+
+template <typename MultiVectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverMultipleCG<MultiVectorType>::solve(
+  const MatrixType &        A,
+  MultiVectorType &         x,
+  const MultiVectorType &   b,
+  const PreconditionerType &preconditioner)
+{
+  using VectorType = typename MultiVectorType::BlockType;
+  using number     = typename MultiVectorType::value_type;
+
+  const unsigned int n_blocks = b.n_blocks();
+  AssertDimension(x.n_blocks(), n_blocks);
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("multiple cg");
+
+  // Memory allocation
+  typename VectorMemory<MultiVectorType>::Pointer g_pointer(this->memory);
+  typename VectorMemory<MultiVectorType>::Pointer d_pointer(this->memory);
+  typename VectorMemory<MultiVectorType>::Pointer h_pointer(this->memory);
+
+  // define some aliases for simpler access
+  MultiVectorType &g = *g_pointer;
+  MultiVectorType &d = *d_pointer;
+  MultiVectorType &h = *h_pointer;
+
+  // resize the vectors, but do not set the values since they'd be
+  // overwritten soon anyway.
+  g.reinit(x, true);
+  d.reinit(x, true);
+  h.reinit(x, true);
+
+  std::vector<number> gh(n_blocks);
+  std::vector<double> residuals(n_blocks);
+
+  // blocks whose residual is below their threshold are deflated. the
+  // thresholds are set once the initial residuals are known
+  std::vector<double> deflation_tolerances;
+
+  const auto deflate = [&]() {
+    unsigned int n_active = 0;
+    for (const unsigned int c : active_blocks)
+      if (residuals[c] > deflation_tolerances[c])
+        active_blocks[n_active++] = c;
+    active_blocks.resize(n_active);
+  };
+
+  std::vector<VectorType *>       dst_blocks;
+  std::vector<const VectorType *> src_blocks;
+
+  int it = 0;
+
+  // compute residuals. if a block is zero, then short-circuit the full
+  // computation
+  active_blocks.clear();
+  for (unsigned int c = 0; c < n_blocks; ++c)
+    {
+      if (!x.block(c).all_zero())
+        {
+          dst_blocks.push_back(&g.block(c));
+          src_blocks.push_back(&x.block(c));
+        }
+      active_blocks.push_back(c);
+    }
+  internal::SolverMultipleCGImplementation::vmult_multiple(A,
+                                                           dst_blocks,
+                                                           src_blocks);
+  for (unsigned int c = 0; c < n_blocks; ++c)
+    {
+      if (!x.block(c).all_zero())
+        g.block(c).add(-1., b.block(c));
+      else
+        g.block(c).equ(-1., b.block(c));
+      residuals[c] = g.block(c).l2_norm();
+    }
+
+  deflation_tolerances =
+    internal::SolverMultipleCGImplementation::deflation_tolerances(
+      *solver_control, residuals);
+
+  double res = internal::SolverMultipleCGImplementation::total_residual(
+    residuals);
+  conv       = this->iteration_status(0, res, x);
+  if (conv != SolverControl::iterate)
+    return;
+
+  deflate();
+  for (const unsigned int c : active_blocks)
+    {
+      preconditioner.vmult(h.block(c), g.block(c));
+      d.block(c).equ(-1., h.block(c));
+      gh[c] = g.block(c) * h.block(c);
+    }
+
+  // stop once all blocks are deflated, even if the control object does not
+  // consider the multi-vector converged yet
+  while (conv == SolverControl::iterate && !active_blocks.empty())
+    {
+      it++;
+
+      dst_blocks.clear();
+      src_blocks.clear();
+      for (const unsigned int c : active_blocks)
+        {
+          dst_blocks.push_back(&h.block(c));
+          src_blocks.push_back(&d.block(c));
+        }
+      internal::SolverMultipleCGImplementation::vmult_multiple(A,
+                                                               dst_blocks,
+                                                               src_blocks);
+
+      for (const unsigned int c : active_blocks)
+        {
+          number alpha = d.block(c) * h.block(c);
+          Assert(std::abs(alpha) != 0., ExcDivideByZero());
+          alpha = gh[c] / alpha;
+
+          x.block(c).add(alpha, d.block(c));
+          residuals[c] = std::sqrt(
+            std::abs(g.block(c).add_and_dot(alpha, h.block(c), g.block(c))));
+        }
+
+      res =
+        internal::SolverMultipleCGImplementation::total_residual(residuals);
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      deflate();
+      for (const unsigned int c : active_blocks)
+        {
+          preconditioner.vmult(h.block(c), g.block(c));
+
+          number beta = gh[c];
+          Assert(std::abs(beta) != 0., ExcDivideByZero());
+          gh[c] = g.block(c) * h.block(c);
+          beta  = gh[c] / beta;
+          d.block(c).sadd(beta, -1., h.block(c));
+        }
+    }
+  deflate();
+
+  // in case of failure: throw exception
+  if (conv == SolverControl::failure)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
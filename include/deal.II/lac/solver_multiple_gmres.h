@@ -0,0 +1,436 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_multiple_gmres_h
+#define dealii_solver_multiple_gmres_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/solver_multiple_cg.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the restarted GMRES method with left
+ * preconditioning for several right-hand sides with the same matrix at once.
+ * It is the counterpart of SolverMultipleCG for nonsymmetric matrices: the
+ * right-hand sides and the solutions are stored as the blocks of a
+ * multi-vector, by default a BlockVector<double> with one block per
+ * right-hand side, and the matrix-vector products of all blocks are done
+ * together in each iteration, using SparseMatrix::vmult_multiple() for a
+ * SparseMatrix.
+ *
+ * Each block builds its own Krylov space with the modified Gram-Schmidt
+ * method, so the iterates are the ones of SolverGMRES with left
+ * preconditioning, up to the orthogonalization, which SolverGMRES does with
+ * optional re-orthogonalization. The basis of each block holds
+ * AdditionalData::max_n_tmp_vectors-2 vectors before the iteration is
+ * restarted, i.e., the memory needed is that many multi-vectors.
+ *
+ * <h3>Convergence and deflation</h3>
+ *
+ * As for SolverGMRES with left preconditioning, the residuals are those of
+ * the preconditioned system. The SolverControl object is given the $l_2$
+ * norm of the residuals of all blocks together, and the blocks are deflated
+ * with the same criterion as in SolverMultipleCG: a block whose residual is
+ * below $\tau/\sqrt{k}$, where $\tau$ is the tolerance of the SolverControl
+ * object, or for a ReductionControl the larger of the tolerance and the
+ * reduction times the initial residual of the block, and $k$ the number of
+ * blocks, gets its solution updated and takes no part in the remaining
+ * iterations. Once all blocks are deflated, the iteration stops even if the
+ * SolverControl object has not reported convergence yet.
+ */
+template <typename MultiVectorType = BlockVector<double>>
+class SolverMultipleGMRES : public SolverBase<MultiVectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, set the number of temporary vectors to 30,
+     * i.e. do a restart every 28 iterations.
+     */
+    explicit AdditionalData(const unsigned int max_n_tmp_vectors = 30);
+
+    /**
+     * Maximum number of temporary multi-vectors. This parameter controls the
+     * size of the Arnoldi basis, which for historical reasons is
+     * #max_n_tmp_vectors-2, as in SolverGMRES.
+     */
+    unsigned int max_n_tmp_vectors;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverMultipleGMRES(SolverControl &                cn,
+                      VectorMemory<MultiVectorType> &mem,
+                      const AdditionalData &         data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverMultipleGMRES(SolverControl &       cn,
+                      const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverMultipleGMRES() override = default;
+
+  /**
+   * Solve the linear systems $Ax_i=b_i$ for all blocks $x_i$ of @p x and
+   * $b_i$ of @p b. @p A and @p preconditioner work on the blocks of the
+   * multi-vectors.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        MultiVectorType &         x,
+        const MultiVectorType &   b,
+        const PreconditionerType &preconditioner);
+
+  /**
+   * Return the number of blocks that had not been deflated when the last
+   * call to solve() ended.
+   */
+  unsigned int
+  n_active_blocks() const;
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The control object, whose tolerance and, for a ReductionControl,
+   * reduction determine when a block is deflated.
+   */
+  SmartPointer<const SolverControl, SolverMultipleGMRES<MultiVectorType>>
+    solver_control;
+
+  /**
+   * The blocks that have not been deflated yet.
+   */
+  std::vector<unsigned int> active_blocks;
+
+  /**
+   * Apply the previous Givens rotations to the new column @p h of the
+   * Hessenberg matrix, compute the rotation for entry @p col and apply it
+   * to @p h and the right-hand side @p b of the least-squares problem.
+   */
+  static void
+  givens_rotation(Vector<double> &   h,
+                  Vector<double> &   b,
+                  Vector<double> &   ci,
+                  Vector<double> &   si,
+                  const unsigned int col);
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename MultiVectorType>
+inline SolverMultipleGMRES<MultiVectorType>::AdditionalData::AdditionalData(
+  const unsigned int max_n_tmp_vectors)
+  : max_n_tmp_vectors(max_n_tmp_vectors)
+{}
+
+
+
+template <typename MultiVectorType>
+SolverMultipleGMRES<MultiVectorType>::SolverMultipleGMRES(
+  SolverControl &                cn,
+  VectorMemory<MultiVectorType> &mem,
+  const AdditionalData &         data)
+  : SolverBase<MultiVectorType>(cn, mem)
+  , additional_data(data)
+  , solver_control(&cn)
+{}
+
+
+
+template <typename MultiVectorType>
+SolverMultipleGMRES<MultiVectorType>::SolverMultipleGMRES(
+  SolverControl &       cn,
+  const AdditionalData &data)
+  : SolverBase<MultiVectorType>(cn)
+  , additional_data(data)
+  , solver_control(&cn)
+{}
+
+
+
+template <typename MultiVectorType>
+unsigned int
+SolverMultipleGMRES<MultiVectorType>::n_active_blocks() const
+{
+  return active_blocks.size();
+}
+
+
+
+template <typename MultiVectorType>
+inline void
+SolverMultipleGMRES<MultiVectorType>::givens_rotation(Vector<double> &   h,
+                                                      Vector<double> &   b,
+                                                      Vector<double> &   ci,
+                                                      Vector<double> &   si,
+                                                      const unsigned int col)
+{
+  for (unsigned int i = 0; i < col; ++i)
+    {
+      const double s     = si(i);
+      const double c     = ci(i);
+      const double dummy = h(i);
+      h(i)               = c * dummy + s * h(i + 1);
+      h(i + 1)           = -s * dummy + c * h(i + 1);
+    }
+
+  const double r = 1. / std::sqrt(h(col) * h(col) + h(col + 1) * h(col + 1));
+  si(col)        = h(col + 1) * r;
+  ci(col)        = h(col) * r;
+  h(col)         = ci(col) * h(col) + si(col) * h(col + 1);
+  b(col + 1)     = -si(col) * b(col);
+  b(col) *= ci(col);
+}
+
+
+
+template <typename MultiVectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverMultipleGMRES<MultiVectorType>::solve(
+  const MatrixType &        A,
+  MultiVectorType &         x,
+  const MultiVectorType &   b,
+  const PreconditionerType &preconditioner)
+{
+  using VectorType = typename MultiVectorType::BlockType;
+
+  const unsigned int n_blocks = b.n_blocks();
+  AssertDimension(x.n_blocks(), n_blocks);
+
+  LogStream::Prefix prefix("multiple GMRES");
+
+  // extra call to std::max as in SolverGMRES, since
+  // additional_data.max_n_tmp_vectors - 2 may overflow
+  const unsigned int n_tmp_vectors =
+    std::max(additional_data.max_n_tmp_vectors, 3u);
+
+  // the basis vectors of all blocks, and a temporary vector for the products
+  // with the matrix
+  internal::SolverGMRESImplementation::TmpVectors<MultiVectorType> tmp_vectors(
+    n_tmp_vectors, this->memory);
+  MultiVectorType &v = tmp_vectors(0, x);
+  MultiVectorType &p = tmp_vectors(n_tmp_vectors - 1, x);
+
+  // the Hessenberg matrix after the Givens rotations, the right-hand side of
+  // the least-squares problem and the rotations of each block
+  std::vector<FullMatrix<double>> H(
+    n_blocks, FullMatrix<double>(n_tmp_vectors, n_tmp_vectors - 1));
+  std::vector<Vector<double>> gamma(n_blocks, Vector<double>(n_tmp_vectors));
+  std::vector<Vector<double>> ci(n_blocks, Vector<double>(n_tmp_vectors - 1));
+  std::vector<Vector<double>> si(n_blocks, Vector<double>(n_tmp_vectors - 1));
+  Vector<double>              h(n_tmp_vectors - 1);
+
+  std::vector<double> residuals(n_blocks);
+  std::vector<double> deflation_tolerances;
+
+  // add the correction from the first @p dim basis vectors to the solution
+  // of block @p c
+  const auto update_solution = [&](const unsigned int c,
+                                   const unsigned int dim) {
+    if (dim == 0)
+      return;
+    FullMatrix<double> H1(dim + 1, dim);
+    for (unsigned int i = 0; i < dim + 1; ++i)
+      for (unsigned int j = 0; j < dim; ++j)
+        H1(i, j) = H[c](i, j);
+    Vector<double> y(dim);
+    H1.backward(y, gamma[c]);
+    for (unsigned int i = 0; i < dim; ++i)
+      x.block(c).add(y(i), tmp_vectors[i].block(c));
+  };
+
+  const auto deflate = [&]() {
+    unsigned int n_active = 0;
+    for (const unsigned int c : active_blocks)
+      if (residuals[c] > deflation_tolerances[c])
+        active_blocks[n_active++] = c;
+    active_blocks.resize(n_active);
+  };
+
+  std::vector<VectorType *>       dst_blocks;
+  std::vector<const VectorType *> src_blocks;
+
+  SolverControl::State conv = SolverControl::iterate;
+  double               res  = -std::numeric_limits<double>::max();
+
+  // number of the present iteration; this number is not reset to zero upon
+  // a restart
+  unsigned int accumulated_iterations = 0;
+
+  active_blocks.resize(n_blocks);
+  for (unsigned int c = 0; c < n_blocks; ++c)
+    active_blocks[c] = c;
+
+  // outer iteration: each cycle of this loop amounts to one restart of the
+  // blocks that are still active
+  do
+    {
+      dst_blocks.clear();
+      src_blocks.clear();
+      for (const unsigned int c : active_blocks)
+        {
+          dst_blocks.push_back(&p.block(c));
+          src_blocks.push_back(&x.block(c));
+        }
+      internal::SolverMultipleCGImplementation::vmult_multiple(A,
+                                                               dst_blocks,
+                                                               src_blocks);
+      for (const unsigned int c : active_blocks)
+        {
+          p.block(c).sadd(-1., 1., b.block(c));
+          preconditioner.vmult(v.block(c), p.block(c));
+          residuals[c] = v.block(c).l2_norm();
+        }
+
+      if (deflation_tolerances.empty())
+        deflation_tolerances =
+          internal::SolverMultipleCGImplementation::deflation_tolerances(
+            *solver_control, residuals);
+
+      res = internal::SolverMultipleCGImplementation::total_residual(residuals);
+      conv = this->iteration_status(accumulated_iterations, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      // blocks that are deflated here already have their final solution. the
+      // others have a nonzero residual, by which we can scale
+      deflate();
+      for (const unsigned int c : active_blocks)
+        {
+          gamma[c]    = 0.;
+          gamma[c](0) = residuals[c];
+          v.block(c) *= 1. / residuals[c];
+        }
+
+      // inner iteration doing at most as many steps as there are temporary
+      // vectors. the number of steps actually done is kept in @p dim
+      unsigned int dim = 0;
+      for (unsigned int inner_iteration = 0;
+           inner_iteration < n_tmp_vectors - 2 && !active_blocks.empty();
+           ++inner_iteration)
+        {
+          ++accumulated_iterations;
+          MultiVectorType &vv = tmp_vectors(inner_iteration + 1, x);
+
+          dst_blocks.clear();
+          src_blocks.clear();
+          for (const unsigned int c : active_blocks)
+            {
+              dst_blocks.push_back(&p.block(c));
+              src_blocks.push_back(&tmp_vectors[inner_iteration].block(c));
+            }
+          internal::SolverMultipleCGImplementation::vmult_multiple(
+            A, dst_blocks, src_blocks);
+
+          for (const unsigned int c : active_blocks)
+            {
+              VectorType &w = vv.block(c);
+              preconditioner.vmult(w, p.block(c));
+
+              // modified Gram-Schmidt
+              for (unsigned int i = 0; i <= inner_iteration; ++i)
+                {
+                  h(i) = w * tmp_vectors[i].block(c);
+                  w.add(-h(i), tmp_vectors[i].block(c));
+                }
+              const double s         = w.l2_norm();
+              h(inner_iteration + 1) = s;
+
+              // s=0 is a lucky breakdown, the block will be deflated, but we
+              // must not divide by zero here
+              if (s != 0)
+                w *= 1. / s;
+
+              givens_rotation(h, gamma[c], ci[c], si[c], inner_iteration);
+              for (unsigned int i = 0; i <= inner_iteration; ++i)
+                H[c](i, inner_iteration) = h(i);
+
+              residuals[c] = std::fabs(gamma[c](inner_iteration + 1));
+            }
+          dim = inner_iteration + 1;
+
+          res =
+            internal::SolverMultipleCGImplementation::total_residual(residuals);
+          conv = this->iteration_status(accumulated_iterations, res, x);
+          if (conv != SolverControl::iterate)
+            break;
+
+          // blocks that are deflated get their solution now, since their
+          // basis is not extended any more
+          for (const unsigned int c : active_blocks)
+            if (residuals[c] <= deflation_tolerances[c])
+              update_solution(c, dim);
+          deflate();
+        }
+
+      // end of inner iteration. now calculate the solution of the remaining
+      // blocks from the temporary vectors
+      for (const unsigned int c : active_blocks)
+        update_solution(c, dim);
+    }
+  while (conv == SolverControl::iterate && !active_blocks.empty());
+
+  // in case of failure: throw exception
+  if (conv == SolverControl::failure)
+    AssertThrow(false,
+                SolverControl::NoConvergence(accumulated_iterations, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
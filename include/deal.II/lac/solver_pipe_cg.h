@@ -0,0 +1,393 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_pipe_cg_h
+#define dealii_solver_pipe_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <array>
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+namespace internal
+{
+  namespace SolverPipeCGImplementation
+  {
+    /**
+     * The three inner products $(r,u)$, $(w,u)$ and $(r,r)$ needed in each
+     * iteration of SolverPipeCG. The general version computes them with the
+     * dot products of @p VectorType when start() is called; finish() does
+     * nothing.
+     */
+    template <typename VectorType>
+    class MergedDotProducts
+    {
+    public:
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        values[0] = r * u;
+        values[1] = w * u;
+        values[2] = r * r;
+      }
+
+      void
+      finish()
+      {}
+
+      std::array<double, 3> values;
+    };
+
+
+
+    /**
+     * Specialization for LinearAlgebra::distributed::Vector: the three local
+     * sums are computed in a single pass over the vectors and then combined
+     * across all processes with one non-blocking MPI_Iallreduce. The
+     * reduction runs while the solver applies the preconditioner and the
+     * matrix, and finish() waits for it to complete.
+     */
+    template <typename Number>
+    class MergedDotProducts<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+    {
+    public:
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        Assert(r.local_size() == u.local_size() &&
+                 r.local_size() == w.local_size(),
+               ExcDimensionMismatch(r.local_size(), u.local_size()));
+
+        double ru = 0., wu = 0., rr = 0.;
+
+        const Number *r_ptr = r.begin();
+        const Number *u_ptr = u.begin();
+        const Number *w_ptr = w.begin();
+        for (types::global_dof_index i = 0; i < r.local_size(); ++i)
+          {
+            ru += r_ptr[i] * u_ptr[i];
+            wu += w_ptr[i] * u_ptr[i];
+            rr += r_ptr[i] * r_ptr[i];
+          }
+        values = {{ru, wu, rr}};
+
+#ifdef DEAL_II_WITH_MPI
+        communicator = r.get_mpi_communicator();
+        if (Utilities::MPI::job_supports_mpi() &&
+            Utilities::MPI::n_mpi_processes(communicator) > 1)
+          {
+            const int ierr = MPI_Iallreduce(MPI_IN_PLACE,
+                                            values.data(),
+                                            values.size(),
+                                            MPI_DOUBLE,
+                                            MPI_SUM,
+                                            communicator,
+                                            &request);
+            AssertThrowMPI(ierr);
+            request_pending = true;
+          }
+#endif
+      }
+
+      void
+      finish()
+      {
+#ifdef DEAL_II_WITH_MPI
+        if (request_pending)
+          {
+            const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+            request_pending = false;
+          }
+#endif
+      }
+
+      std::array<double, 3> values;
+
+    private:
+#ifdef DEAL_II_WITH_MPI
+      MPI_Comm    communicator;
+      MPI_Request request;
+      bool        request_pending = false;
+#endif
+    };
+  } // namespace SolverPipeCGImplementation
+} // namespace internal
+
+
+
+/**
+ * This class implements the pipelined preconditioned Conjugate Gradients
+ * method of P. Ghysels and W. Vanroose, "Hiding global synchronization
+ * latency in the preconditioned Conjugate Gradient algorithm", Parallel
+ * Computing 40 (2014), pp. 224-238. In exact arithmetic, it produces the
+ * same iterates as SolverCG and it is used the same way, with a symmetric
+ * positive definite matrix and a symmetric preconditioner.
+ *
+ * SolverCG needs two global reductions per iteration, each of which has to
+ * wait for the matrix-vector product or the preconditioner before it. This
+ * variant introduces auxiliary vectors holding the matrix and preconditioner
+ * applied to the search directions, so that all inner products of one
+ * iteration are independent of that iteration's matrix-vector product and
+ * preconditioner. They are merged into a single reduction, which for
+ * LinearAlgebra::distributed::Vector is started as a non-blocking
+ * MPI_Iallreduce before the preconditioner and the matrix are applied, and
+ * only completed afterwards. The latency of the reduction is thus hidden
+ * behind the local work, which pays off in the strong scaling limit where
+ * few unknowns per process are left. For other vector types, the inner
+ * products are computed in the usual blocking way.
+ *
+ * The price for this is a larger memory footprint (nine vectors instead of
+ * three) and a few more vector updates per iteration, so the method is
+ * slower than SolverCG when the reductions are cheap, e.g. in serial
+ * computations. Moreover, the residual is obtained from a recurrence
+ * instead of from its definition, which may limit the attainable accuracy
+ * for very tight tolerances. The convergence test uses the norm of the
+ * unpreconditioned residual, as in SolverCG.
+ *
+ * Whether the reduction actually progresses while the local work is done
+ * depends on the MPI implementation; many implementations need asynchronous
+ * progress to be enabled for that, e.g. through MPICH_ASYNC_PROGRESS=1.
+ */
+template <typename VectorType = Vector<double>>
+class SolverPipeCG : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   * Here, it doesn't store anything but just exists for consistency
+   * with the other solver classes.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverPipeCG(SolverControl &           cn,
+               VectorMemory<VectorType> &mem,
+               const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipeCG(SolverControl &       cn,
+               const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverPipeCG() override = default;
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename VectorType>
+SolverPipeCG<VectorType>::SolverPipeCG(SolverControl &           cn,
+                                       VectorMemory<VectorType> &mem,
+                                       const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverPipeCG<VectorType>::SolverPipeCG(SolverControl &       cn,
+                                       const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipeCG<VectorType>::solve(const MatrixType &        A,
+                                VectorType &              x,
+                                const VectorType &        b,
+                                const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("pipecg");
+
+  // Memory allocation. Following the notation of Ghysels and Vanroose, r is
+  // the residual, u=Mr, w=Au, m=Mw, n=Am, and p, s=Ap, q=Ms, z=Aq are the
+  // search direction and its images
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+
+  // define some aliases for simpler access
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &p = *p_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &z = *z_pointer;
+
+  // resize the vectors, but do not set the values since they'd be
+  // overwritten soon anyway.
+  r.reinit(x, true);
+  u.reinit(x, true);
+  w.reinit(x, true);
+  m.reinit(x, true);
+  n.reinit(x, true);
+  p.reinit(x, true);
+  s.reinit(x, true);
+  q.reinit(x, true);
+  z.reinit(x, true);
+
+  internal::SolverPipeCGImplementation::MergedDotProducts<VectorType>
+    dot_products;
+
+  int    it  = 0;
+  double res = -std::numeric_limits<double>::max();
+
+  number alpha = 0, gamma_old = 0;
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r = b;
+
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+
+  while (conv == SolverControl::iterate)
+    {
+      // start the reduction of the inner products and overlap it with the
+      // preconditioner and the matrix-vector product
+      dot_products.start(r, u, w);
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+      dot_products.finish();
+
+      const number gamma = dot_products.values[0];
+      const number delta = dot_products.values[1];
+      res                = std::sqrt(std::abs(dot_products.values[2]));
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      number beta;
+      if (it == 0)
+        {
+          beta = 0;
+          Assert(std::abs(delta) != 0., ExcDivideByZero());
+          alpha = gamma / delta;
+
+          z = n;
+          q = m;
+          s = w;
+          p = u;
+        }
+      else
+        {
+          Assert(std::abs(gamma_old) != 0., ExcDivideByZero());
+          beta = gamma / gamma_old;
+          Assert(std::abs(delta - beta * gamma / alpha) != 0.,
+                 ExcDivideByZero());
+          alpha = gamma / (delta - beta * gamma / alpha);
+
+          z.sadd(beta, 1., n);
+          q.sadd(beta, 1., m);
+          s.sadd(beta, 1., w);
+          p.sadd(beta, 1., u);
+        }
+      gamma_old = gamma;
+
+      x.add(alpha, p);
+      r.add(-alpha, s);
+      u.add(-alpha, q);
+      w.add(-alpha, z);
+
+      ++it;
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -21,6 +21,7 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/block_sparse_matrix.h>
 #include <deal.II/lac/sparse_matrix.h>
@@ -68,6 +69,13 @@ namespace types
  * class provides an older interface, consisting of the functions factorize()
  * and solve(). Both interfaces are interchangeable.
  *
+ * If several matrices with the same sparsity pattern are to be factorized
+ * one after the other, as in Newton or time stepping schemes, the symbolic
+ * analysis of the sparsity pattern (the fill-reducing ordering) only needs
+ * to be done once by calling analyze(), followed by a call to
+ * factorize_numeric() for each of the matrices. The time spent in the
+ * individual phases can be obtained through get_statistics().
+ *
  * @note This class exists if the <a
  * href="http://faculty.cse.tamu.edu/davis/suitesparse.html">UMFPACK</a>
  * interface was not explicitly disabled during configuration.
@@ -105,6 +113,42 @@ public:
   class AdditionalData
   {};
 
+  /**
+   * Accumulated wall times (in seconds) and numbers of calls of the
+   * individual phases of the direct solver since the object was created.
+   */
+  struct Statistics
+  {
+    /**
+     * Number of symbolic analyses of a sparsity pattern.
+     */
+    unsigned int n_analyses = 0;
+
+    /**
+     * Time spent in the symbolic analyses.
+     */
+    double analysis_time = 0.;
+
+    /**
+     * Number of numeric factorizations.
+     */
+    unsigned int n_numeric_factorizations = 0;
+
+    /**
+     * Time spent in the numeric factorizations.
+     */
+    double numeric_factorization_time = 0.;
+
+    /**
+     * Number of vectors solved for.
+     */
+    unsigned int n_solves = 0;
+
+    /**
+     * Time spent in the forward and backward substitutions.
+     */
+    double solve_time = 0.;
+  };
 
   /**
    * Constructor. See the documentation of this class for the meaning of the
@@ -152,6 +196,32 @@ public:
   void
   factorize(const Matrix &matrix);
 
+  /**
+   * Copy the sparsity pattern of @p matrix and compute the symbolic
+   * factorization, i.e., the fill-reducing ordering of the rows and columns,
+   * without factorizing the matrix numerically. Afterwards, each matrix with
+   * the same sparsity pattern can be factorized with factorize_numeric(),
+   * which is considerably cheaper than factorize() since the analysis of the
+   * sparsity pattern is skipped.
+   *
+   * Since the ordering may take the values of the matrix into account for
+   * the choice of pivots, the matrix passed here should be representative of
+   * the ones factorized later.
+   */
+  template <class Matrix>
+  void
+  analyze(const Matrix &matrix);
+
+  /**
+   * Compute the numeric LU factorization of @p matrix, reusing the symbolic
+   * factorization computed by the last call to analyze() or factorize().
+   * @p matrix must have the same sparsity pattern as the matrix passed to
+   * that function, which is checked in debug mode.
+   */
+  template <class Matrix>
+  void
+  factorize_numeric(const Matrix &matrix);
+
   /**
    * Initialize memory and call SparseDirectUMFPACK::factorize.
    */
@@ -216,6 +286,13 @@ public:
   size_type
   n() const;
 
+  /**
+   * Return the accumulated timings of the analysis, factorization and
+   * solution phases.
+   */
+  const Statistics &
+  get_statistics() const;
+
   /**
    * @}
    */
@@ -252,6 +329,17 @@ public:
   solve(BlockVector<double> &rhs_and_solution,
         const bool           transpose = false) const;
 
+  /**
+   * Solve for several right hand side vectors with the same factorization.
+   * The solutions are returned in place of the right hand side vectors. The
+   * vectors are solved for in parallel, and the work arrays UMFPACK needs
+   * for the substitutions are allocated once per thread rather than once
+   * per vector, so this is faster than calling solve() for each vector.
+   */
+  void
+  solve(std::vector<Vector<double>> &rhs_and_solutions,
+        const bool                   transpose = false) const;
+
   /**
    * Call the two functions factorize() and solve() in that order, i.e.
    * perform the whole solution process for the given right hand side vector.
@@ -343,6 +431,33 @@ private:
   void
   clear();
 
+  /**
+   * Copy the entries of @p matrix into the arrays #Ap, #Ai and #Ax in the
+   * format UMFPACK wants.
+   */
+  template <class Matrix>
+  void
+  copy_matrix(const Matrix &matrix);
+
+  /**
+   * Compute the numeric factorization of the matrix stored in #Ap, #Ai and
+   * #Ax with the present symbolic factorization.
+   */
+  void
+  numeric_factorization();
+
+  /**
+   * Solve for the @p rhs_and_solution array of length #_m, using the given
+   * work arrays. They are resized as necessary, so they can be reused for
+   * several calls.
+   */
+  void
+  solve_with_workspace(
+    double *                               rhs_and_solution,
+    const bool                             transpose,
+    std::vector<types::suitesparse_index> &index_workspace,
+    std::vector<double> &                  workspace) const;
+
   /**
    * Make sure that the arrays Ai and Ap are sorted in each row. UMFPACK wants
    * it this way. We need to have three versions of this function, one for the
@@ -372,6 +487,16 @@ private:
    * Control and work arrays for the solver routines.
    */
   std::vector<double> control;
+
+  /**
+   * Timings of the individual phases.
+   */
+  mutable Statistics statistics;
+
+  /**
+   * Mutex guarding #statistics in solve(), which may be called concurrently.
+   */
+  mutable Threads::Mutex statistics_mutex;
 };
 
 DEAL_II_NAMESPACE_CLOSE
@@ -23,6 +23,7 @@
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/sparse_decomposition.h>
 #include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/triangular_level_schedule.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -106,6 +107,11 @@ public:
    * Apply the incomplete decomposition, i.e. do one forward-backward step
    * $dst=(LU)^{-1}src$.
    *
+   * The rows of each substitution are processed level by level along a
+   * TriangularLevelSchedule of the decomposition computed in initialize(),
+   * with the rows of a level running in parallel. The result is the same as
+   * the one of a sequential substitution.
+   *
    * The initialize() function needs to be called before.
    */
   template <typename somenumber>
@@ -124,6 +130,12 @@ public:
   Tvmult(Vector<somenumber> &dst, const Vector<somenumber> &src) const;
 
 
+  /**
+   * Release all memory and the level schedule.
+   */
+  void
+  clear() override;
+
   /**
    * Determine an estimate for the memory consumption (in bytes) of this
    * object.
@@ -155,6 +167,13 @@ public:
                     "that the matrix for which you try to compute a "
                     "decomposition is singular.");
   //@}
+
+private:
+  /**
+   * The order in which vmult() processes the rows of the forward and
+   * backward substitutions.
+   */
+  TriangularLevelSchedule level_schedule;
 };
 
 /*@}*/
@@ -129,6 +129,8 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
       for (size_type j = j1; j <= j2; ++j)
         iw[ja[j]] = numbers::invalid_size_type;
     }
+
+  level_schedule.initialize(sparsity);
 }
 
 
@@ -143,7 +145,6 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
          ExcDimensionMismatch(dst.size(), src.size()));
   Assert(dst.size() == this->m(), ExcDimensionMismatch(dst.size(), this->m()));
 
-  const size_type          N = dst.size();
   const std::size_t *const rowstart_indices =
     this->get_sparsity_pattern().rowstart.get();
   const size_type *const column_numbers =
@@ -162,25 +163,24 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
   // perform it at the outset of the
   // loop
   dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
-      // get start of this row. skip the
-      // diagonal element
-      const size_type *const rowstart =
-        &column_numbers[rowstart_indices[row] + 1];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      somenumber    dst_row = dst(row);
-      const number *luval =
-        this->SparseMatrix<number>::val.get() + (rowstart - column_numbers);
-      for (const size_type *col = rowstart; col != first_after_diagonal;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
-      dst(row) = dst_row;
-    }
+  level_schedule.apply_forward([&](const size_type row) {
+    // get start of this row. skip the
+    // diagonal element
+    const size_type *const rowstart =
+      &column_numbers[rowstart_indices[row] + 1];
+    // find the position where the part
+    // right of the diagonal starts
+    const size_type *const first_after_diagonal =
+      this->prebuilt_lower_bound[row];
+
+    somenumber    dst_row = dst(row);
+    const number *luval =
+      this->SparseMatrix<number>::val.get() + (rowstart - column_numbers);
+    for (const size_type *col = rowstart; col != first_after_diagonal;
+         ++col, ++luval)
+      dst_row -= *luval * dst(*col);
+    dst(row) = dst_row;
+  });
 
   // now the backward solve. same
   // procedure, but we need not set
@@ -190,28 +190,26 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
   // note that we need to scale now,
   // since the diagonal is not equal to
   // one now
-  for (int row = N - 1; row >= 0; --row)
-    {
-      // get end of this row
-      const size_type *const rowend =
-        &column_numbers[rowstart_indices[row + 1]];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      somenumber    dst_row = dst(row);
-      const number *luval   = this->SparseMatrix<number>::val.get() +
-                            (first_after_diagonal - column_numbers);
-      for (const size_type *col = first_after_diagonal; col != rowend;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
-
-      // scale by the diagonal element.
-      // note that the diagonal element
-      // was stored inverted
-      dst(row) = dst_row * this->diag_element(row);
-    }
+  level_schedule.apply_backward([&](const size_type row) {
+    // get end of this row
+    const size_type *const rowend = &column_numbers[rowstart_indices[row + 1]];
+    // find the position where the part
+    // right of the diagonal starts
+    const size_type *const first_after_diagonal =
+      this->prebuilt_lower_bound[row];
+
+    somenumber    dst_row = dst(row);
+    const number *luval   = this->SparseMatrix<number>::val.get() +
+                          (first_after_diagonal - column_numbers);
+    for (const size_type *col = first_after_diagonal; col != rowend;
+         ++col, ++luval)
+      dst_row -= *luval * dst(*col);
+
+    // scale by the diagonal element.
+    // note that the diagonal element
+    // was stored inverted
+    dst(row) = dst_row * this->diag_element(row);
+  });
 }
 
 
@@ -298,11 +296,21 @@ SparseILU<number>::Tvmult(Vector<somenumber> &      dst,
 }
 
 
+template <typename number>
+void
+SparseILU<number>::clear()
+{
+  SparseLUDecomposition<number>::clear();
+  level_schedule.clear();
+}
+
+
 template <typename number>
 std::size_t
 SparseILU<number>::memory_consumption() const
 {
-  return SparseLUDecomposition<number>::memory_consumption();
+  return SparseLUDecomposition<number>::memory_consumption() +
+         level_schedule.memory_consumption();
 }
 
 DEAL_II_NAMESPACE_CLOSE
@@ -21,16 +21,19 @@
 
 #  include <deal.II/base/smartpointer.h>
 #  include <deal.II/base/subscriptor.h>
+#  include <deal.II/base/thread_management.h>
 
 #  include <deal.II/lac/exceptions.h>
 #  include <deal.II/lac/identity_matrix.h>
 #  include <deal.II/lac/sparsity_pattern.h>
+#  include <deal.II/lac/triangular_level_schedule.h>
 #  include <deal.II/lac/vector_operation.h>
 #  ifdef DEAL_II_WITH_MPI
 #    include <mpi.h>
 #  endif
 
 #  include <memory>
+#  include <vector>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -752,6 +755,28 @@ public:
    */
   void compress(::dealii::VectorOperation::values);
 
+  /**
+   * Select whether Tvmult() and Tvmult_add() use a cached transposed index
+   * structure of the sparsity pattern. With the cache, the transpose product
+   * loops over the columns of this matrix and runs in parallel like vmult();
+   * without it, the product scatters into the destination row by row and is
+   * sequential. The cache is built on the first transpose product after
+   * this call or after reinit(), and stores a row and a value index per
+   * nonzero entry, see transpose_cache_memory_consumption(). Disabling the
+   * cache releases this memory. The default is not to use the cache.
+   */
+  void
+  set_transpose_cache(const bool use_cache);
+
+  /**
+   * Return the memory (in bytes) currently held by the transposed index
+   * structure set up through set_transpose_cache(). This is zero if the
+   * cache is disabled or has not been built yet. The amount is also
+   * included in memory_consumption().
+   */
+  std::size_t
+  transpose_cache_memory_consumption() const;
+
   //@}
   /**
    * @name Modifying entries
@@ -1112,6 +1137,9 @@ public:
    * a BlockSparseMatrix as well.
    *
    * Source and destination must not be the same vector.
+   *
+   * This operation is multithreaded if the transposed index cache is
+   * enabled, see set_transpose_cache().
    */
   template <class OutVector, class InVector>
   void
@@ -1151,11 +1179,32 @@ public:
    * a BlockSparseMatrix as well.
    *
    * Source and destination must not be the same vector.
+   *
+   * This operation is multithreaded if the transposed index cache is
+   * enabled, see set_transpose_cache().
    */
   template <class OutVector, class InVector>
   void
   Tvmult_add(OutVector &dst, const InVector &src) const;
 
+  /**
+   * Matrix-vector multiplication with several vectors at once: let
+   * <i>*dst[c] = M*(*src[c])</i> for all <i>c</i>, with <i>M</i> being this
+   * matrix. This gives the same result as calling vmult() for each pair of
+   * vectors, but the matrix is only read once for every four vectors
+   * instead of once for every vector. It is used by solvers that work on
+   * several right-hand sides simultaneously, like SolverMultipleCG and
+   * SolverMultipleGMRES.
+   *
+   * None of the source vectors may be one of the destination vectors.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  template <typename somenumber>
+  void
+  vmult_multiple(const std::vector<Vector<somenumber> *> &      dst,
+                 const std::vector<const Vector<somenumber> *> &src) const;
+
   /**
    * Return the square of the norm of the vector $v$ with respect to the norm
    * induced by this matrix, i.e. $\left(v,Mv\right)$. This is useful, e.g. in
@@ -1338,6 +1387,24 @@ public:
                     const std::vector<std::size_t> &pos_right_of_diagonal =
                       std::vector<std::size_t>()) const;
 
+  /**
+   * Same as above, but process the rows of the forward and backward sweeps
+   * level by level along @p level_schedule, which must have been set up
+   * with the sparsity pattern of this matrix. The rows of each level are
+   * processed in parallel; the result is the same as the one of the
+   * sequential sweeps. If @p level_schedule or @p pos_right_of_diagonal is
+   * empty, the sequential function above is called.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  template <typename somenumber>
+  void
+  precondition_SSOR(Vector<somenumber> &            dst,
+                    const Vector<somenumber> &      src,
+                    const number                    omega,
+                    const std::vector<std::size_t> &pos_right_of_diagonal,
+                    const TriangularLevelSchedule & level_schedule) const;
+
   /**
    * Apply SOR preconditioning matrix to <tt>src</tt>.
    */
@@ -1724,6 +1791,49 @@ private:
    */
   std::size_t max_len;
 
+  /**
+   * Whether the transpose products use the cached transposed index
+   * structure below. Set through set_transpose_cache().
+   */
+  bool use_transpose_cache;
+
+  /**
+   * Start of each column of this matrix within #transpose_rows and
+   * #transpose_entries, i.e., the column counterpart of
+   * SparsityPattern::rowstart. Empty as long as the cache has not been
+   * built.
+   */
+  mutable std::vector<std::size_t> transpose_colstart;
+
+  /**
+   * Row index of each nonzero entry, sorted by columns.
+   */
+  mutable std::vector<size_type> transpose_rows;
+
+  /**
+   * Position in #val of each nonzero entry, sorted by columns.
+   */
+  mutable std::vector<std::size_t> transpose_entries;
+
+  /**
+   * Mutex guarding the lazy construction of the transposed index cache from
+   * the (const) transpose products.
+   */
+  mutable Threads::Mutex transpose_cache_mutex;
+
+  /**
+   * Build the transposed index cache if it is enabled and not yet set up.
+   */
+  void
+  prepare_transpose_cache() const;
+
+  /**
+   * Release the transposed index cache, e.g., because the sparsity pattern
+   * has changed.
+   */
+  void
+  clear_transpose_cache();
+
   // make all other sparse matrices friends
   template <typename somenumber>
   friend class SparseMatrix;
@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
@@ -50,6 +51,7 @@ SparseMatrix<number>::SparseMatrix()
   : cols(nullptr, "SparseMatrix")
   , val(nullptr)
   , max_len(0)
+  , use_transpose_cache(false)
 {}
 
 
@@ -60,6 +62,7 @@ SparseMatrix<number>::SparseMatrix(const SparseMatrix &m)
   , cols(nullptr, "SparseMatrix")
   , val(nullptr)
   , max_len(0)
+  , use_transpose_cache(false)
 {
   Assert(m.cols == nullptr && m.val == nullptr && m.max_len == 0,
          ExcMessage(
@@ -77,10 +80,15 @@ SparseMatrix<number>::SparseMatrix(SparseMatrix<number> &&m) noexcept
   , cols(m.cols)
   , val(std::move(m.val))
   , max_len(m.max_len)
+  , use_transpose_cache(m.use_transpose_cache)
+  , transpose_colstart(std::move(m.transpose_colstart))
+  , transpose_rows(std::move(m.transpose_rows))
+  , transpose_entries(std::move(m.transpose_entries))
 {
   m.cols    = nullptr;
   m.val     = nullptr;
   m.max_len = 0;
+  m.clear_transpose_cache();
 }
 
 
@@ -105,13 +113,18 @@ template <typename number>
 SparseMatrix<number> &
 SparseMatrix<number>::operator=(SparseMatrix<number> &&m) noexcept
 {
-  cols    = m.cols;
-  val     = std::move(m.val);
-  max_len = m.max_len;
+  cols                = m.cols;
+  val                 = std::move(m.val);
+  max_len             = m.max_len;
+  use_transpose_cache = m.use_transpose_cache;
+  transpose_colstart  = std::move(m.transpose_colstart);
+  transpose_rows      = std::move(m.transpose_rows);
+  transpose_entries   = std::move(m.transpose_entries);
 
   m.cols    = nullptr;
   m.val     = nullptr;
   m.max_len = 0;
+  m.clear_transpose_cache();
 
   return *this;
 }
@@ -123,6 +136,7 @@ SparseMatrix<number>::SparseMatrix(const SparsityPattern &c)
   : cols(nullptr, "SparseMatrix")
   , val(nullptr)
   , max_len(0)
+  , use_transpose_cache(false)
 {
   // virtual functions called in constructors and destructors never use the
   // override in a derived class
@@ -138,6 +152,7 @@ SparseMatrix<number>::SparseMatrix(const SparsityPattern &c,
   : cols(nullptr, "SparseMatrix")
   , val(nullptr)
   , max_len(0)
+  , use_transpose_cache(false)
 {
   (void)id;
   Assert(c.n_rows() == id.m(), ExcDimensionMismatch(c.n_rows(), id.m()));
@@ -258,6 +273,7 @@ void
 SparseMatrix<number>::reinit(const SparsityPattern &sparsity)
 {
   cols = &sparsity;
+  clear_transpose_cache();
 
   if (cols->empty())
     {
@@ -285,6 +301,75 @@ SparseMatrix<number>::clear()
   cols = nullptr;
   val.reset();
   max_len = 0;
+  clear_transpose_cache();
+}
+
+
+
+template <typename number>
+void
+SparseMatrix<number>::set_transpose_cache(const bool use_cache)
+{
+  use_transpose_cache = use_cache;
+  if (use_cache == false)
+    clear_transpose_cache();
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrix<number>::transpose_cache_memory_consumption() const
+{
+  return MemoryConsumption::memory_consumption(transpose_colstart) +
+         MemoryConsumption::memory_consumption(transpose_rows) +
+         MemoryConsumption::memory_consumption(transpose_entries);
+}
+
+
+
+template <typename number>
+void
+SparseMatrix<number>::prepare_transpose_cache() const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+
+  std::lock_guard<std::mutex> lock(transpose_cache_mutex);
+  if (transpose_colstart.size() == n() + 1)
+    return;
+
+  // counting sort of the entries by column; entries within a column end up
+  // ordered by row
+  transpose_colstart.assign(n() + 1, 0);
+  const std::size_t n_entries = cols->n_nonzero_elements();
+  for (std::size_t j = 0; j < n_entries; ++j)
+    ++transpose_colstart[cols->colnums[j] + 1];
+  std::partial_sum(transpose_colstart.begin(),
+                   transpose_colstart.end(),
+                   transpose_colstart.begin());
+
+  std::vector<std::size_t> next(transpose_colstart.begin(),
+                                transpose_colstart.end() - 1);
+  transpose_rows.resize(n_entries);
+  transpose_entries.resize(n_entries);
+  for (size_type row = 0; row < m(); ++row)
+    for (std::size_t j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
+      {
+        const std::size_t index  = next[cols->colnums[j]]++;
+        transpose_rows[index]    = row;
+        transpose_entries[index] = j;
+      }
+}
+
+
+
+template <typename number>
+void
+SparseMatrix<number>::clear_transpose_cache()
+{
+  std::vector<std::size_t>().swap(transpose_colstart);
+  std::vector<size_type>().swap(transpose_rows);
+  std::vector<std::size_t>().swap(transpose_entries);
 }
 
 
@@ -526,6 +611,89 @@ namespace internal
             *dst_ptr++ = s;
           }
     }
+
+
+
+    /**
+     * Perform a Tvmult using the transposed index structure of a
+     * SparseMatrix, but only using a subinterval for the column indices,
+     * i.e., the entries of the destination vector. Since every column is
+     * handled by exactly one call, subranges can be processed concurrently.
+     */
+    template <typename number, typename InVector, typename OutVector>
+    void
+    Tvmult_on_subrange(const size_type    begin_col,
+                       const size_type    end_col,
+                       const number *     values,
+                       const std::size_t *colstart,
+                       const size_type *  rows,
+                       const std::size_t *entries,
+                       const InVector &   src,
+                       OutVector &        dst,
+                       const bool         add)
+    {
+      for (size_type col = begin_col; col < end_col; ++col)
+        {
+          typename OutVector::value_type s =
+            add ? typename OutVector::value_type(dst(col)) :
+                  typename OutVector::value_type();
+          for (std::size_t j = colstart[col]; j < colstart[col + 1]; ++j)
+            s += typename OutVector::value_type(values[entries[j]]) *
+                 typename OutVector::value_type(src(rows[j]));
+          dst(col) = s;
+        }
+    }
+
+
+
+    /**
+     * Perform a vmult with several vectors on a subinterval of the rows. The
+     * vectors are processed in groups of four, so that every entry of the
+     * matrix loaded from memory is used for four vectors. The products are
+     * summed up in the more accurate of the two number types, so that a
+     * matrix of doubles is not rounded when applied to vectors of floats.
+     */
+    template <typename number, typename somenumber>
+    void
+    vmult_multiple_on_subrange(
+      const size_type                                begin_row,
+      const size_type                                end_row,
+      const number *                                 values,
+      const std::size_t *                            rowstart,
+      const size_type *                              colnums,
+      const std::vector<const Vector<somenumber> *> &src,
+      const std::vector<Vector<somenumber> *> &      dst)
+    {
+      constexpr unsigned int group_size = 4;
+      for (unsigned int first = 0; first < src.size(); first += group_size)
+        {
+          const unsigned int n_vectors =
+            std::min<unsigned int>(group_size, src.size() - first);
+
+          const somenumber *src_ptr[group_size];
+          somenumber *      dst_ptr[group_size];
+          for (unsigned int c = 0; c < n_vectors; ++c)
+            {
+              src_ptr[c] = src[first + c]->begin();
+              dst_ptr[c] = dst[first + c]->begin();
+            }
+
+          using product_type = typename ProductType<number, somenumber>::type;
+          for (size_type row = begin_row; row < end_row; ++row)
+            {
+              product_type s[group_size] = {};
+              for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+                {
+                  const product_type value(values[j]);
+                  const size_type    column = colnums[j];
+                  for (unsigned int c = 0; c < n_vectors; ++c)
+                    s[c] += value * product_type(src_ptr[c][column]);
+                }
+              for (unsigned int c = 0; c < n_vectors; ++c)
+                dst_ptr[c][row] = static_cast<somenumber>(s[c]);
+            }
+        }
+    }
   } // namespace SparseMatrixImplementation
 } // namespace internal
 
@@ -805,6 +973,29 @@ SparseMatrix<number>::Tvmult(OutVector &dst, const InVector &src) const
 
   Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
 
+  if (use_transpose_cache)
+    {
+      prepare_transpose_cache();
+      parallel::apply_to_subranges(
+        0U,
+        n(),
+        [this, &src, &dst](const size_type begin_col,
+                           const size_type end_col) {
+          internal::SparseMatrixImplementation::Tvmult_on_subrange(
+            begin_col,
+            end_col,
+            val.get(),
+            transpose_colstart.data(),
+            transpose_rows.data(),
+            transpose_entries.data(),
+            src,
+            dst,
+            false);
+        },
+        internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+      return;
+    }
+
   dst = 0;
 
   for (size_type i = 0; i < m(); i++)
@@ -863,6 +1054,29 @@ SparseMatrix<number>::Tvmult_add(OutVector &dst, const InVector &src) const
 
   Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
 
+  if (use_transpose_cache)
+    {
+      prepare_transpose_cache();
+      parallel::apply_to_subranges(
+        0U,
+        n(),
+        [this, &src, &dst](const size_type begin_col,
+                           const size_type end_col) {
+          internal::SparseMatrixImplementation::Tvmult_on_subrange(
+            begin_col,
+            end_col,
+            val.get(),
+            transpose_colstart.data(),
+            transpose_rows.data(),
+            transpose_entries.data(),
+            src,
+            dst,
+            true);
+        },
+        internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+      return;
+    }
+
   for (size_type i = 0; i < m(); i++)
     for (size_type j = cols->rowstart[i]; j < cols->rowstart[i + 1]; j++)
       {
@@ -873,6 +1087,43 @@ SparseMatrix<number>::Tvmult_add(OutVector &dst, const InVector &src) const
 }
 
 
+
+template <typename number>
+template <typename somenumber>
+void
+SparseMatrix<number>::vmult_multiple(
+  const std::vector<Vector<somenumber> *> &      dst,
+  const std::vector<const Vector<somenumber> *> &src) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(val != nullptr, ExcNotInitialized());
+  AssertDimension(dst.size(), src.size());
+  for (unsigned int c = 0; c < src.size(); ++c)
+    {
+      Assert(m() == dst[c]->size(), ExcDimensionMismatch(m(), dst[c]->size()));
+      Assert(n() == src[c]->size(), ExcDimensionMismatch(n(), src[c]->size()));
+      for (unsigned int d = 0; d < dst.size(); ++d)
+        Assert(!PointerComparison::equal(src[c], dst[d]),
+               ExcSourceEqualsDestination());
+    }
+
+  parallel::apply_to_subranges(
+    0U,
+    m(),
+    [this, &src, &dst](const size_type begin_row, const size_type end_row) {
+      internal::SparseMatrixImplementation::vmult_multiple_on_subrange(
+        begin_row,
+        end_row,
+        val.get(),
+        cols->rowstart.get(),
+        cols->colnums.get(),
+        src,
+        dst);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
 namespace internal
 {
   namespace SparseMatrixImplementation
@@ -1566,6 +1817,73 @@ SparseMatrix<number>::precondition_SSOR(
 }
 
 
+template <typename number>
+template <typename somenumber>
+void
+SparseMatrix<number>::precondition_SSOR(
+  Vector<somenumber> &            dst,
+  const Vector<somenumber> &      src,
+  const number                    om,
+  const std::vector<std::size_t> &pos_right_of_diagonal,
+  const TriangularLevelSchedule & level_schedule) const
+{
+  if (level_schedule.empty() || pos_right_of_diagonal.size() == 0)
+    {
+      precondition_SSOR(dst, src, om, pos_right_of_diagonal);
+      return;
+    }
+
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(val != nullptr, ExcNotInitialized());
+  AssertDimension(m(), n());
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), n());
+  AssertDimension(pos_right_of_diagonal.size(), dst.size());
+
+  internal::SparseMatrixImplementation::AssertNoZerosOnDiagonal(*this);
+
+  // same sweeps as in the function above, but with the rows of each level
+  // of the forward and backward substitution processed concurrently
+  const std::size_t *rowstart = cols->rowstart.get();
+  const size_type *  colnums  = cols->colnums.get();
+  const number *     values   = val.get();
+
+  level_schedule.apply_forward([&](const size_type row) {
+    number s = 0;
+    for (std::size_t j = rowstart[row] + 1; j < pos_right_of_diagonal[row];
+         ++j)
+      s += values[j] * number(dst(colnums[j]));
+
+    somenumber dst_row = src(row);
+    dst_row -= s * om;
+    dst_row /= values[rowstart[row]];
+    dst(row) = dst_row;
+  });
+
+  parallel::apply_to_subranges(
+    0U,
+    n(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type row = begin; row < end; ++row)
+        dst(row) *= somenumber(om * (number(2.) - om)) *
+                    somenumber(values[rowstart[row]]);
+    },
+    internal::VectorImplementation::minimum_parallel_grain_size);
+
+  level_schedule.apply_backward([&](const size_type row) {
+    number s = 0;
+    for (std::size_t j = pos_right_of_diagonal[row]; j < rowstart[row + 1];
+         ++j)
+      s += values[j] * number(dst(colnums[j]));
+
+    somenumber dst_row = dst(row);
+    dst_row -= s * om;
+    dst_row /= values[rowstart[row]];
+    dst(row) = dst_row;
+  });
+}
+
+
 template <typename number>
 template <typename somenumber>
 void
@@ -2075,7 +2393,8 @@ template <typename number>
 std::size_t
 SparseMatrix<number>::memory_consumption() const
 {
-  return max_len * static_cast<std::size_t>(sizeof(number)) + sizeof(*this);
+  return max_len * static_cast<std::size_t>(sizeof(number)) + sizeof(*this) +
+         transpose_cache_memory_consumption();
 }
 
 
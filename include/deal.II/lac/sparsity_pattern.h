@@ -1117,6 +1117,23 @@ public:
   void
   copy_from(const SparsityPattern &sp);
 
+  /**
+   * Copy data from a list of rows, each given as a view to the column
+   * indices of that row. In contrast to the function taking a pair of
+   * iterators above, the column indices of each row must already be sorted
+   * and free of duplicates. This allows to set up the rows in parallel and
+   * without the sorting otherwise done in compress(). The views may point
+   * anywhere, for example into segments of one large array, so the caller
+   * does not need to allocate memory for each row.
+   *
+   * Previous content of this object is lost, and the sparsity pattern is in
+   * compressed mode afterwards.
+   */
+  void
+  copy_from(const size_type                                    n_rows,
+            const size_type                                    n_cols,
+            const ArrayView<const ArrayView<const size_type>> &sorted_rows);
+
   /**
    * Take a full matrix and use its nonzero entries to generate a sparse
    * matrix entry pattern for this object.
@@ -0,0 +1,230 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_triangular_level_schedule_h
+#define dealii_triangular_level_schedule_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/types.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+class SparsityPattern;
+#endif
+
+/*! @addtogroup Matrix1
+ *@{
+ */
+
+/**
+ * A level schedule of the rows of a square sparsity pattern for the forward
+ * and backward substitutions of triangular solves, as used in SparseILU and
+ * SSOR preconditioning.
+ *
+ * In a forward substitution, row $i$ can only be processed once all rows
+ * $j<i$ with an entry $(i,j)$ are done. The forward level of a row is the
+ * length of the longest chain of such dependencies ending in it; all rows of
+ * one level are independent of each other and can be processed
+ * concurrently, with the levels processed one after the other. The backward
+ * levels are defined the same way for the entries right of the diagonal and
+ * the substitution running from the last row to the first.
+ *
+ * Since every row still sees exactly the same values as in the sequential
+ * loop, a level-scheduled substitution gives the same result as the
+ * sequential one, bit by bit. The amount of parallelism depends on the
+ * numbering: finite element matrices numbered by DoFRenumbering::Cuthill_McKee
+ * have a level per wave front, other numberings may give fewer and larger
+ * levels. A level is only split among several threads if it has more rows
+ * than internal::SparseMatrixImplementation::minimum_parallel_grain_size,
+ * so small problems, whose levels are all below this size, run sequentially.
+ */
+class TriangularLevelSchedule
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Compute the forward and backward levels of the rows of @p sparsity,
+   * which must be square and compressed.
+   */
+  void
+  initialize(const SparsityPattern &sparsity);
+
+  /**
+   * Release all memory.
+   */
+  void
+  clear();
+
+  /**
+   * Return whether the schedule has been set up.
+   */
+  bool
+  empty() const;
+
+  /**
+   * Return the number of levels of the forward substitution.
+   */
+  unsigned int
+  n_forward_levels() const;
+
+  /**
+   * Return the number of levels of the backward substitution.
+   */
+  unsigned int
+  n_backward_levels() const;
+
+  /**
+   * Call @p worker with each row index in the order of the forward
+   * substitution: level by level, and within each level possibly in
+   * parallel.
+   */
+  template <typename Worker>
+  void
+  apply_forward(const Worker &worker) const;
+
+  /**
+   * Call @p worker with each row index in the order of the backward
+   * substitution.
+   */
+  template <typename Worker>
+  void
+  apply_backward(const Worker &worker) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Run @p worker on all rows of the given levels, one level after the
+   * other.
+   */
+  template <typename Worker>
+  static void
+  apply_levels(const std::vector<size_type> &level_start,
+               const std::vector<size_type> &rows,
+               const Worker &                worker);
+
+  /**
+   * Start of each forward level within #forward_rows, plus one past the
+   * end.
+   */
+  std::vector<size_type> forward_level_start;
+
+  /**
+   * Row indices sorted by forward level.
+   */
+  std::vector<size_type> forward_rows;
+
+  /**
+   * Start of each backward level within #backward_rows, plus one past the
+   * end.
+   */
+  std::vector<size_type> backward_level_start;
+
+  /**
+   * Row indices sorted by backward level.
+   */
+  std::vector<size_type> backward_rows;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+inline bool
+TriangularLevelSchedule::empty() const
+{
+  return forward_rows.empty();
+}
+
+
+
+inline unsigned int
+TriangularLevelSchedule::n_forward_levels() const
+{
+  return forward_level_start.empty() ? 0 : forward_level_start.size() - 1;
+}
+
+
+
+inline unsigned int
+TriangularLevelSchedule::n_backward_levels() const
+{
+  return backward_level_start.empty() ? 0 : backward_level_start.size() - 1;
+}
+
+
+
+template <typename Worker>
+inline void
+TriangularLevelSchedule::apply_levels(
+  const std::vector<size_type> &level_start,
+  const std::vector<size_type> &rows,
+  const Worker &                worker)
+{
+  // levels smaller than the grain size are run sequentially by
+  // apply_to_subranges without any scheduling overhead
+  for (unsigned int level = 0; level + 1 < level_start.size(); ++level)
+    parallel::apply_to_subranges(
+      level_start[level],
+      level_start[level + 1],
+      [&rows, &worker](const size_type begin, const size_type end) {
+        for (size_type i = begin; i < end; ++i)
+          worker(rows[i]);
+      },
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename Worker>
+inline void
+TriangularLevelSchedule::apply_forward(const Worker &worker) const
+{
+  apply_levels(forward_level_start, forward_rows, worker);
+}
+
+
+
+template <typename Worker>
+inline void
+TriangularLevelSchedule::apply_backward(const Worker &worker) const
+{
+  apply_levels(backward_level_start, backward_rows, worker);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
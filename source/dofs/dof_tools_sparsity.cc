@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -38,7 +39,7 @@
 #include <deal.II/hp/fe_values.h>
 #include <deal.II/hp/q_collection.h>
 
-#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/affine_constraints.templates.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparsity_pattern.h>
@@ -48,6 +49,7 @@
 #include <deal.II/numerics/vector_tools.h>
 
 #include <algorithm>
+#include <atomic>
 #include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
@@ -115,6 +117,253 @@ namespace DoFTools
 
 
 
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * An object that takes the place of a sparsity pattern in
+       * AffineConstraints::add_entries_local_to_global(), but only counts
+       * how many column indices are added to each row. Duplicates are
+       * counted as often as they are added. The counters are atomic, so
+       * several threads may add to the same row concurrently.
+       */
+      class RowLengthCounter
+      {
+      public:
+        RowLengthCounter(const types::global_dof_index           n_dofs,
+                         std::vector<std::atomic<unsigned int>> &row_lengths)
+          : n_dofs(n_dofs)
+          , row_lengths(row_lengths)
+        {}
+
+        types::global_dof_index
+        n_rows() const
+        {
+          return n_dofs;
+        }
+
+        types::global_dof_index
+        n_cols() const
+        {
+          return n_dofs;
+        }
+
+        void
+        add(const types::global_dof_index row, const types::global_dof_index)
+        {
+          row_lengths[row].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        template <typename ForwardIterator>
+        void
+        add_entries(const types::global_dof_index row,
+                    ForwardIterator               begin,
+                    ForwardIterator               end,
+                    const bool = false)
+        {
+          row_lengths[row].fetch_add(std::distance(begin, end),
+                                     std::memory_order_relaxed);
+        }
+
+      private:
+        const types::global_dof_index           n_dofs;
+        std::vector<std::atomic<unsigned int>> &row_lengths;
+      };
+
+
+
+      /**
+       * The counterpart of RowLengthCounter for the second pass: it writes
+       * the column indices added to a row into the segment of one large
+       * array that starts at <code>row_start[row]</code>. The position
+       * within the segment is claimed through an atomic counter per row.
+       */
+      class RowEntryWriter
+      {
+      public:
+        RowEntryWriter(const types::global_dof_index           n_dofs,
+                       const std::vector<std::size_t> &        row_start,
+                       std::vector<std::atomic<unsigned int>> &row_fill,
+                       types::global_dof_index *               columns)
+          : n_dofs(n_dofs)
+          , row_start(row_start)
+          , row_fill(row_fill)
+          , columns(columns)
+        {}
+
+        types::global_dof_index
+        n_rows() const
+        {
+          return n_dofs;
+        }
+
+        types::global_dof_index
+        n_cols() const
+        {
+          return n_dofs;
+        }
+
+        void
+        add(const types::global_dof_index row,
+            const types::global_dof_index col)
+        {
+          columns[row_start[row] +
+                  row_fill[row].fetch_add(1, std::memory_order_relaxed)] = col;
+        }
+
+        template <typename ForwardIterator>
+        void
+        add_entries(const types::global_dof_index row,
+                    ForwardIterator               begin,
+                    ForwardIterator               end,
+                    const bool = false)
+        {
+          const unsigned int n_entries = std::distance(begin, end);
+          std::copy(begin,
+                    end,
+                    columns + row_start[row] +
+                      row_fill[row].fetch_add(n_entries,
+                                              std::memory_order_relaxed));
+        }
+
+      private:
+        const types::global_dof_index           n_dofs;
+        const std::vector<std::size_t> &        row_start;
+        std::vector<std::atomic<unsigned int>> &row_fill;
+        types::global_dof_index *const          columns;
+      };
+
+
+
+      /**
+       * Add the couplings of all given cells to @p sparsity, which is one of
+       * the two classes above, splitting the cells among the threads.
+       */
+      template <typename CellIteratorType,
+                typename SparsityPatternType,
+                typename number>
+      void
+      add_cell_entries_in_parallel(
+        const std::vector<CellIteratorType> &cells,
+        const AffineConstraints<number> &    constraints,
+        const bool                           keep_constrained_dofs,
+        SparsityPatternType &                sparsity)
+      {
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          cells.size(),
+          [&](const std::size_t begin, const std::size_t end) {
+            std::vector<types::global_dof_index> dofs_on_this_cell;
+            for (std::size_t i = begin; i < end; ++i)
+              {
+                dofs_on_this_cell.resize(cells[i]->get_fe().dofs_per_cell);
+                cells[i]->get_dof_indices(dofs_on_this_cell);
+                constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                        sparsity,
+                                                        keep_constrained_dofs);
+              }
+          },
+          64);
+      }
+    } // namespace
+  }   // namespace internal
+
+
+
+  template <typename DoFHandlerType, typename number>
+  void
+  make_compressed_sparsity_pattern(
+    const DoFHandlerType &           dof,
+    SparsityPattern &                sparsity,
+    const AffineConstraints<number> &constraints,
+    const bool                       keep_constrained_dofs,
+    const types::subdomain_id        subdomain_id)
+  {
+    const types::global_dof_index n_dofs = dof.n_dofs();
+
+    Assert((dof.get_triangulation().locally_owned_subdomain() ==
+            numbers::invalid_subdomain_id) ||
+             (subdomain_id == numbers::invalid_subdomain_id) ||
+             (subdomain_id ==
+              dof.get_triangulation().locally_owned_subdomain()),
+           ExcMessage(
+             "For parallel::distributed::Triangulation objects and "
+             "associated DoF handler objects, asking for any subdomain other "
+             "than the locally owned one does not make sense."));
+
+    // collect the cells once so that both passes can split them among the
+    // threads
+    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+    cells.reserve(dof.get_triangulation().n_active_cells());
+    for (const auto &cell : dof.active_cell_iterators())
+      if (((subdomain_id == numbers::invalid_subdomain_id) ||
+           (subdomain_id == cell->subdomain_id())) &&
+          cell->is_locally_owned())
+        cells.push_back(cell);
+
+    // first pass: count the column indices each row receives, including
+    // duplicates
+    std::vector<std::atomic<unsigned int>> row_fill(n_dofs);
+    {
+      internal::RowLengthCounter counter(n_dofs, row_fill);
+      internal::add_cell_entries_in_parallel(cells,
+                                             constraints,
+                                             keep_constrained_dofs,
+                                             counter);
+    }
+
+    // reserve a segment of the right size for each row in one array, and
+    // reset the counters for use as fill positions
+    std::vector<std::size_t> row_start(n_dofs + 1);
+    row_start[0] = 0;
+    for (types::global_dof_index row = 0; row < n_dofs; ++row)
+      {
+        row_start[row + 1] =
+          row_start[row] + row_fill[row].load(std::memory_order_relaxed);
+        row_fill[row].store(0, std::memory_order_relaxed);
+      }
+    std::unique_ptr<types::global_dof_index[]> columns(
+      new types::global_dof_index[row_start[n_dofs]]);
+
+    // second pass: write the column indices into the segments
+    {
+      internal::RowEntryWriter writer(n_dofs,
+                                      row_start,
+                                      row_fill,
+                                      columns.get());
+      internal::add_cell_entries_in_parallel(cells,
+                                             constraints,
+                                             keep_constrained_dofs,
+                                             writer);
+    }
+
+    // sort each segment and strip the duplicates, leaving the unique entries
+    // at its beginning
+    std::vector<ArrayView<const types::global_dof_index>> rows(n_dofs);
+    parallel::apply_to_subranges(
+      types::global_dof_index(0),
+      n_dofs,
+      [&](const types::global_dof_index begin,
+          const types::global_dof_index end) {
+        for (types::global_dof_index row = begin; row < end; ++row)
+          {
+            types::global_dof_index *const first =
+              columns.get() + row_start[row];
+            types::global_dof_index *const last =
+              columns.get() + row_start[row + 1];
+            std::sort(first, last);
+            rows[row] = ArrayView<const types::global_dof_index>(
+              first, std::unique(first, last) - first);
+          }
+      },
+      1024);
+
+    sparsity.copy_from(n_dofs, n_dofs, make_array_view(rows));
+  }
+
+
+
   template <typename DoFHandlerType,
             typename SparsityPatternType,
             typename number>
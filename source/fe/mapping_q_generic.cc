@@ -45,6 +45,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -1511,6 +1512,241 @@ namespace internal
         return p_unit;
       }
 
+
+
+      /**
+       * Compute the location and the Jacobian of the mapping given by the
+       * support points @p points, in lexicographic numbering, at the points
+       * @p p_unit of the reference cell, one per lane of VectorizedArray. The
+       * one-dimensional shape functions are the Lagrange polynomials in the
+       * points @p nodes, with @p inverse_denominators holding the inverse of
+       * the product of the differences between one node and all others.
+       * @p values and @p derivatives are scratch arrays of size dim times the
+       * number of nodes.
+       */
+      template <int dim>
+      void
+      compute_mapped_location_and_jacobian(
+        const std::vector<Point<dim>> &             points,
+        const std::vector<double> &                 nodes,
+        const std::vector<double> &                 inverse_denominators,
+        const Point<dim, VectorizedArray<double>> & p_unit,
+        Table<2, VectorizedArray<double>> &         values,
+        Table<2, VectorizedArray<double>> &         derivatives,
+        Point<dim, VectorizedArray<double>> &       p_real,
+        Tensor<2, dim, VectorizedArray<double>> &   jacobian)
+      {
+        const unsigned int n_nodes = nodes.size();
+
+        for (unsigned int d = 0; d < dim; ++d)
+          for (unsigned int i = 0; i < n_nodes; ++i)
+            {
+              VectorizedArray<double> value      = 1.;
+              VectorizedArray<double> derivative = 0.;
+              for (unsigned int j = 0; j < n_nodes; ++j)
+                if (j != i)
+                  {
+                    derivative = derivative * (p_unit[d] - nodes[j]) + value;
+                    value      = value * (p_unit[d] - nodes[j]);
+                  }
+              values(d, i)      = value * inverse_denominators[i];
+              derivatives(d, i) = derivative * inverse_denominators[i];
+            }
+
+        p_real   = Point<dim, VectorizedArray<double>>();
+        jacobian = Tensor<2, dim, VectorizedArray<double>>();
+        for (unsigned int k = 0; k < points.size(); ++k)
+          {
+            unsigned int index[dim];
+            for (unsigned int d = 0, rest = k; d < dim; ++d, rest /= n_nodes)
+              index[d] = rest % n_nodes;
+
+            VectorizedArray<double> shape = values(0, index[0]);
+            for (unsigned int d = 1; d < dim; ++d)
+              shape *= values(d, index[d]);
+
+            Tensor<1, dim, VectorizedArray<double>> gradient;
+            for (unsigned int e = 0; e < dim; ++e)
+              {
+                gradient[e] = derivatives(e, index[e]);
+                for (unsigned int d = 0; d < dim; ++d)
+                  if (d != e)
+                    gradient[e] *= values(d, index[d]);
+              }
+
+            for (unsigned int c = 0; c < dim; ++c)
+              {
+                p_real[c] += points[k][c] * shape;
+                for (unsigned int e = 0; e < dim; ++e)
+                  jacobian[c][e] += points[k][c] * gradient[e];
+              }
+          }
+      }
+
+
+
+      /**
+       * Newton iteration for transform_points_real_to_unit_cell() in case
+       * dim==spacedim, run for as many points at once as there are lanes in
+       * VectorizedArray. The arguments are the support points of the cell in
+       * lexicographic numbering and the one-dimensional nodes of the mapping,
+       * and the affine approximation x = A p + b of the inverse mapping that
+       * serves as initial guess. There is no line search, so the iteration
+       * may fail to converge where the one of
+       * do_transform_real_to_unit_cell_internal() does. For these points, @p
+       * converged is set to false and the caller has to fall back to the
+       * latter.
+       */
+      template <int dim>
+      void
+      do_transform_points_real_to_unit_cell(
+        const std::vector<Point<dim>> &    points,
+        const std::vector<double> &        nodes,
+        const Tensor<2, dim> &             affine_matrix,
+        const Tensor<1, dim> &             affine_shift,
+        const ArrayView<const Point<dim>> &real_points,
+        const ArrayView<Point<dim>> &      unit_points,
+        std::vector<bool> &                converged)
+      {
+        const unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+        const unsigned int n_nodes = nodes.size();
+
+        std::vector<double> inverse_denominators(n_nodes, 1.);
+        for (unsigned int i = 0; i < n_nodes; ++i)
+          {
+            for (unsigned int j = 0; j < n_nodes; ++j)
+              if (j != i)
+                inverse_denominators[i] *= nodes[i] - nodes[j];
+            inverse_denominators[i] = 1. / inverse_denominators[i];
+          }
+
+        Table<2, VectorizedArray<double>> values(dim, n_nodes);
+        Table<2, VectorizedArray<double>> derivatives(dim, n_nodes);
+
+        // same tolerance and iteration limit as for a single point
+        const double       eps                    = 1.e-11;
+        const unsigned int newton_iteration_limit = 20;
+
+        for (unsigned int begin = 0; begin < real_points.size();
+             begin += n_lanes)
+          {
+            // fill lanes beyond the last point with copies of it
+            const unsigned int n_active =
+              std::min<unsigned int>(n_lanes, real_points.size() - begin);
+
+            Point<dim, VectorizedArray<double>> p;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              for (unsigned int d = 0; d < dim; ++d)
+                p[d][v] = real_points[begin + std::min(v, n_active - 1)][d];
+
+            // as for a single point, start from the affine approximation
+            // projected into the reference cell
+            Point<dim, VectorizedArray<double>> p_unit;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                p_unit[d] = affine_shift[d];
+                for (unsigned int e = 0; e < dim; ++e)
+                  p_unit[d] += affine_matrix[d][e] * p[e];
+                p_unit[d] = std::max(std::min(p_unit[d],
+                                              make_vectorized_array(1.)),
+                                     make_vectorized_array(0.));
+              }
+
+            bool lane_converged[n_lanes];
+            bool lane_done[n_lanes];
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              lane_converged[v] = lane_done[v] = (v >= n_active);
+
+            for (unsigned int iteration = 0;
+                 iteration < newton_iteration_limit &&
+                 std::find(lane_done, lane_done + n_lanes, false) !=
+                   lane_done + n_lanes;
+                 ++iteration)
+              {
+                Point<dim, VectorizedArray<double>>     p_real;
+                Tensor<2, dim, VectorizedArray<double>> jacobian;
+                compute_mapped_location_and_jacobian(points,
+                                                     nodes,
+                                                     inverse_denominators,
+                                                     p_unit,
+                                                     values,
+                                                     derivatives,
+                                                     p_real,
+                                                     jacobian);
+                Tensor<1, dim, VectorizedArray<double>> residual = p_real - p;
+
+                // lanes that are done or whose Jacobian is not invertible
+                // get a unit Jacobian and zero residual, so that they do not
+                // produce floating point exceptions
+                const VectorizedArray<double> det = determinant(jacobian);
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  if (lane_done[v] || !(det[v] > 0.))
+                    {
+                      lane_done[v] = true;
+                      for (unsigned int d = 0; d < dim; ++d)
+                        {
+                          residual[d][v] = 0.;
+                          for (unsigned int e = 0; e < dim; ++e)
+                            jacobian[d][e][v] = (d == e) ? 1. : 0.;
+                        }
+                    }
+
+                const Tensor<1, dim, VectorizedArray<double>> delta =
+                  invert(jacobian) * residual;
+                p_unit -= delta;
+
+                // the norm of the Newton update is the norm of the residual
+                // in the metric of the Jacobian, as for a single point
+                const VectorizedArray<double> delta_norm_square =
+                  delta.norm_square();
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  if (!lane_done[v])
+                    {
+                      if (delta_norm_square[v] < eps * eps)
+                        lane_converged[v] = lane_done[v] = true;
+                      else
+                        // points far away from the reference cell diverge,
+                        // rather than converge to large coordinates
+                        for (unsigned int d = 0; d < dim; ++d)
+                          if (!(std::abs(p_unit[d][v]) < 1e3))
+                            {
+                              lane_done[v] = true;
+                              for (unsigned int e = 0; e < dim; ++e)
+                                p_unit[e][v] = 0.5;
+                              break;
+                            }
+                    }
+              }
+
+            for (unsigned int v = 0; v < n_active; ++v)
+              {
+                for (unsigned int d = 0; d < dim; ++d)
+                  unit_points[begin + v][d] = p_unit[d][v];
+                converged[begin + v] = lane_converged[v];
+              }
+          }
+      }
+
+
+
+      /**
+       * The Newton iteration above is only written for dim==spacedim. This
+       * overload is selected otherwise and must not be called.
+       */
+      template <int dim, int spacedim>
+      void
+      do_transform_points_real_to_unit_cell(
+        const std::vector<Point<spacedim>> &,
+        const std::vector<double> &,
+        const Tensor<2, dim> &,
+        const Tensor<1, dim> &,
+        const ArrayView<const Point<spacedim>> &,
+        const ArrayView<Point<dim>> &,
+        std::vector<bool> &)
+      {
+        Assert(false, ExcInternalError());
+      }
+
       /**
        * In case the quadrature formula is a tensor product, this is a
        * replacement for maybe_compute_q_points(), maybe_update_Jacobians() and
@@ -2662,6 +2898,100 @@ MappingQGeneric<dim, spacedim>::transform_real_to_unit_cell(
 
 
 
+
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>> &                    real_points,
+  const ArrayView<Point<dim>> &unit_points) const
+{
+  // the vectorized Newton iteration is only implemented for dim==spacedim,
+  // and needs the affine approximation of the cell iterator as initial
+  // guess
+  if (dim != spacedim || !this->preserves_vertex_locations())
+    {
+      Mapping<dim, spacedim>::transform_points_real_to_unit_cell(cell,
+                                                                 real_points,
+                                                                 unit_points);
+      return;
+    }
+
+  AssertDimension(real_points.size(), unit_points.size());
+  if (real_points.size() == 0)
+    return;
+
+  // compute the support points only once for all points, and bring them
+  // into lexicographic order for the evaluation as tensor product
+  const std::vector<Point<spacedim>> support_points =
+    this->compute_mapping_support_points(cell);
+  const std::vector<unsigned int> renumber(
+    FETools::lexicographic_to_hierarchic_numbering(FiniteElementData<dim>(
+      internal::MappingQGenericImplementation::get_dpo_vector<dim>(
+        polynomial_degree),
+      1,
+      polynomial_degree)));
+  std::vector<Point<spacedim>> lexicographic_points(support_points.size());
+  for (unsigned int i = 0; i < support_points.size(); ++i)
+    lexicographic_points[i] = support_points[renumber[i]];
+
+  std::vector<double> nodes(line_support_points.size());
+  for (unsigned int i = 0; i < nodes.size(); ++i)
+    nodes[i] = line_support_points.point(i)[0];
+
+  // the affine approximation of the cell is an affine function of the
+  // point, so evaluate it at dim+1 points to get its matrix and shift
+  const double          h      = cell->diameter();
+  const Point<spacedim> origin = cell->vertex(0);
+  const Point<dim>      unit_origin =
+    cell->real_to_unit_cell_affine_approximation(origin);
+  Tensor<2, dim> affine_matrix;
+  for (unsigned int e = 0; e < dim; ++e)
+    {
+      Point<spacedim> shifted = origin;
+      shifted[e] += h;
+      const Point<dim> unit_shifted =
+        cell->real_to_unit_cell_affine_approximation(shifted);
+      for (unsigned int d = 0; d < dim; ++d)
+        affine_matrix[d][e] = (unit_shifted[d] - unit_origin[d]) / h;
+    }
+  Tensor<1, dim> affine_shift;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      affine_shift[d] = unit_origin[d];
+      for (unsigned int e = 0; e < dim; ++e)
+        affine_shift[d] -= affine_matrix[d][e] * origin[e];
+    }
+
+  std::vector<bool> converged(real_points.size());
+  internal::MappingQGenericImplementation::
+    do_transform_points_real_to_unit_cell<dim>(lexicographic_points,
+                                               nodes,
+                                               affine_matrix,
+                                               affine_shift,
+                                               real_points,
+                                               unit_points,
+                                               converged);
+
+  // use the more robust iteration with line search for the points for
+  // which the one without did not converge
+  for (unsigned int i = 0; i < real_points.size(); ++i)
+    if (!converged[i])
+      {
+        try
+          {
+            unit_points[i] = transform_real_to_unit_cell(cell, real_points[i]);
+          }
+        catch (const typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+          {
+            unit_points[i]    = Point<dim>();
+            unit_points[i][0] = std::numeric_limits<double>::infinity();
+          }
+      }
+}
+
+
+
 template <int dim, int spacedim>
 UpdateFlags
 MappingQGeneric<dim, spacedim>::requires_update_flags(
@@ -13,6 +13,9 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/thread_management.h>
+
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
 
@@ -4541,26 +4544,63 @@ namespace GridGenerator
     const double                  duplicated_vertex_tolerance,
     const bool                    copy_manifold_ids)
   {
-    std::vector<Point<spacedim>> vertices;
-    std::vector<CellData<dim>>   cells;
-    SubCellData                  subcell_data;
-
-    unsigned int n_accumulated_vertices = 0;
+    // get the descriptions of the input triangulations in parallel, along
+    // with the vertices at their boundaries. a vertex in the interior of one
+    // input triangulation can not coincide with a vertex of another one
+    // without the two overlapping, so only boundary vertices need to be
+    // considered when merging duplicated vertices
+    const unsigned int n_triangulations = triangulations.size();
+    std::vector<std::tuple<std::vector<Point<spacedim>>,
+                           std::vector<CellData<dim>>,
+                           SubCellData>>
+                                   descriptions(n_triangulations);
+    std::vector<std::vector<bool>> at_boundary(n_triangulations);
+
+    Threads::TaskGroup<> tasks;
+    unsigned int         t = 0;
     for (const auto triangulation : triangulations)
       {
         Assert(triangulation->n_levels() == 1,
                ExcMessage("The input triangulations must be non-empty "
                           "and must not be refined."));
 
-        std::vector<Point<spacedim>> tria_vertices;
-        std::vector<CellData<dim>>   tria_cells;
-        SubCellData                  tria_subcell_data;
-        std::tie(tria_vertices, tria_cells, tria_subcell_data) =
-          GridTools::get_coarse_mesh_description(*triangulation);
+        tasks += Threads::new_task([&, triangulation, t]() {
+          descriptions[t] =
+            GridTools::get_coarse_mesh_description(*triangulation);
+
+          at_boundary[t].resize(std::get<0>(descriptions[t]).size(), false);
+          for (const auto &cell : triangulation->active_cell_iterators())
+            for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+              if (cell->face(f)->at_boundary())
+                for (unsigned int v = 0;
+                     v < GeometryInfo<dim>::vertices_per_face;
+                     ++v)
+                  at_boundary[t][cell->face(f)->vertex_index(v)] = true;
+        });
+        ++t;
+      }
+    tasks.join_all();
+
+    std::vector<Point<spacedim>> vertices;
+    std::vector<CellData<dim>>   cells;
+    SubCellData                  subcell_data;
+    std::vector<unsigned int>    considered_vertices;
+
+    unsigned int n_accumulated_vertices = 0;
+    for (t = 0; t < n_triangulations; ++t)
+      {
+        std::vector<Point<spacedim>> &tria_vertices =
+          std::get<0>(descriptions[t]);
+        std::vector<CellData<dim>> &tria_cells = std::get<1>(descriptions[t]);
+        SubCellData &tria_subcell_data = std::get<2>(descriptions[t]);
 
         vertices.insert(vertices.end(),
                         tria_vertices.begin(),
                         tria_vertices.end());
+        for (unsigned int v = 0; v < tria_vertices.size(); ++v)
+          if (at_boundary[t][v])
+            considered_vertices.push_back(n_accumulated_vertices + v);
+
         for (CellData<dim> &cell_data : tria_cells)
           {
             for (unsigned int &vertex_n : cell_data.vertices)
@@ -4594,16 +4634,20 @@ namespace GridGenerator
               }
           }
 
-        n_accumulated_vertices += triangulation->n_vertices();
+        n_accumulated_vertices += tria_vertices.size();
       }
 
-    // throw out duplicated vertices
-    std::vector<unsigned int> considered_vertices;
-    GridTools::delete_duplicated_vertices(vertices,
-                                          cells,
-                                          subcell_data,
-                                          considered_vertices,
-                                          duplicated_vertex_tolerance);
+    // throw out duplicated vertices. an empty list of vertices to consider
+    // would make the function consider all of them, but without boundary
+    // vertices there is nothing to merge
+    if (considered_vertices.size() > 0)
+      GridTools::delete_duplicated_vertices(vertices,
+                                            cells,
+                                            subcell_data,
+                                            considered_vertices,
+                                            duplicated_vertex_tolerance);
+    else
+      GridTools::delete_unused_vertices(vertices, cells, subcell_data);
 
     // reorder the cells to ensure that they satisfy the convention for
     // edge and face directions
@@ -5463,6 +5507,144 @@ namespace GridGenerator
 
 
 
+  namespace
+  {
+    /**
+     * Return the table whose entry (i,j) is the index of the vertex of a
+     * surface cell that corresponds to the j-th vertex of the i-th face of
+     * the underlying volume cell. If e.g. face 3 of a volume cell is
+     * considered and vertices 1 and 2 of the corresponding surface cell are
+     * swapped to get proper normal orientation, row 3 is (0, 2, 1, 3).
+     */
+    template <int dim>
+    Table<2, unsigned int>
+    boundary_mesh_vertex_permutation()
+    {
+      Table<2, unsigned int> swap_matrix(
+        GeometryInfo<dim>::faces_per_cell,
+        GeometryInfo<dim - 1>::vertices_per_cell);
+      for (unsigned int i1 = 0; i1 < GeometryInfo<dim>::faces_per_cell; i1++)
+        for (unsigned int i2 = 0; i2 < GeometryInfo<dim - 1>::vertices_per_cell;
+             i2++)
+          swap_matrix[i1][i2] = i2;
+
+      // vertex swapping such that normals on the surface mesh point out of
+      // the underlying volume
+      if (dim == 3)
+        {
+          std::swap(swap_matrix[0][1], swap_matrix[0][2]);
+          std::swap(swap_matrix[2][1], swap_matrix[2][2]);
+          std::swap(swap_matrix[4][1], swap_matrix[4][2]);
+        }
+      else if (dim == 2)
+        {
+          std::swap(swap_matrix[1][0], swap_matrix[1][1]);
+          std::swap(swap_matrix[2][0], swap_matrix[2][1]);
+        }
+
+      return swap_matrix;
+    }
+
+
+
+    /**
+     * Set up the vertices, cells and, in 3d, boundary lines of a coarse
+     * surface mesh that consists of the given faces of a volume mesh, each
+     * given by an iterator to the face and the number of the face within its
+     * cell. The surface cells are in the order of @p faces, and the surface
+     * vertices in the order in which the faces first reference them.
+     *
+     * Vertices and edges shared between faces are identified through arrays
+     * indexed by the vertex and line indices of the volume mesh rather than
+     * by searching, and the cells are filled in parallel.
+     */
+    template <int dim, int spacedim, typename FaceIterator>
+    void
+    build_boundary_mesh_description(
+      const Triangulation<dim, spacedim> &                      volume_tria,
+      const std::vector<std::pair<FaceIterator, unsigned int>> &faces,
+      std::vector<Point<spacedim>> &                            vertices,
+      std::vector<CellData<dim - 1>> &                          cells,
+      SubCellData &                                             subcell_data)
+    {
+      const unsigned int boundary_dim = dim - 1;
+
+      const Table<2, unsigned int> swap_matrix =
+        boundary_mesh_vertex_permutation<dim>();
+
+      // volume vertex indices to surface ones
+      std::vector<unsigned int> surface_vertex_index(
+        volume_tria.n_vertices(), numbers::invalid_unsigned_int);
+      for (const auto &face : faces)
+        for (unsigned int j = 0;
+             j < GeometryInfo<boundary_dim>::vertices_per_cell;
+             ++j)
+          {
+            const unsigned int v_index = face.first->vertex_index(j);
+            if (surface_vertex_index[v_index] == numbers::invalid_unsigned_int)
+              {
+                surface_vertex_index[v_index] = vertices.size();
+                vertices.push_back(face.first->vertex(j));
+              }
+          }
+
+      cells.resize(faces.size());
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(faces.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int f = begin; f < end; ++f)
+            {
+              const FaceIterator &face = faces[f].first;
+              for (unsigned int j = 0;
+                   j < GeometryInfo<boundary_dim>::vertices_per_cell;
+                   ++j)
+                cells[f].vertices[swap_matrix[faces[f].second][j]] =
+                  surface_vertex_index[face->vertex_index(j)];
+              cells[f].material_id =
+                static_cast<types::material_id>(face->boundary_id());
+              cells[f].manifold_id = face->manifold_id();
+            }
+        },
+        256);
+
+      // in 3d, we need to make sure we copy the manifold indicators from the
+      // edges of the volume mesh to the edges of the surface mesh. edges of
+      // a single selected face get the default boundary id, edges shared by
+      // two of them numbers::internal_face_boundary_id
+      if (dim == 3)
+        {
+          std::vector<unsigned int> boundary_line_index(
+            volume_tria.n_raw_lines(), numbers::invalid_unsigned_int);
+          for (const auto &face : faces)
+            for (unsigned int e = 0;
+                 e < GeometryInfo<boundary_dim>::lines_per_cell;
+                 ++e)
+              {
+                const auto    line  = face.first->line(e);
+                unsigned int &index = boundary_line_index[line->index()];
+                if (index != numbers::invalid_unsigned_int)
+                  {
+                    subcell_data.boundary_lines[index].boundary_id =
+                      numbers::internal_face_boundary_id;
+                    continue;
+                  }
+
+                index = subcell_data.boundary_lines.size();
+
+                CellData<1> edge;
+                edge.vertices[0] = surface_vertex_index[line->vertex_index(0)];
+                edge.vertices[1] = surface_vertex_index[line->vertex_index(1)];
+                edge.boundary_id = 0;
+                edge.manifold_id = line->manifold_id();
+                subcell_data.boundary_lines.push_back(edge);
+              }
+        }
+    }
+  } // namespace
+
+
+
   template <template <int, int> class MeshType, int dim, int spacedim>
 #ifndef _MSC_VER
   std::map<typename MeshType<dim - 1, spacedim>::cell_iterator,
@@ -5484,9 +5666,6 @@ namespace GridGenerator
     //    preserve the order of cells passed in using the CellData argument;
     //    also, that it will not reorder the vertices.
 
-    // dimension of the boundary mesh
-    const unsigned int boundary_dim = dim - 1;
-
     // temporary map for level==0
     // iterator to face is stored along with face number
     // (this is required by the algorithm to adjust the normals of the
@@ -5495,50 +5674,11 @@ namespace GridGenerator
       std::pair<typename MeshType<dim, spacedim>::face_iterator, unsigned int>>
       temporary_mapping_level0;
 
-    // vector indicating whether a vertex of the volume mesh has
-    // already been visited (necessary to avoid duplicate vertices in
-    // boundary mesh)
-    std::vector<bool> touched(volume_mesh.get_triangulation().n_vertices(),
-                              false);
-
-    // data structures required for creation of boundary mesh
-    std::vector<CellData<boundary_dim>> cells;
-    SubCellData                         subcell_data;
-    std::vector<Point<spacedim>>        vertices;
-
-    // volume vertex indices to surf ones
-    std::map<unsigned int, unsigned int> map_vert_index;
-
-    // define swapping of vertices to get proper normal orientation of boundary
-    // mesh;
     // the entry (i,j) of swap_matrix stores the index of the vertex of
     // the boundary cell corresponding to the j-th vertex on the i-th face
     // of the underlying volume cell
-    // if e.g. face 3 of a volume cell is considered and vertices 1 and 2 of the
-    // corresponding boundary cell are swapped to get
-    // proper normal orientation, swap_matrix[3]=( 0, 2, 1, 3 )
-    Table<2, unsigned int> swap_matrix(
-      GeometryInfo<spacedim>::faces_per_cell,
-      GeometryInfo<dim - 1>::vertices_per_cell);
-    for (unsigned int i1 = 0; i1 < GeometryInfo<spacedim>::faces_per_cell; i1++)
-      {
-        for (unsigned int i2 = 0; i2 < GeometryInfo<dim - 1>::vertices_per_cell;
-             i2++)
-          swap_matrix[i1][i2] = i2;
-      }
-    // vertex swapping such that normals on the surface mesh point out of the
-    // underlying volume
-    if (dim == 3)
-      {
-        std::swap(swap_matrix[0][1], swap_matrix[0][2]);
-        std::swap(swap_matrix[2][1], swap_matrix[2][2]);
-        std::swap(swap_matrix[4][1], swap_matrix[4][2]);
-      }
-    else if (dim == 2)
-      {
-        std::swap(swap_matrix[1][0], swap_matrix[1][1]);
-        std::swap(swap_matrix[2][0], swap_matrix[2][1]);
-      }
+    const Table<2, unsigned int> swap_matrix =
+      boundary_mesh_vertex_permutation<dim>();
 
     // Create boundary mesh and mapping
     // from only level(0) cells of volume_mesh
@@ -5554,80 +5694,19 @@ namespace GridGenerator
           if (face->at_boundary() &&
               (boundary_ids.empty() ||
                (boundary_ids.find(face->boundary_id()) != boundary_ids.end())))
-            {
-              CellData<boundary_dim> c_data;
-
-              for (unsigned int j = 0;
-                   j < GeometryInfo<boundary_dim>::vertices_per_cell;
-                   ++j)
-                {
-                  const unsigned int v_index = face->vertex_index(j);
-
-                  if (!touched[v_index])
-                    {
-                      vertices.push_back(face->vertex(j));
-                      map_vert_index[v_index] = vertices.size() - 1;
-                      touched[v_index]        = true;
-                    }
-
-                  c_data.vertices[swap_matrix[i][j]] = map_vert_index[v_index];
-                }
-              c_data.material_id =
-                static_cast<types::material_id>(face->boundary_id());
-              c_data.manifold_id = face->manifold_id();
-
-
-              // in 3d, we need to make sure we copy the manifold
-              // indicators from the edges of the volume mesh to the
-              // edges of the surface mesh
-              //
-              // we set default boundary ids for boundary lines
-              // and numbers::internal_face_boundary_id for internal lines
-              if (dim == 3)
-                for (unsigned int e = 0; e < 4; ++e)
-                  {
-                    // see if we already saw this edge from a
-                    // neighboring face, either in this or the reverse
-                    // orientation. if so, skip it.
-                    {
-                      bool edge_found = false;
-                      for (auto &boundary_line : subcell_data.boundary_lines)
-                        if (((boundary_line.vertices[0] ==
-                              map_vert_index[face->line(e)->vertex_index(0)]) &&
-                             (boundary_line.vertices[1] ==
-                              map_vert_index[face->line(e)->vertex_index(
-                                1)])) ||
-                            ((boundary_line.vertices[0] ==
-                              map_vert_index[face->line(e)->vertex_index(1)]) &&
-                             (boundary_line.vertices[1] ==
-                              map_vert_index[face->line(e)->vertex_index(0)])))
-                          {
-                            boundary_line.boundary_id =
-                              numbers::internal_face_boundary_id;
-                            edge_found = true;
-                            break;
-                          }
-                      if (edge_found == true)
-                        // try next edge of current face
-                        continue;
-                    }
-
-                    CellData<1> edge;
-                    edge.vertices[0] =
-                      map_vert_index[face->line(e)->vertex_index(0)];
-                    edge.vertices[1] =
-                      map_vert_index[face->line(e)->vertex_index(1)];
-                    edge.boundary_id = 0;
-                    edge.manifold_id = face->line(e)->manifold_id();
-
-                    subcell_data.boundary_lines.push_back(edge);
-                  }
-
-              cells.push_back(c_data);
-              temporary_mapping_level0.push_back(std::make_pair(face, i));
-            }
+            temporary_mapping_level0.push_back(std::make_pair(face, i));
         }
 
+    // data structures required for creation of boundary mesh
+    std::vector<CellData<dim - 1>> cells;
+    SubCellData                    subcell_data;
+    std::vector<Point<spacedim>>   vertices;
+    build_boundary_mesh_description(volume_mesh.get_triangulation(),
+                                    temporary_mapping_level0,
+                                    vertices,
+                                    cells,
+                                    subcell_data);
+
     // create level 0 surface triangulation
     Assert(cells.size() > 0, ExcMessage("No boundary faces selected"));
     const_cast<Triangulation<dim - 1, spacedim> &>(
@@ -5750,6 +5829,76 @@ namespace GridGenerator
     return surface_to_volume_mapping;
   }
 
+
+
+  template <int dim, int spacedim>
+  std::map<typename Triangulation<dim - 1, spacedim>::cell_iterator,
+           typename Triangulation<dim, spacedim>::face_iterator>
+  extract_active_boundary_mesh(
+    const Triangulation<dim, spacedim> &volume_mesh,
+    Triangulation<dim - 1, spacedim> &  surface_mesh,
+    const std::set<types::boundary_id> &boundary_ids)
+  {
+    Assert((dynamic_cast<
+              const parallel::distributed::Triangulation<dim, spacedim> *>(
+              &volume_mesh) == nullptr),
+           ExcNotImplemented());
+
+    std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::face_iterator,
+                unsigned int>>
+      boundary_faces;
+    for (const auto &cell : volume_mesh.active_cell_iterators())
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        {
+          const typename Triangulation<dim, spacedim>::face_iterator face =
+            cell->face(f);
+
+          if (face->at_boundary() &&
+              (boundary_ids.empty() ||
+               (boundary_ids.find(face->boundary_id()) != boundary_ids.end())))
+            {
+              // the surface mesh is a coarse mesh, which can not have
+              // hanging nodes
+              if (dim == 3)
+                for (unsigned int e = 0;
+                     e < GeometryInfo<dim - 1>::lines_per_cell;
+                     ++e)
+                  Assert(!face->line(e)->has_children(),
+                         ExcMessage("The selected boundary faces of the "
+                                    "volume mesh must not have hanging "
+                                    "nodes."));
+
+              boundary_faces.push_back(std::make_pair(face, f));
+            }
+        }
+    Assert(boundary_faces.size() > 0, ExcMessage("No boundary faces selected"));
+
+    std::vector<CellData<dim - 1>> cells;
+    SubCellData                    subcell_data;
+    std::vector<Point<spacedim>>   vertices;
+    build_boundary_mesh_description(
+      volume_mesh, boundary_faces, vertices, cells, subcell_data);
+
+    surface_mesh.create_triangulation(vertices, cells, subcell_data);
+
+    // in 2d: set default boundary ids for "boundary vertices"
+    if (dim == 2)
+      for (const auto &cell : surface_mesh.active_cell_iterators())
+        for (unsigned int vertex = 0; vertex < 2; vertex++)
+          if (cell->face(vertex)->at_boundary())
+            cell->face(vertex)->set_boundary_id(0);
+
+    // create_triangulation() preserves the order of the cells
+    std::map<typename Triangulation<dim - 1, spacedim>::cell_iterator,
+             typename Triangulation<dim, spacedim>::face_iterator>
+      surface_to_volume_mapping;
+    for (const auto &cell : surface_mesh.active_cell_iterators())
+      surface_to_volume_mapping[cell] = boundary_faces[cell->index()].first;
+
+    return surface_to_volume_mapping;
+  }
+
 } // namespace GridGenerator
 
 // explicit instantiations
@@ -15,6 +15,7 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/utilities.h>
 
@@ -26,9 +27,13 @@
 #include <boost/io/ios_state.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <functional>
+#include <iterator>
 #include <map>
 
 
@@ -91,6 +96,530 @@ namespace
     // vertices except in 1d
     Assert(dim != 1, ExcInternalError());
   }
+
+
+
+  /**
+   * Create @p triangulation from the vertices, cells, and boundary
+   * information read from a Gmsh file, in either the ASCII or the binary
+   * variant of the format.
+   */
+  template <int dim, int spacedim>
+  void
+  create_triangulation_from_msh(
+    std::vector<Point<spacedim>> &                    vertices,
+    std::vector<CellData<dim>> &                      cells,
+    SubCellData &                                     subcelldata,
+    const std::map<unsigned int, types::boundary_id> &boundary_ids_1d,
+    Triangulation<dim, spacedim> &                    triangulation)
+  {
+    // do some clean-up on
+    // vertices...
+    GridTools::delete_unused_vertices(vertices, cells, subcelldata);
+    // ... and cells
+    if (dim == spacedim)
+      GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
+                                                                       cells);
+    GridReordering<dim, spacedim>::reorder_cells(cells);
+    triangulation.create_triangulation_compatibility(vertices,
+                                                     cells,
+                                                     subcelldata);
+
+    // in 1d, we also have to attach boundary ids to vertices, which does not
+    // currently work through the call above
+    if (dim == 1)
+      assign_1d_boundary_ids(boundary_ids_1d, triangulation);
+  }
+
+
+
+  /**
+   * A cursor into the content of a Gmsh file in the binary variant of
+   * version 4.1 of the format, starting right after the $MeshFormat
+   * section. Section markers are text, the data in between is binary: ints
+   * have four bytes, and node and element tags as well as all counters are
+   * written as <tt>size_t</tt>, i.e., with eight bytes.
+   */
+  class GmshBinaryBuffer
+  {
+  public:
+    explicit GmshBinaryBuffer(std::istream &in)
+    {
+      // read everything that is left in the stream at once, if the stream
+      // allows us to find out how much that is
+      const std::streampos begin = in.tellg();
+      std::streampos       end   = -1;
+      if (begin != std::streampos(-1))
+        {
+          in.seekg(0, std::ios::end);
+          end = in.tellg();
+          in.seekg(begin);
+        }
+      if (end != std::streampos(-1))
+        {
+          data.resize(end - begin);
+          in.read(data.data(), data.size());
+        }
+      else
+        {
+          in.clear();
+          data.assign(std::istreambuf_iterator<char>(in),
+                      std::istreambuf_iterator<char>());
+        }
+      AssertThrow(!in.bad(), ExcIO());
+      position = 0;
+    }
+
+    template <typename T>
+    T
+    read()
+    {
+      T t;
+      std::memcpy(&t, pointer(sizeof(T)), sizeof(T));
+      position += sizeof(T);
+      return t;
+    }
+
+    /**
+     * Return a pointer to the current position and move past @p n_bytes
+     * bytes.
+     */
+    const char *
+    skip(const std::size_t n_bytes)
+    {
+      const char *p = pointer(n_bytes);
+      position += n_bytes;
+      return p;
+    }
+
+    /**
+     * Read the next section marker such as <tt>$Nodes</tt>, or return an
+     * empty string at the end of the file. The binary data of a section
+     * starts right after the line break that ends its marker, and may
+     * itself start with bytes that look like whitespace, so only this one
+     * line break is skipped.
+     */
+    std::string
+    read_marker()
+    {
+      while (position < data.size() &&
+             std::isspace(static_cast<unsigned char>(data[position])))
+        ++position;
+      const std::size_t begin = position;
+      while (position < data.size() &&
+             !std::isspace(static_cast<unsigned char>(data[position])))
+        ++position;
+      const std::string marker(data.data() + begin, data.data() + position);
+
+      if (position < data.size() && data[position] == '\r')
+        ++position;
+      if (position < data.size() && data[position] == '\n')
+        ++position;
+      return marker;
+    }
+
+    /**
+     * Move past the end marker of the section @p name, without looking at
+     * its content.
+     */
+    void
+    skip_section(const std::string &name)
+    {
+      const std::string end_marker = "$End" + name;
+      const auto        section_end =
+        std::search(data.begin() + position,
+                    data.end(),
+                    end_marker.begin(),
+                    end_marker.end());
+      AssertThrow(section_end != data.end(),
+                  ExcMessage("Missing " + end_marker));
+      position = (section_end - data.begin()) + end_marker.size();
+    }
+
+  private:
+    const char *
+    pointer(const std::size_t n_bytes) const
+    {
+      AssertThrow(position + n_bytes <= data.size(),
+                  ExcMessage("Unexpected end of binary Gmsh file."));
+      return data.data() + position;
+    }
+
+    std::vector<char> data;
+    std::size_t       position;
+  };
+
+
+
+  /**
+   * Read an unaligned value of type @p T from @p p.
+   */
+  template <typename T>
+  inline T
+  read_unaligned(const char *p)
+  {
+    T t;
+    std::memcpy(&t, p, sizeof(T));
+    return t;
+  }
+
+
+
+  /**
+   * Read the content of a binary Gmsh 4.1 file after the $MeshFormat
+   * section into the arrays read_msh() builds a triangulation from.
+   *
+   * The sections are first scanned serially, which only requires reading
+   * the headers of the entity blocks since all entries of a block have the
+   * same size. The nodes and elements of each block are then converted in
+   * parallel. Instead of a map, node tags are translated into vertex
+   * indices through an array indexed by the tag, whose range the file
+   * provides. The parallel loops do not throw: they only record that they
+   * found an invalid entry, and the exception is thrown after they have
+   * finished.
+   */
+  template <int dim, int spacedim>
+  void
+  read_msh_binary(std::istream &                              in,
+                  std::vector<Point<spacedim>> &              vertices,
+                  std::vector<CellData<dim>> &                cells,
+                  SubCellData &                               subcelldata,
+                  std::map<unsigned int, types::boundary_id> &boundary_ids_1d)
+  {
+    using Reader = GridIn<dim, spacedim>;
+
+    GmshBinaryBuffer buffer(in);
+
+    // the maps from entities to physical tags, as in read_msh()
+    std::array<std::map<int, int>, 4> tag_maps;
+
+    std::uint64_t             min_node_tag = 0;
+    std::vector<unsigned int> node_tag_to_vertex;
+    bool                      found_elements = false;
+
+    // the vertex index of a node, or numbers::invalid_unsigned_int if the
+    // file does not contain a node with this tag
+    const auto find_vertex = [&](const std::uint64_t node_tag) {
+      const std::uint64_t offset = node_tag - min_node_tag;
+      return (node_tag >= min_node_tag && offset < node_tag_to_vertex.size()) ?
+               node_tag_to_vertex[offset] :
+               numbers::invalid_unsigned_int;
+    };
+
+    const auto vertex_of_node = [&](const std::uint64_t node_tag,
+                                    const unsigned int  cell,
+                                    const std::uint64_t element_tag) {
+      const unsigned int vertex = find_vertex(node_tag);
+      AssertThrow(vertex != numbers::invalid_unsigned_int,
+                  typename Reader::ExcInvalidVertexIndexGmsh(cell,
+                                                             element_tag,
+                                                             node_tag));
+      return vertex;
+    };
+
+    for (std::string marker = buffer.read_marker(); marker != "";
+         marker             = buffer.read_marker())
+      {
+        AssertThrow(marker[0] == '$',
+                    typename Reader::ExcInvalidGMSHInput(marker));
+        if (marker == "$Entities")
+          {
+            std::uint64_t n_entities[4];
+            for (auto &n : n_entities)
+              n = buffer.read<std::uint64_t>();
+            for (unsigned int entity_dim = 0; entity_dim < 4; ++entity_dim)
+              for (std::uint64_t i = 0; i < n_entities[entity_dim]; ++i)
+                {
+                  const int tag = buffer.read<int>();
+                  // points have their coordinates, all others a bounding box
+                  buffer.skip((entity_dim == 0 ? 3 : 6) * sizeof(double));
+                  const std::uint64_t n_physicals =
+                    buffer.read<std::uint64_t>();
+                  AssertThrow(n_physicals < 2,
+                              ExcMessage(
+                                "More than one tag is not supported!"));
+                  // if there is no physical tag, use 0 as default
+                  int physical_tag = 0;
+                  for (std::uint64_t j = 0; j < n_physicals; ++j)
+                    physical_tag = buffer.read<int>();
+                  tag_maps[entity_dim][tag] = physical_tag;
+                  // skip the lower-dimensional entities bounding this one
+                  if (entity_dim > 0)
+                    buffer.skip(buffer.read<std::uint64_t>() * sizeof(int));
+                }
+            AssertThrow(buffer.read_marker() == "$EndEntities",
+                        typename Reader::ExcInvalidGMSHInput(marker));
+          }
+        else if (marker == "$Nodes")
+          {
+            const std::uint64_t n_blocks     = buffer.read<std::uint64_t>();
+            const std::uint64_t n_nodes      = buffer.read<std::uint64_t>();
+            min_node_tag                     = buffer.read<std::uint64_t>();
+            const std::uint64_t max_node_tag = buffer.read<std::uint64_t>();
+
+            vertices.resize(n_nodes);
+            node_tag_to_vertex.assign(n_nodes > 0 ?
+                                        max_node_tag - min_node_tag + 1 :
+                                        0,
+                                      numbers::invalid_unsigned_int);
+
+            unsigned int first_vertex = 0;
+            for (std::uint64_t block = 0; block < n_blocks; ++block)
+              {
+                const int entity_dim = buffer.read<int>();
+                buffer.read<int>(); // entity tag
+                const int           parametric = buffer.read<int>();
+                const std::uint64_t n_block_nodes =
+                  buffer.read<std::uint64_t>();
+                AssertThrow(first_vertex + n_block_nodes <= n_nodes,
+                            ExcMessage("The number of nodes in the blocks of "
+                                       "the binary Gmsh file does not match "
+                                       "the total number of nodes."));
+
+                // parametric coordinates, if present, follow the three
+                // cartesian ones of each node
+                const unsigned int n_coordinates =
+                  3 + (parametric != 0 ? entity_dim : 0);
+                const char *tags = buffer.skip(n_block_nodes * 8);
+                const char *coordinates =
+                  buffer.skip(n_block_nodes * n_coordinates * sizeof(double));
+
+                std::atomic<bool> invalid_tag(false);
+                parallel::apply_to_subranges(
+                  0UL,
+                  static_cast<unsigned long>(n_block_nodes),
+                  [&](const unsigned long begin, const unsigned long end) {
+                    for (unsigned long i = begin; i < end; ++i)
+                      {
+                        const std::uint64_t tag =
+                          read_unaligned<std::uint64_t>(tags + 8 * i);
+                        if (tag < min_node_tag || tag > max_node_tag)
+                          {
+                            invalid_tag = true;
+                            continue;
+                          }
+                        node_tag_to_vertex[tag - min_node_tag] =
+                          first_vertex + i;
+                        for (unsigned int d = 0; d < spacedim; ++d)
+                          vertices[first_vertex + i][d] =
+                            read_unaligned<double>(
+                              coordinates +
+                              sizeof(double) * (n_coordinates * i + d));
+                      }
+                  },
+                  4096);
+                AssertThrow(!invalid_tag,
+                            ExcMessage("Node tag out of the range given in "
+                                       "the binary Gmsh file."));
+                first_vertex += n_block_nodes;
+              }
+            AssertDimension(first_vertex, n_nodes);
+            AssertThrow(buffer.read_marker() == "$EndNodes",
+                        typename Reader::ExcInvalidGMSHInput(marker));
+          }
+        else if (marker == "$Elements")
+          {
+            const std::uint64_t n_blocks = buffer.read<std::uint64_t>();
+            buffer.read<std::uint64_t>(); // number of elements
+            buffer.read<std::uint64_t>(); // minimal element tag
+            buffer.read<std::uint64_t>(); // maximal element tag
+
+            // a block of elements of the same type, and where to put them
+            struct ElementBlock
+            {
+              int           type;
+              unsigned int  id;
+              std::uint64_t n_elements;
+              const char *  data;
+              std::size_t   first;
+            };
+            std::vector<ElementBlock> blocks;
+            std::size_t               n_cells = 0, n_lines = 0, n_quads = 0;
+
+            for (std::uint64_t block = 0; block < n_blocks; ++block)
+              {
+                // note that the dimension comes before the tag
+                const int entity_dim = buffer.read<int>();
+                const int entity_tag = buffer.read<int>();
+                const int cell_type  = buffer.read<int>();
+                const std::uint64_t n_elements = buffer.read<std::uint64_t>();
+                AssertThrow(entity_dim >= 0 && entity_dim < 4,
+                            ExcMessage("Invalid entity dimension in binary "
+                                       "Gmsh file."));
+
+                // the number of nodes of each element, which we need to
+                // know to skip the block. the types are the same as
+                // in read_msh()
+                unsigned int n_nodes = 0;
+                std::size_t *counter = nullptr;
+                switch (cell_type)
+                  {
+                    case 1:
+                      n_nodes = 2;
+                      counter = (dim == 1 ? &n_cells : &n_lines);
+                      break;
+                    case 3:
+                      n_nodes = 4;
+                      AssertThrow(dim >= 2,
+                                  typename Reader::ExcGmshUnsupportedGeometry(
+                                    cell_type));
+                      counter = (dim == 2 ? &n_cells : &n_quads);
+                      break;
+                    case 5:
+                      n_nodes = 8;
+                      AssertThrow(dim == 3,
+                                  typename Reader::ExcGmshUnsupportedGeometry(
+                                    cell_type));
+                      counter = &n_cells;
+                      break;
+                    case 15:
+                      n_nodes = 1;
+                      break;
+                    default:
+                      AssertThrow(cell_type != 2,
+                                  ExcMessage(
+                                    "Found triangles while reading a file "
+                                    "in gmsh format. deal.II does not "
+                                    "support triangles"));
+                      AssertThrow(cell_type != 11,
+                                  ExcMessage(
+                                    "Found tetrahedra while reading a file "
+                                    "in gmsh format. deal.II does not "
+                                    "support tetrahedra"));
+                      AssertThrow(false,
+                                  typename Reader::ExcGmshUnsupportedGeometry(
+                                    cell_type));
+                  }
+
+                const std::size_t first = (counter != nullptr ? *counter : 0);
+                if (counter != nullptr)
+                  *counter += n_elements;
+
+                blocks.push_back(
+                  {cell_type,
+                   static_cast<unsigned int>(tag_maps[entity_dim][entity_tag]),
+                   n_elements,
+                   buffer.skip(n_elements * (1 + n_nodes) * 8),
+                   first});
+              }
+            AssertThrow(buffer.read_marker() == "$EndElements",
+                        typename Reader::ExcInvalidGMSHInput(marker));
+
+            cells.resize(n_cells);
+            subcelldata.boundary_lines.resize(n_lines);
+            subcelldata.boundary_quads.resize(n_quads);
+
+            for (const ElementBlock &block : blocks)
+              {
+                // we use only material_ids in the range from 0 to
+                // numbers::invalid_material_id-1, and boundary_ids in the
+                // range from 0 to numbers::internal_face_boundary_id-1
+                const unsigned int id = block.id;
+                Assert(id < numbers::invalid_material_id,
+                       ExcIndexRange(id, 0, numbers::invalid_material_id));
+                Assert(id < numbers::internal_face_boundary_id,
+                       ExcIndexRange(id,
+                                     0,
+                                     numbers::internal_face_boundary_id));
+
+                // points only carry boundary indicators in 1d, where
+                // vertices are faces
+                if (block.type == 15)
+                  {
+                    if (dim == 1)
+                      for (std::uint64_t i = 0; i < block.n_elements; ++i)
+                        boundary_ids_1d[vertex_of_node(
+                          read_unaligned<std::uint64_t>(block.data + 16 * i +
+                                                        8),
+                          i,
+                          read_unaligned<std::uint64_t>(block.data +
+                                                        16 * i))] = id;
+                    continue;
+                  }
+
+                // set the vertices of one object from the data of its
+                // element in the file, and remember if one of its nodes
+                // does not exist
+                std::atomic<bool> invalid_node(false);
+                const auto        set_vertices =
+                  [&](unsigned int *      object_vertices,
+                      const unsigned int  n_nodes,
+                      const std::uint64_t i) {
+                    const char *element = block.data + 8 * (1 + n_nodes) * i;
+                    for (unsigned int v = 0; v < n_nodes; ++v)
+                      {
+                        object_vertices[v] = find_vertex(
+                          read_unaligned<std::uint64_t>(element + 8 * (1 + v)));
+                        if (object_vertices[v] == numbers::invalid_unsigned_int)
+                          invalid_node = true;
+                      }
+                  };
+
+                parallel::apply_to_subranges(
+                  0UL,
+                  static_cast<unsigned long>(block.n_elements),
+                  [&](const unsigned long begin, const unsigned long end) {
+                    for (unsigned long i = begin; i < end; ++i)
+                      if ((block.type == 1 && dim == 1) ||
+                          (block.type == 3 && dim == 2) ||
+                          (block.type == 5 && dim == 3))
+                        {
+                          CellData<dim> &cell = cells[block.first + i];
+                          set_vertices(cell.vertices,
+                                       GeometryInfo<dim>::vertices_per_cell,
+                                       i);
+                          cell.material_id =
+                            static_cast<types::material_id>(id);
+                        }
+                      else if (block.type == 1)
+                        {
+                          CellData<1> &line =
+                            subcelldata.boundary_lines[block.first + i];
+                          set_vertices(line.vertices, 2, i);
+                          line.boundary_id =
+                            static_cast<types::boundary_id>(id);
+                        }
+                      else
+                        {
+                          CellData<2> &quad =
+                            subcelldata.boundary_quads[block.first + i];
+                          set_vertices(quad.vertices, 4, i);
+                          quad.boundary_id =
+                            static_cast<types::boundary_id>(id);
+                        }
+                  },
+                  4096);
+
+                // if there was an invalid node, find the first element
+                // that refers to it to report it
+                if (invalid_node)
+                  {
+                    const unsigned int n_nodes =
+                      (block.type == 1 ? 2 : (block.type == 3 ? 4 : 8));
+                    for (std::uint64_t i = 0; i < block.n_elements; ++i)
+                      {
+                        const char *element =
+                          block.data + 8 * (1 + n_nodes) * i;
+                        for (unsigned int v = 0; v < n_nodes; ++v)
+                          vertex_of_node(read_unaligned<std::uint64_t>(
+                                           element + 8 * (1 + v)),
+                                         i,
+                                         read_unaligned<std::uint64_t>(
+                                           element));
+                      }
+                    Assert(false, ExcInternalError());
+                  }
+              }
+            found_elements = true;
+          }
+        else
+          // sections such as $PhysicalNames or $PartitionedEntities that
+          // we do not need
+          buffer.skip_section(marker.substr(1));
+      }
+
+    AssertThrow(found_elements, typename Reader::ExcGmshNoCellInformation());
+  }
 } // namespace
 
 template <int dim, int spacedim>
@@ -1439,6 +1968,37 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       Assert((version >= 2.0) && (version <= 4.1), ExcNotImplemented());
       gmsh_file_format = static_cast<unsigned int>(version * 10);
 
+      if (file_type == 1)
+        {
+          AssertThrow(gmsh_file_format == 41,
+                      ExcMessage("Only version 4.1 of the binary Gmsh "
+                                 "format is supported."));
+          AssertThrow(data_size == sizeof(double), ExcNotImplemented());
+
+          // the header is followed by the integer one, which tells us
+          // whether the file was written with the same byte order
+          in.get();
+          int one = 0;
+          in.read(reinterpret_cast<char *>(&one), sizeof(one));
+          AssertThrow(one == 1,
+                      ExcMessage("The binary Gmsh file was written on a "
+                                 "machine with a different byte order."));
+          in >> line;
+          AssertThrow(line == "$EndMeshFormat", ExcInvalidGMSHInput(line));
+
+          std::vector<Point<spacedim>>               vertices;
+          std::vector<CellData<dim>>                 cells;
+          SubCellData                                subcelldata;
+          std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+          read_msh_binary(in, vertices, cells, subcelldata, boundary_ids_1d);
+
+          AssertThrow(cells.size() > 0, ExcGmshNoCellInformation());
+
+          create_triangulation_from_msh(
+            vertices, cells, subcelldata, boundary_ids_1d, *tria);
+          return;
+        }
+
       Assert(file_type == 0, ExcNotImplemented());
       Assert(data_size == sizeof(double), ExcNotImplemented());
 
@@ -2017,20 +2577,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   // cells.
   AssertThrow(cells.size() > 0, ExcGmshNoCellInformation());
 
-  // do some clean-up on
-  // vertices...
-  GridTools::delete_unused_vertices(vertices, cells, subcelldata);
-  // ... and cells
-  if (dim == spacedim)
-    GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
-                                                                     cells);
-  GridReordering<dim, spacedim>::reorder_cells(cells);
-  tria->create_triangulation_compatibility(vertices, cells, subcelldata);
-
-  // in 1d, we also have to attach boundary ids to vertices, which does not
-  // currently work through the call above
-  if (dim == 1)
-    assign_1d_boundary_ids(boundary_ids_1d, *tria);
+  create_triangulation_from_msh(
+    vertices, cells, subcelldata, boundary_ids_1d, *tria);
 }
 
 
@@ -3356,8 +3904,6 @@ GridIn<dim, spacedim>::read(const std::string &filename, Format format)
   else
     name = search.find(filename, default_suffix(format));
 
-  std::ifstream in(name.c_str());
-
   if (format == Default)
     {
       const std::string::size_type slashpos = name.find_last_of('/');
@@ -3369,6 +3915,11 @@ GridIn<dim, spacedim>::read(const std::string &filename, Format format)
           format          = parse_format(ext);
         }
     }
+
+  // Gmsh files may contain binary data
+  std::ifstream in(name.c_str(),
+                   format == msh ? std::ios::in | std::ios::binary :
+                                   std::ios::in);
   if (format == netcdf)
     read_netcdf(filename);
   else
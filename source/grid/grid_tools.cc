@@ -57,10 +57,13 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <list>
+#include <map>
 #include <numeric>
 #include <set>
 #include <tuple>
@@ -842,6 +845,101 @@ namespace GridTools
 
 
 
+  namespace internal
+  {
+    template <int spacedim>
+    PointBucketGrid<spacedim>::PointBucketGrid(
+      const std::vector<Point<spacedim>> &points,
+      const double                        tolerance)
+      : bucket_width(2. * tolerance)
+    {
+      if (points.size() == 0)
+        return;
+
+      // choose the width of the buckets from the tolerance, but make sure
+      // that the integer coordinates of the buckets stay within a range
+      // that can be represented exactly
+      Point<spacedim> upper_corner = points[0];
+      origin                       = points[0];
+      for (const Point<spacedim> &p : points)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            origin[d]       = std::min(origin[d], p[d]);
+            upper_corner[d] = std::max(upper_corner[d], p[d]);
+          }
+      for (unsigned int d = 0; d < spacedim; ++d)
+        bucket_width =
+          std::max(bucket_width, (upper_corner[d] - origin[d]) / (1ull << 40));
+      if (!(bucket_width > 0.))
+        bucket_width = 1.;
+
+      sorted_points.resize(points.size());
+      for (unsigned int i = 0; i < points.size(); ++i)
+        sorted_points[i] = std::make_pair(bucket_of(points[i]), i);
+      std::sort(sorted_points.begin(), sorted_points.end());
+    }
+
+
+
+    template <int spacedim>
+    typename PointBucketGrid<spacedim>::BucketIndex
+    PointBucketGrid<spacedim>::bucket_of(const Point<spacedim> &point) const
+    {
+      // points far outside the bounding box are clamped: they can not be
+      // close to any of the points anyway
+      const double max_coordinate = static_cast<double>(1ull << 50);
+      BucketIndex  bucket;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          const double coordinate = (point[d] - origin[d]) / bucket_width;
+          bucket[d]               = static_cast<std::int64_t>(std::floor(
+            std::max(-max_coordinate, std::min(max_coordinate, coordinate))));
+        }
+      return bucket;
+    }
+
+
+
+    template <int spacedim>
+    void
+    PointBucketGrid<spacedim>::get_candidates(
+      const Point<spacedim> &    point,
+      std::vector<unsigned int> &candidates) const
+    {
+      candidates.clear();
+      if (sorted_points.size() == 0)
+        return;
+
+      const BucketIndex center = bucket_of(point);
+
+      unsigned int n_neighbors = 1;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        n_neighbors *= 3;
+
+      const auto compare_buckets =
+        [](const std::pair<BucketIndex, unsigned int> &a,
+           const std::pair<BucketIndex, unsigned int> &b) {
+          return a.first < b.first;
+        };
+      for (unsigned int n = 0; n < n_neighbors; ++n)
+        {
+          std::pair<BucketIndex, unsigned int> neighbor(center, 0);
+          for (unsigned int d = 0, offset = n; d < spacedim; ++d, offset /= 3)
+            neighbor.first[d] += static_cast<int>(offset % 3) - 1;
+
+          const auto range = std::equal_range(sorted_points.begin(),
+                                              sorted_points.end(),
+                                              neighbor,
+                                              compare_buckets);
+          for (auto it = range.first; it != range.second; ++it)
+            candidates.push_back(it->second);
+        }
+      std::sort(candidates.begin(), candidates.end());
+    }
+  } // namespace internal
+
+
+
   template <int dim, int spacedim>
   void
   delete_duplicated_vertices(std::vector<Point<spacedim>> &vertices,
@@ -865,12 +963,25 @@ namespace GridTools
     Assert(considered_vertices.size() <= vertices.size(), ExcInternalError());
 
 
+    // sort the vertices to be considered into buckets, so that we only
+    // need to compare with the vertices in neighboring buckets rather than
+    // with all others
+    std::vector<Point<spacedim>> considered_points;
+    considered_points.reserve(considered_vertices.size());
+    for (const unsigned int v : considered_vertices)
+      {
+        Assert(v < vertices.size(), ExcInternalError());
+        considered_points.push_back(vertices[v]);
+      }
+    const internal::PointBucketGrid<spacedim> bucket_grid(considered_points,
+                                                          tol);
+    std::vector<unsigned int> candidates;
+
     // now loop over all vertices to be
     // considered and try to find an identical
     // one
     for (unsigned int i = 0; i < considered_vertices.size(); ++i)
       {
-        Assert(considered_vertices[i] < vertices.size(), ExcInternalError());
         if (new_vertex_numbers[considered_vertices[i]] !=
             considered_vertices[i])
           // this vertex has been identified with
@@ -879,12 +990,16 @@ namespace GridTools
           continue;
         // this vertex is not identified with
         // another one so far. search in the list
-        // of remaining vertices. if a duplicate
-        // vertex is found, set the new vertex
-        // index for that vertex to this vertex'
-        // index.
-        for (unsigned int j = i + 1; j < considered_vertices.size(); ++j)
+        // of remaining vertices close to it. if a
+        // duplicate vertex is found, set the new
+        // vertex index for that vertex to this
+        // vertex' index.
+        bucket_grid.get_candidates(considered_points[i], candidates);
+        for (const unsigned int j : candidates)
           {
+            if (j <= i)
+              continue;
+
             bool equal = true;
             for (unsigned int d = 0; d < spacedim; ++d)
               equal &= (std::abs(vertices[considered_vertices[j]](d) -
@@ -916,6 +1031,140 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+  void
+  reorder_hilbert(std::vector<Point<spacedim>> &vertices,
+                  std::vector<CellData<dim>> &  cells,
+                  SubCellData &                 subcelldata)
+  {
+    if (cells.size() == 0)
+      return;
+
+    // sort the cells by the position of their centers along a Hilbert curve.
+    // use a stable sort so that cells with the same index keep their
+    // relative order
+    std::vector<Point<spacedim>> centers(cells.size());
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      {
+        for (const unsigned int v : cells[c].vertices)
+          {
+            AssertIndexRange(v, vertices.size());
+            centers[c] += vertices[v];
+          }
+        centers[c] /= GeometryInfo<dim>::vertices_per_cell;
+      }
+    const std::vector<std::array<std::uint64_t, spacedim>> hilbert_indices =
+      Utilities::inverse_Hilbert_space_filling_curve(centers);
+
+    std::vector<unsigned int> cell_order(cells.size());
+    std::iota(cell_order.begin(), cell_order.end(), 0u);
+    std::stable_sort(cell_order.begin(),
+                     cell_order.end(),
+                     [&hilbert_indices](const unsigned int a,
+                                        const unsigned int b) {
+                       return hilbert_indices[a] < hilbert_indices[b];
+                     });
+
+    std::vector<CellData<dim>> sorted_cells;
+    sorted_cells.reserve(cells.size());
+    for (const unsigned int c : cell_order)
+      sorted_cells.push_back(cells[c]);
+    cells.swap(sorted_cells);
+
+    // then number the vertices in the order in which the sorted cells use
+    // them for the first time. vertices that are not used by any cell go
+    // last and keep their relative order
+    std::vector<unsigned int> new_vertex_numbers(vertices.size(),
+                                                 numbers::invalid_unsigned_int);
+    unsigned int              next_vertex_number = 0;
+    for (const auto &cell : cells)
+      for (const unsigned int v : cell.vertices)
+        if (new_vertex_numbers[v] == numbers::invalid_unsigned_int)
+          new_vertex_numbers[v] = next_vertex_number++;
+    for (unsigned int &number : new_vertex_numbers)
+      if (number == numbers::invalid_unsigned_int)
+        number = next_vertex_number++;
+
+    for (auto &cell : cells)
+      for (auto &vertex_index : cell.vertices)
+        vertex_index = new_vertex_numbers[vertex_index];
+    for (auto &quad : subcelldata.boundary_quads)
+      for (auto &vertex_index : quad.vertices)
+        {
+          AssertIndexRange(vertex_index, vertices.size());
+          vertex_index = new_vertex_numbers[vertex_index];
+        }
+    for (auto &line : subcelldata.boundary_lines)
+      for (auto &vertex_index : line.vertices)
+        {
+          AssertIndexRange(vertex_index, vertices.size());
+          vertex_index = new_vertex_numbers[vertex_index];
+        }
+
+    std::vector<Point<spacedim>> sorted_vertices(vertices.size());
+    for (unsigned int v = 0; v < vertices.size(); ++v)
+      sorted_vertices[new_vertex_numbers[v]] = vertices[v];
+    vertices.swap(sorted_vertices);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  reorder_hilbert(Triangulation<dim, spacedim> &triangulation)
+  {
+    Assert((dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+              &triangulation) == nullptr),
+           ExcNotImplemented());
+    Assert(triangulation.n_levels() == 1, ExcTriangulationHasBeenRefined());
+
+    std::vector<Point<spacedim>> vertices;
+    std::vector<CellData<dim>>   cells;
+    SubCellData                  subcelldata;
+    std::tie(vertices, cells, subcelldata) =
+      get_coarse_mesh_description(triangulation);
+
+    // in 1d, the boundary indicators of vertices are not part of the coarse
+    // mesh description. store them together with the location of the
+    // vertex, which does not change
+    std::vector<std::pair<Point<spacedim>, types::boundary_id>>
+      boundary_vertices;
+    if (dim == 1)
+      for (const auto &cell : triangulation.active_cell_iterators())
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if (cell->face(f)->at_boundary())
+            boundary_vertices.emplace_back(cell->face(f)->vertex(0),
+                                           cell->face(f)->boundary_id());
+
+    // the manifold objects are deleted along with the triangulation, so
+    // keep copies of them
+    std::map<types::manifold_id, std::unique_ptr<Manifold<dim, spacedim>>>
+      manifolds;
+    for (const types::manifold_id manifold_id :
+         triangulation.get_manifold_ids())
+      if (manifold_id != numbers::flat_manifold_id)
+        manifolds[manifold_id] =
+          triangulation.get_manifold(manifold_id).clone();
+
+    reorder_hilbert(vertices, cells, subcelldata);
+
+    triangulation.clear();
+    triangulation.create_triangulation(vertices, cells, subcelldata);
+
+    for (const auto &manifold : manifolds)
+      triangulation.set_manifold(manifold.first, *manifold.second);
+
+    if (dim == 1)
+      for (const auto &cell : triangulation.active_cell_iterators())
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if (cell->face(f)->at_boundary())
+            for (const auto &boundary_vertex : boundary_vertices)
+              if (cell->face(f)->vertex(0) == boundary_vertex.first)
+                cell->face(f)->set_boundary_id(boundary_vertex.second);
+  }
+
+
+
   // define some transformations in an anonymous namespace
   namespace
   {
@@ -4818,6 +5067,230 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+#ifndef DOXYGEN
+  std::tuple<
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>,
+    std::vector<std::vector<Point<dim>>>,
+    std::vector<std::vector<unsigned int>>,
+    std::vector<unsigned int>>
+#else
+  return_type
+#endif
+  batched_compute_point_locations(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points)
+  {
+    using cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    const unsigned int np = points.size();
+
+    std::vector<cell_iterator>             cells_out;
+    std::vector<std::vector<Point<dim>>>   qpoints_out;
+    std::vector<std::vector<unsigned int>> maps_out;
+    std::vector<unsigned int>              missing_points_out;
+
+    if (np == 0)
+      return std::make_tuple(std::move(cells_out),
+                             std::move(qpoints_out),
+                             std::move(maps_out),
+                             std::move(missing_points_out));
+
+    const auto &b_tree  = cache.get_cell_bounding_boxes_rtree();
+    const auto &mapping = cache.get_mapping();
+
+    // Sort the points along a Morton curve: quantize their coordinates
+    // within the bounding box of all points to 21 bits, so that the keys of
+    // all dimensions fit into 64 bits, and interleave the bits of the
+    // coordinates
+    const unsigned int n_bits         = 21;
+    const double       max_coordinate = (1U << n_bits) - 1;
+    Point<spacedim>    lower          = points[0];
+    Point<spacedim>    upper          = points[0];
+    for (const auto &point : points)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          lower[d] = std::min(lower[d], point[d]);
+          upper[d] = std::max(upper[d], point[d]);
+        }
+
+    std::vector<std::pair<std::uint64_t, unsigned int>> morton_order(np);
+    for (unsigned int i = 0; i < np; ++i)
+      {
+        std::uint64_t key = 0;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            const double        extent = upper[d] - lower[d];
+            const std::uint64_t coordinate =
+              (extent > 0. ? static_cast<std::uint64_t>(
+                               (points[i][d] - lower[d]) / extent *
+                               max_coordinate) :
+                             0);
+            for (unsigned int b = 0; b < n_bits; ++b)
+              key |= ((coordinate >> b) & 1) << (b * spacedim + d);
+          }
+        morton_order[i] = std::make_pair(key, i);
+      }
+    std::sort(morton_order.begin(), morton_order.end());
+
+    // Collect the candidate cells of groups of consecutive points with one
+    // query to the rtree, and keep the ones whose bounding box contains the
+    // point. Start with the cells whose bounding box has its center closest
+    // to the point
+    const unsigned int                      group_size = 16;
+    std::vector<std::vector<cell_iterator>> candidates(np);
+    std::vector<std::pair<BoundingBox<spacedim>, cell_iterator>> box_cell;
+    std::vector<std::pair<double, cell_iterator>> sorted_candidates;
+    for (unsigned int begin = 0; begin < np; begin += group_size)
+      {
+        const unsigned int end = std::min(np, begin + group_size);
+
+        std::pair<Point<spacedim>, Point<spacedim>> group_corners(
+          points[morton_order[begin].second],
+          points[morton_order[begin].second]);
+        for (unsigned int i = begin + 1; i < end; ++i)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              const Point<spacedim> &point = points[morton_order[i].second];
+              group_corners.first[d] =
+                std::min(group_corners.first[d], point[d]);
+              group_corners.second[d] =
+                std::max(group_corners.second[d], point[d]);
+            }
+
+        box_cell.clear();
+        b_tree.query(boost::geometry::index::intersects(
+                       BoundingBox<spacedim>(group_corners)),
+                     std::back_inserter(box_cell));
+
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            const unsigned int     index = morton_order[i].second;
+            const Point<spacedim> &point = points[index];
+
+            sorted_candidates.clear();
+            for (const auto &entry : box_cell)
+              if (!entry.second->is_artificial() &&
+                  entry.first.point_inside(point))
+                {
+                  const auto &corners = entry.first.get_boundary_points();
+                  sorted_candidates.emplace_back(
+                    point.distance_square(
+                      Point<spacedim>((corners.first + corners.second) / 2.)),
+                    entry.second);
+                }
+            std::sort(sorted_candidates.begin(),
+                      sorted_candidates.end(),
+                      [](const std::pair<double, cell_iterator> &a,
+                         const std::pair<double, cell_iterator> &b) {
+                        return a.first < b.first;
+                      });
+
+            candidates[index].reserve(sorted_candidates.size());
+            for (const auto &candidate : sorted_candidates)
+              candidates[index].push_back(candidate.second);
+          }
+      }
+
+    // Try the candidates in rounds: in every round, each point not yet
+    // found is grouped with the other points that have the same next
+    // candidate cell, and all of them are transformed to the reference cell
+    // at once
+    std::vector<cell_iterator> found_cells(np);
+    std::vector<Point<dim>>    found_points(np);
+    std::vector<bool>          found(np, false);
+
+    std::map<cell_iterator, std::vector<unsigned int>> points_per_cell;
+    std::vector<Point<spacedim>>                       real_points;
+    std::vector<Point<dim>>                            unit_points;
+    for (unsigned int round = 0;; ++round)
+      {
+        points_per_cell.clear();
+        for (const auto &entry : morton_order)
+          if (!found[entry.second] &&
+              round < candidates[entry.second].size())
+            points_per_cell[candidates[entry.second][round]].push_back(
+              entry.second);
+
+        if (points_per_cell.empty())
+          break;
+
+        for (const auto &cell_and_points : points_per_cell)
+          {
+            const std::vector<unsigned int> &indices = cell_and_points.second;
+            real_points.resize(indices.size());
+            unit_points.resize(indices.size());
+            for (unsigned int i = 0; i < indices.size(); ++i)
+              real_points[i] = points[indices[i]];
+
+            mapping.transform_points_real_to_unit_cell(
+              cell_and_points.first,
+              make_array_view(real_points),
+              make_array_view(unit_points));
+
+            // use the same tolerance as find_active_cell_around_point()
+            for (unsigned int i = 0; i < indices.size(); ++i)
+              if (GeometryInfo<dim>::is_inside_unit_cell(unit_points[i],
+                                                         1e-10))
+                {
+                  found[indices[i]]        = true;
+                  found_cells[indices[i]]  = cell_and_points.first;
+                  found_points[indices[i]] = unit_points[i];
+                }
+          }
+      }
+
+    // The bounding boxes of the mapping should contain all points of their
+    // cell. Points not found so far are either outside of the mesh, or in
+    // cells whose bounding boxes are not accurate; fall back to the search
+    // for a single point for them
+    for (unsigned int i = 0; i < np; ++i)
+      if (!found[i])
+        {
+          try
+            {
+              const auto cell_and_point =
+                GridTools::find_active_cell_around_point(cache, points[i]);
+              if (!cell_and_point.first->is_artificial())
+                {
+                  found[i]        = true;
+                  found_cells[i]  = cell_and_point.first;
+                  found_points[i] = cell_and_point.second;
+                }
+            }
+          catch (const GridTools::ExcPointNotFound<spacedim> &)
+            {}
+        }
+
+    // Collect the output, with the cells in the order of the first point
+    // they contain
+    std::map<cell_iterator, unsigned int> cell_to_output_index;
+    for (unsigned int i = 0; i < np; ++i)
+      if (found[i])
+        {
+          const auto inserted =
+            cell_to_output_index.insert(std::make_pair(found_cells[i],
+                                                       cells_out.size()));
+          if (inserted.second)
+            {
+              cells_out.push_back(found_cells[i]);
+              qpoints_out.emplace_back();
+              maps_out.emplace_back();
+            }
+          qpoints_out[inserted.first->second].push_back(found_points[i]);
+          maps_out[inserted.first->second].push_back(i);
+        }
+      else
+        missing_points_out.push_back(i);
+
+    return std::make_tuple(std::move(cells_out),
+                           std::move(qpoints_out),
+                           std::move(maps_out),
+                           std::move(missing_points_out));
+  }
+
+
+
   namespace internal
   {
     // Functions are needed for distributed compute point locations
@@ -22,6 +22,9 @@
 
 #include <boost/geometry.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
@@ -30,20 +33,46 @@ namespace GridTools
   Cache<dim, spacedim>::Cache(const Triangulation<dim, spacedim> &tria,
                               const Mapping<dim, spacedim> &      mapping)
     : update_flags(update_all)
+    , refinement_in_progress(false)
+    , track_changes(
+        dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+          &tria) == nullptr &&
+        mapping.preserves_vertex_locations())
     , tria(&tria)
     , mapping(&mapping)
   {
-    tria_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    tria_signals.push_back(tria.signals.pre_refinement.connect(
+      [&]() { start_tracking_changes(); }));
+    tria_signals.push_back(tria.signals.pre_coarsening_on_cell.connect(
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        track_coarsening(cell);
+      }));
+    tria_signals.push_back(tria.signals.post_refinement_on_cell.connect(
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        track_refinement(cell);
+      }));
+
+    // a refinement step also triggers the any_change signal at its end. at
+    // that point, everything not updated incrementally has to be rebuilt
+    tria_signals.push_back(tria.signals.any_change.connect([&]() {
+      if (refinement_in_progress)
+        {
+          refinement_in_progress = false;
+          mark_for_update(update_all & ~mesh_changes.flags);
+        }
+      else
+        mark_for_update(update_all);
+    }));
   }
 
   template <int dim, int spacedim>
   Cache<dim, spacedim>::~Cache()
   {
-    // Make sure that the signals that was attached to the triangulation
-    // is removed here.
-    if (tria_signal.connected())
-      tria_signal.disconnect();
+    // Make sure that the signals that were attached to the triangulation
+    // are removed here.
+    for (auto &connection : tria_signals)
+      if (connection.connected())
+        connection.disconnect();
   }
 
 
@@ -53,6 +82,297 @@ namespace GridTools
   Cache<dim, spacedim>::mark_for_update(const CacheUpdateFlags &flags)
   {
     update_flags |= flags;
+
+    // objects that are rebuilt anyway need not be updated incrementally.
+    // the other ones can only be updated as long as the vertex to cell map
+    // and the used vertices they are updated from are
+    CacheUpdateFlags rebuilt = mesh_changes.flags & flags;
+    if (rebuilt & update_vertex_to_cell_map)
+      rebuilt = mesh_changes.flags;
+    else if (rebuilt & update_used_vertices)
+      rebuilt |= mesh_changes.flags & update_used_vertices_rtree;
+
+    if (rebuilt != update_nothing)
+      {
+        update_flags |= rebuilt;
+        mesh_changes.flags = mesh_changes.flags & ~rebuilt;
+        if (mesh_changes.flags == update_nothing)
+          mesh_changes = MeshChanges();
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::start_tracking_changes()
+  {
+    refinement_in_progress = true;
+
+    // changes of an earlier refinement step that have not been applied yet
+    // refer to cells that may no longer exist. rather than merging them
+    // with the ones of this step, rebuild the objects concerned
+    if (mesh_changes.flags != update_nothing)
+      mark_for_update(mesh_changes.flags);
+
+    // everything else is updated from the vertex to cell map, so there is
+    // nothing to track unless that one is up to date
+    else if (track_changes && !(update_flags & update_vertex_to_cell_map))
+      {
+        mesh_changes.flags = update_vertex_to_cell_map;
+        if (!(update_flags & update_used_vertices))
+          {
+            mesh_changes.flags |= update_used_vertices;
+            if (!(update_flags & update_used_vertices_rtree))
+              mesh_changes.flags |= update_used_vertices_rtree;
+          }
+        if (!(update_flags & update_cell_bounding_boxes_rtree))
+          mesh_changes.flags |= update_cell_bounding_boxes_rtree;
+
+        // updating an entry of the maps or the rtrees is several times more
+        // expensive than creating it as part of a rebuild, so give up once
+        // more than a small fraction of the mesh has changed
+        mesh_changes.max_n_changed_cells = tria->n_active_cells() / 8;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::track_coarsening(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+  {
+    if (mesh_changes.flags == update_nothing)
+      return;
+
+    if (++mesh_changes.n_changed_cells > mesh_changes.max_n_changed_cells)
+      {
+        mesh_changes = MeshChanges();
+        return;
+      }
+
+    mesh_changes.coarsened_cells.push_back(cell);
+    for (unsigned int c = 0; c < cell->n_children(); ++c)
+      {
+        const auto child = cell->child(c);
+        add_changed_vertices(child);
+        mesh_changes.removed_cells.insert(child);
+        if (mesh_changes.flags & update_cell_bounding_boxes_rtree)
+          mesh_changes.removed_bounding_boxes.emplace_back(
+            mapping->get_bounding_box(child), child);
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::track_refinement(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+  {
+    if (mesh_changes.flags == update_nothing)
+      return;
+
+    if (++mesh_changes.n_changed_cells > mesh_changes.max_n_changed_cells)
+      {
+        mesh_changes = MeshChanges();
+        return;
+      }
+
+    // the mapping preserves vertex locations, so the bounding box of the
+    // cell is the same as before it was refined
+    mesh_changes.refined_cells.push_back(cell);
+    mesh_changes.removed_cells.insert(cell);
+    if (mesh_changes.flags & update_cell_bounding_boxes_rtree)
+      mesh_changes.removed_bounding_boxes.emplace_back(
+        mapping->get_bounding_box(cell), cell);
+    for (unsigned int c = 0; c < cell->n_children(); ++c)
+      add_changed_vertices(cell->child(c));
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::add_changed_vertices(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+  {
+    // these are the vertices for which GridTools::vertex_to_cell_map() may
+    // put the cell into the list of adjacent cells: its own vertices, the
+    // vertices of the children of its faces, if a finer neighbor puts the
+    // cell there, and in 3d the middle vertices of its refined edges
+    std::vector<unsigned int> &vertices = mesh_changes.vertices;
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      vertices.push_back(cell->vertex_index(v));
+
+    if (dim > 1)
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->face(f)->has_children())
+          for (unsigned int c = 0; c < cell->face(f)->n_children(); ++c)
+            for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_face;
+                 ++v)
+              vertices.push_back(cell->face(f)->child(c)->vertex_index(v));
+
+    if (dim == 3)
+      for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+        if (cell->line(l)->has_children())
+          vertices.push_back(cell->line(l)->child(0)->vertex_index(1));
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  Cache<dim, spacedim>::update_incrementally() const
+  {
+    if (mesh_changes.flags == update_nothing)
+      return false;
+
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+    namespace bgi = boost::geometry::index;
+
+    std::vector<unsigned int> &vertices = mesh_changes.vertices;
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                   vertices.end());
+    const auto vertex_changed = [&](const unsigned int v) {
+      return std::binary_search(vertices.begin(), vertices.end(), v);
+    };
+
+    // the new active cells are the children of the refined cells and the
+    // cells whose children were removed
+    std::vector<active_cell_iterator> new_cells;
+    for (const auto &cell : mesh_changes.refined_cells)
+      for (unsigned int c = 0; c < cell->n_children(); ++c)
+        new_cells.emplace_back(cell->child(c));
+    for (const auto &cell : mesh_changes.coarsened_cells)
+      new_cells.emplace_back(cell);
+
+    // the entries of the changed vertices are computed from the cells that
+    // may contribute to them: the new active cells, and all cells that
+    // were adjacent to a changed vertex and are still active. the latter
+    // include all cells that share a face or an edge with a refined cell,
+    // and that may therefore have gained hanging nodes
+    std::set<active_cell_iterator> cells(new_cells.begin(), new_cells.end());
+    vertex_to_cells.resize(tria->n_vertices());
+    for (const unsigned int v : vertices)
+      {
+        for (const auto &cell : vertex_to_cells[v])
+          if (mesh_changes.removed_cells.find(cell) ==
+              mesh_changes.removed_cells.end())
+            cells.insert(cell);
+        vertex_to_cells[v].clear();
+      }
+
+    // this is the same as in GridTools::vertex_to_cell_map(), restricted to
+    // the changed vertices
+    for (const auto &cell : cells)
+      {
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          if (vertex_changed(cell->vertex_index(v)))
+            vertex_to_cells[cell->vertex_index(v)].insert(cell);
+
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if ((cell->at_boundary(f) == false) && (cell->neighbor(f)->active()))
+            {
+              const active_cell_iterator adjacent_cell = cell->neighbor(f);
+              for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_face;
+                   ++v)
+                if (vertex_changed(cell->face(f)->vertex_index(v)))
+                  vertex_to_cells[cell->face(f)->vertex_index(v)].insert(
+                    adjacent_cell);
+            }
+
+        if (dim == 3)
+          for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+            if (cell->line(l)->has_children() &&
+                vertex_changed(cell->line(l)->child(0)->vertex_index(1)))
+              vertex_to_cells[cell->line(l)->child(0)->vertex_index(1)].insert(
+                cell);
+      }
+
+    // the used vertices are the vertices of active cells, so all of them
+    // that changed are vertices of one of the cells above
+    if (mesh_changes.flags & update_used_vertices)
+      {
+        const bool update_rtree =
+          (mesh_changes.flags & update_used_vertices_rtree);
+        for (const unsigned int v : vertices)
+          {
+            const auto it = used_vertices.find(v);
+            if (it != used_vertices.end())
+              {
+                if (update_rtree)
+                  {
+                    const auto n_removed =
+                      used_vertices_rtree.remove(std::make_pair(it->second, v));
+                    (void)n_removed;
+                    Assert(n_removed == 1, ExcInternalError());
+                  }
+                used_vertices.erase(it);
+              }
+          }
+
+        for (const auto &cell : cells)
+          {
+            bool has_changed_vertex = false;
+            for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+                 ++v)
+              if (vertex_changed(cell->vertex_index(v)))
+                has_changed_vertex = true;
+
+            if (has_changed_vertex)
+              {
+                const auto points = mapping->get_vertices(cell);
+                for (unsigned int v = 0; v < points.size(); ++v)
+                  if (vertex_changed(cell->vertex_index(v)))
+                    used_vertices[cell->vertex_index(v)] = points[v];
+              }
+          }
+
+        if (update_rtree)
+          for (const unsigned int v : vertices)
+            {
+              const auto it = used_vertices.find(v);
+              if (it != used_vertices.end())
+                used_vertices_rtree.insert(std::make_pair(it->second, v));
+            }
+      }
+
+    if (mesh_changes.flags & update_cell_bounding_boxes_rtree)
+      {
+        // find the stored entries by their bounding box first, since the
+        // iterators of removed cells cannot be converted to active ones
+        std::vector<std::pair<BoundingBox<spacedim>, active_cell_iterator>>
+          removed_entries;
+        for (const auto &entry : mesh_changes.removed_bounding_boxes)
+          {
+            const auto &cell = entry.second;
+            cell_bounding_boxes_rtree.query(
+              bgi::intersects(entry.first) &&
+                bgi::satisfies(
+                  [&cell](const std::pair<BoundingBox<spacedim>,
+                                          active_cell_iterator> &value) {
+                    return value.second == cell;
+                  }),
+              std::back_inserter(removed_entries));
+          }
+        const auto n_removed = cell_bounding_boxes_rtree.remove(
+          removed_entries.begin(), removed_entries.end());
+        (void)n_removed;
+        Assert(n_removed == mesh_changes.removed_bounding_boxes.size(),
+               ExcInternalError());
+
+        for (const auto &cell : new_cells)
+          cell_bounding_boxes_rtree.insert(
+            std::make_pair(mapping->get_bounding_box(cell), cell));
+      }
+
+    ++statistics.n_incremental_updates;
+    mesh_changes = MeshChanges();
+    return true;
   }
 
 
@@ -62,11 +382,16 @@ namespace GridTools
     std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>> &
   Cache<dim, spacedim>::get_vertex_to_cell_map() const
   {
+    const bool updated = update_incrementally();
+
     if (update_flags & update_vertex_to_cell_map)
       {
         vertex_to_cells = GridTools::vertex_to_cell_map(*tria);
         update_flags    = update_flags & ~update_vertex_to_cell_map;
+        ++statistics.n_full_updates;
       }
+    else if (!updated)
+      ++statistics.n_hits;
     return vertex_to_cells;
   }
 
@@ -81,7 +406,10 @@ namespace GridTools
         vertex_to_cell_centers = GridTools::vertex_to_cell_centers_directions(
           *tria, get_vertex_to_cell_map());
         update_flags = update_flags & ~update_vertex_to_cell_centers_directions;
+        ++statistics.n_full_updates;
       }
+    else
+      ++statistics.n_hits;
     return vertex_to_cell_centers;
   }
 
@@ -91,11 +419,16 @@ namespace GridTools
   const std::map<unsigned int, Point<spacedim>> &
   Cache<dim, spacedim>::get_used_vertices() const
   {
+    const bool updated = update_incrementally();
+
     if (update_flags & update_used_vertices)
       {
         used_vertices = GridTools::extract_used_vertices(*tria, *mapping);
         update_flags  = update_flags & ~update_used_vertices;
+        ++statistics.n_full_updates;
       }
+    else if (!updated)
+      ++statistics.n_hits;
     return used_vertices;
   }
 
@@ -105,6 +438,8 @@ namespace GridTools
   const RTree<std::pair<Point<spacedim>, unsigned int>> &
   Cache<dim, spacedim>::get_used_vertices_rtree() const
   {
+    const bool updated = update_incrementally();
+
     if (update_flags & update_used_vertices_rtree)
       {
         const auto &used_vertices = get_used_vertices();
@@ -115,7 +450,10 @@ namespace GridTools
           vertices[i++] = std::make_pair(it.second, it.first);
         used_vertices_rtree = pack_rtree(vertices);
         update_flags        = update_flags & ~update_used_vertices_rtree;
+        ++statistics.n_full_updates;
       }
+    else if (!updated)
+      ++statistics.n_hits;
     return used_vertices_rtree;
   }
 
@@ -127,6 +465,8 @@ namespace GridTools
               typename Triangulation<dim, spacedim>::active_cell_iterator>> &
   Cache<dim, spacedim>::get_cell_bounding_boxes_rtree() const
   {
+    const bool updated = update_incrementally();
+
     if (update_flags & update_cell_bounding_boxes_rtree)
       {
         std::vector<std::pair<
@@ -139,7 +479,10 @@ namespace GridTools
 
         cell_bounding_boxes_rtree = pack_rtree(boxes);
         update_flags = update_flags & ~update_cell_bounding_boxes_rtree;
+        ++statistics.n_full_updates;
       }
+    else if (!updated)
+      ++statistics.n_hits;
     return cell_bounding_boxes_rtree;
   }
 
@@ -153,7 +496,10 @@ namespace GridTools
       {
         vertex_kdtree.set_points(tria->get_vertices());
         update_flags = update_flags & ~update_vertex_kdtree;
+        ++statistics.n_full_updates;
       }
+    else
+      ++statistics.n_hits;
     return vertex_kdtree;
   }
 #endif
@@ -195,7 +541,10 @@ namespace GridTools
               GridTools::build_global_description_tree(bbox_v, MPI_COMM_SELF);
           }
         update_flags = update_flags & ~update_covering_rtree;
+        ++statistics.n_full_updates;
       }
+    else
+      ++statistics.n_hits;
 
     return covering_rtree;
   }
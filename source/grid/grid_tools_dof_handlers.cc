@@ -2085,20 +2085,64 @@ namespace GridTools
     }
 #endif
 
-    unsigned int n_matches = 0;
-
-    // Match with a complexity of O(n^2). This could be improved...
-    std::bitset<3> orientation;
+    // Sort the faces of the second boundary into buckets by the location
+    // of their centers, ignoring the component in periodic direction, and
+    // only compare with the faces in neighboring buckets. If two faces
+    // match, all of their vertices match up to a tolerance of 1e-10 (see
+    // orthogonal_equality), and so do their centers.
+    constexpr int facedim = CellIterator::AccessorType::dimension - 1;
     using PairIterator =
       typename std::set<std::pair<CellIterator, unsigned int>>::const_iterator;
+    const auto face_center = [](const PairIterator &it) {
+      const auto       face = it->first->face(it->second);
+      Point<space_dim> center;
+      for (unsigned int v = 0; v < GeometryInfo<facedim>::vertices_per_cell;
+           ++v)
+        center += face->vertex(v);
+      return Point<space_dim>(center /
+                              GeometryInfo<facedim>::vertices_per_cell);
+    };
+
+    std::vector<PairIterator>     faces2;
+    std::vector<Point<space_dim>> centers2;
+    faces2.reserve(pairs2.size());
+    centers2.reserve(pairs2.size());
+    for (PairIterator it2 = pairs2.begin(); it2 != pairs2.end(); ++it2)
+      {
+        faces2.push_back(it2);
+        centers2.push_back(face_center(it2));
+        centers2.back()[direction] = 0.;
+      }
+    const GridTools::internal::PointBucketGrid<space_dim> bucket_grid(
+      centers2, 1.e-10);
+    std::vector<bool>         face2_is_matched(faces2.size(), false);
+    std::vector<unsigned int> candidates;
+
+    unsigned int   n_matches = 0;
+    std::bitset<3> orientation;
     for (PairIterator it1 = pairs1.begin(); it1 != pairs1.end(); ++it1)
       {
-        for (PairIterator it2 = pairs2.begin(); it2 != pairs2.end(); ++it2)
+        const Point<space_dim> center1 = face_center(it1);
+        Point<space_dim>       transformed_center1;
+        if (matrix.m() == space_dim)
+          for (int i = 0; i < space_dim; ++i)
+            for (int j = 0; j < space_dim; ++j)
+              transformed_center1(i) += matrix(i, j) * center1(j);
+        else
+          transformed_center1 = center1;
+        transformed_center1 += offset;
+        transformed_center1[direction] = 0.;
+
+        bucket_grid.get_candidates(transformed_center1, candidates);
+        for (const unsigned int c : candidates)
           {
+            if (face2_is_matched[c])
+              continue;
+
             const CellIterator cell1     = it1->first;
-            const CellIterator cell2     = it2->first;
+            const CellIterator cell2     = faces2[c]->first;
             const unsigned int face_idx1 = it1->second;
-            const unsigned int face_idx2 = it2->second;
+            const unsigned int face_idx2 = faces2[c]->second;
             if (GridTools::orthogonal_equality(orientation,
                                                cell1->face(face_idx1),
                                                cell2->face(face_idx2),
@@ -2107,12 +2151,12 @@ namespace GridTools
                                                matrix))
               {
                 // We have a match, so insert the matching pairs and
-                // remove the matched cell in pairs2 to speed up the
-                // matching:
+                // remove the matched cell in pairs2:
                 const PeriodicFacePair<CellIterator> matched_face = {
                   {cell1, cell2}, {face_idx1, face_idx2}, orientation, matrix};
                 matched_pairs.push_back(matched_face);
-                pairs2.erase(it2);
+                face2_is_matched[c] = true;
+                pairs2.erase(faces2[c]);
                 ++n_matches;
                 break;
               }
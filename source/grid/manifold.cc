@@ -45,6 +45,15 @@ Manifold<dim, spacedim>::project_to_manifold(
 
 
 
+template <int dim, int spacedim>
+bool
+Manifold<dim, spacedim>::is_thread_safe() const
+{
+  return false;
+}
+
+
+
 template <int dim, int spacedim>
 Point<spacedim>
 Manifold<dim, spacedim>::get_intermediate_point(const Point<spacedim> &p1,
@@ -533,6 +542,15 @@ FlatManifold<dim, spacedim>::clone() const
 
 
 
+template <int dim, int spacedim>
+bool
+FlatManifold<dim, spacedim>::is_thread_safe() const
+{
+  return true;
+}
+
+
+
 template <int dim, int spacedim>
 Point<spacedim>
 FlatManifold<dim, spacedim>::get_new_point(
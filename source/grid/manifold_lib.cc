@@ -16,6 +16,7 @@
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/mapping.h>
 
@@ -136,6 +137,15 @@ PolarManifold<dim, spacedim>::clone() const
 
 
 
+template <int dim, int spacedim>
+bool
+PolarManifold<dim, spacedim>::is_thread_safe() const
+{
+  return true;
+}
+
+
+
 template <int dim, int spacedim>
 Tensor<1, spacedim>
 PolarManifold<dim, spacedim>::get_periodicity()
@@ -296,6 +306,15 @@ SphericalManifold<dim, spacedim>::clone() const
 
 
 
+template <int dim, int spacedim>
+bool
+SphericalManifold<dim, spacedim>::is_thread_safe() const
+{
+  return true;
+}
+
+
+
 template <int dim, int spacedim>
 Point<spacedim>
 SphericalManifold<dim, spacedim>::get_intermediate_point(
@@ -548,6 +567,245 @@ SphericalManifold<dim, spacedim>::get_new_point(
 
 
 
+namespace
+{
+  /**
+   * Perform the Newton iteration of do_get_new_point() below for
+   * VectorizedArray<double>::n_array_elements new points at once. All new
+   * points share the @p directions, whereas each lane of @p weights and
+   * @p candidate_point belongs to a different new point. Lanes that have
+   * converged keep their value while the others continue to iterate.
+   *
+   * The branches of the scalar function become masks, and the values that
+   * would lead to a division by zero in lanes that take the other branch
+   * are replaced by one.
+   */
+  Tensor<1, 3, VectorizedArray<double>>
+  do_get_new_point_vectorized(
+    const ArrayView<const Tensor<1, 3>> &            directions,
+    const ArrayView<const VectorizedArray<double>> &weights,
+    const Tensor<1, 3, VectorizedArray<double>> &    candidate_point)
+  {
+    using VectorizedDouble = VectorizedArray<double>;
+    constexpr unsigned int n_lanes = VectorizedDouble::n_array_elements;
+
+    AssertDimension(directions.size(), weights.size());
+
+    Tensor<1, 3, VectorizedDouble> candidate      = candidate_point;
+    const unsigned int             n_merged_points = directions.size();
+    const double                   tolerance       = 1e-10;
+    const int                      max_iterations  = 10;
+    const VectorizedDouble         zero(0.), one(1.);
+
+    boost::container::small_vector<Tensor<1, 3, VectorizedDouble>, 100>
+      vectorized_directions(n_merged_points);
+    for (unsigned int i = 0; i < n_merged_points; ++i)
+      for (unsigned int d = 0; d < 3; ++d)
+        vectorized_directions[i][d] = directions[i][d];
+
+    // If the candidate happens to coincide with a normalized direction, we
+    // keep it. Otherwise, the Hessian would be singular. A lane is done
+    // once the corresponding entry of 'converged' is one.
+    VectorizedDouble converged = zero;
+    for (unsigned int i = 0; i < n_merged_points; ++i)
+      converged = compare_and_apply_mask<SIMDComparison::less_than>(
+        (candidate - vectorized_directions[i]).norm_square(),
+        VectorizedDouble(tolerance * tolerance),
+        one,
+        converged);
+
+    for (int iteration = 0; iteration < max_iterations; ++iteration)
+      {
+        bool all_converged = true;
+        for (unsigned int lane = 0; lane < n_lanes; ++lane)
+          if (converged[lane] == 0.)
+            all_converged = false;
+        if (all_converged)
+          break;
+
+        // Step 2a: Find new descent direction
+
+        // Get local basis for the estimate candidate. The choice of the
+        // normal vector depends on the largest component of the candidate,
+        // so it is made for each lane separately.
+        Tensor<1, 3, VectorizedDouble> Clocalx;
+        for (unsigned int lane = 0; lane < n_lanes; ++lane)
+          {
+            Tensor<1, 3> candidate_lane;
+            for (unsigned int d = 0; d < 3; ++d)
+              candidate_lane[d] = candidate[d][lane];
+            const Tensor<1, 3> normal =
+              internal::compute_normal(candidate_lane);
+            for (unsigned int d = 0; d < 3; ++d)
+              Clocalx[d][lane] = normal[d];
+          }
+        const Tensor<1, 3, VectorizedDouble> Clocaly =
+          cross_product_3d(candidate, Clocalx);
+
+        Tensor<2, 2, VectorizedDouble> Hessian;
+        Tensor<1, 2, VectorizedDouble> gradient;
+        for (unsigned int i = 0; i < n_merged_points; ++i)
+          {
+            Tensor<1, 3, VectorizedDouble> vPerp =
+              vectorized_directions[i] - candidate;
+            vPerp -= (vPerp * candidate) * candidate;
+            const VectorizedDouble sinthetaSq = vPerp.norm_square();
+            const VectorizedDouble sintheta   = std::sqrt(sinthetaSq);
+
+            // lanes in which the candidate is aligned with the direction
+            // only contribute to the diagonal of the Hessian
+            const VectorizedDouble safe_sintheta =
+              compare_and_apply_mask<SIMDComparison::less_than>(
+                sintheta, VectorizedDouble(tolerance), one, sintheta);
+            const VectorizedDouble safe_sinthetaSq =
+              compare_and_apply_mask<SIMDComparison::less_than>(
+                sintheta, VectorizedDouble(tolerance), one, sinthetaSq);
+
+            const VectorizedDouble costheta =
+              vectorized_directions[i] * candidate;
+            VectorizedDouble theta;
+            for (unsigned int lane = 0; lane < n_lanes; ++lane)
+              theta[lane] = std::atan2(safe_sintheta[lane], costheta[lane]);
+            const VectorizedDouble sincthetaInv = theta / safe_sintheta;
+
+            const VectorizedDouble cosphi = vPerp * Clocalx;
+            const VectorizedDouble sinphi = vPerp * Clocaly;
+
+            const VectorizedDouble wt       = weights[i] / safe_sinthetaSq;
+            const VectorizedDouble sinphiSq = sinphi * sinphi;
+            const VectorizedDouble cosphiSq = cosphi * cosphi;
+            const VectorizedDouble tt       = sincthetaInv * costheta;
+            const VectorizedDouble offdiag  = cosphi * sinphi * wt * (1.0 - tt);
+
+            // directions with zero weight do not contribute at all
+            const VectorizedDouble weight =
+              compare_and_apply_mask<SIMDComparison::greater_than>(
+                std::abs(weights[i]), VectorizedDouble(1.e-15), one, zero);
+            const auto increment = [&](const VectorizedDouble &aligned,
+                                       const VectorizedDouble &general) {
+              return weight *
+                     compare_and_apply_mask<SIMDComparison::less_than>(
+                       sintheta, VectorizedDouble(tolerance), aligned, general);
+            };
+
+            gradient[0] +=
+              increment(zero, (weights[i] * sincthetaInv) * cosphi);
+            gradient[1] +=
+              increment(zero, (weights[i] * sincthetaInv) * sinphi);
+            Hessian[0][0] +=
+              increment(weights[i], wt * (cosphiSq + tt * sinphiSq));
+            Hessian[0][1] += increment(zero, offdiag);
+            Hessian[1][0] += increment(zero, offdiag);
+            Hessian[1][1] +=
+              increment(weights[i], wt * (sinphiSq + tt * cosphiSq));
+          }
+
+#ifdef DEBUG
+        const VectorizedDouble det = determinant(Hessian);
+        for (unsigned int lane = 0; lane < n_lanes; ++lane)
+          Assert(det[lane] > tolerance, ExcInternalError());
+#endif
+
+        const Tensor<2, 2, VectorizedDouble> inverse_Hessian = invert(Hessian);
+
+        const Tensor<1, 2, VectorizedDouble> xDisplocal =
+          inverse_Hessian * gradient;
+        const Tensor<1, 3, VectorizedDouble> xDisp =
+          xDisplocal[0] * Clocalx + xDisplocal[1] * Clocaly;
+
+        // Step 2b: rotate candidate in direction xDisp for a new candidate,
+        // as in internal::apply_exponential_map()
+        const VectorizedDouble angle = xDisp.norm();
+        const VectorizedDouble safe_angle =
+          compare_and_apply_mask<SIMDComparison::less_than>(
+            angle, VectorizedDouble(1.e-10), one, angle);
+        Tensor<1, 3, VectorizedDouble> rotated =
+          std::cos(safe_angle) * candidate +
+          std::sin(safe_angle) * (xDisp / safe_angle);
+        rotated /= rotated.norm();
+
+        // Step 2c: lanes that did not move are done. Lanes that converged
+        // before keep their candidate.
+        Tensor<1, 3, VectorizedDouble> new_candidate;
+        for (unsigned int d = 0; d < 3; ++d)
+          new_candidate[d] = compare_and_apply_mask<SIMDComparison::less_than>(
+            angle, VectorizedDouble(1.e-10), candidate[d], rotated[d]);
+        const VectorizedDouble step = (new_candidate - candidate).norm_square();
+        for (unsigned int d = 0; d < 3; ++d)
+          candidate[d] = compare_and_apply_mask<SIMDComparison::equal>(
+            converged, zero, new_candidate[d], candidate[d]);
+        converged = compare_and_apply_mask<SIMDComparison::less_than>(
+          step, VectorizedDouble(tolerance * tolerance), one, converged);
+      }
+
+    return candidate;
+  }
+
+
+
+  /**
+   * Compute the new directions of the given @p rows of the merged weights
+   * with do_get_new_point_vectorized(), starting from the directions in
+   * @p candidates, which are overwritten. Rows are processed in batches of
+   * the width of VectorizedArray; the lanes of an incomplete last batch
+   * repeat its last row.
+   */
+  template <int spacedim>
+  void
+  do_get_new_points(const ArrayView<const Tensor<1, spacedim>> &,
+                    const ArrayView<const double> &,
+                    const unsigned int,
+                    const ArrayView<const unsigned int> &,
+                    const ArrayView<std::pair<double, Tensor<1, spacedim>>> &)
+  {
+    Assert(false, ExcNotImplemented());
+  }
+
+
+
+  template <>
+  void
+  do_get_new_points(
+    const ArrayView<const Tensor<1, 3>> &              directions,
+    const ArrayView<const double> &                    weights,
+    const unsigned int                                 weight_columns,
+    const ArrayView<const unsigned int> &              rows,
+    const ArrayView<std::pair<double, Tensor<1, 3>>> &candidates)
+  {
+    constexpr unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+
+    boost::container::small_vector<VectorizedArray<double>, 100>
+      vectorized_weights(directions.size());
+    for (unsigned int batch = 0; batch < rows.size(); batch += n_lanes)
+      {
+        const unsigned int n_filled =
+          std::min<unsigned int>(n_lanes, rows.size() - batch);
+
+        Tensor<1, 3, VectorizedArray<double>> candidate;
+        for (unsigned int lane = 0; lane < n_lanes; ++lane)
+          {
+            const unsigned int row = rows[batch + std::min(lane, n_filled - 1)];
+            for (unsigned int i = 0; i < directions.size(); ++i)
+              vectorized_weights[i][lane] = weights[row * weight_columns + i];
+            for (unsigned int d = 0; d < 3; ++d)
+              candidate[d][lane] = candidates[row].second[d];
+          }
+
+        candidate = do_get_new_point_vectorized(
+          directions,
+          make_array_view(vectorized_weights.begin(),
+                          vectorized_weights.end()),
+          candidate);
+
+        for (unsigned int lane = 0; lane < n_filled; ++lane)
+          for (unsigned int d = 0; d < 3; ++d)
+            candidates[rows[batch + lane]].second[d] = candidate[d][lane];
+      }
+  }
+} // namespace
+
+
+
 template <int dim, int spacedim>
 void
 SphericalManifold<dim, spacedim>::get_new_points(
@@ -733,20 +991,38 @@ SphericalManifold<dim, spacedim>::get_new_points(
     make_array_view(merged_distances.begin(),
                     merged_distances.begin() + n_unique_directions);
 
+  boost::container::small_vector<unsigned int, 100> newton_rows;
+  for (unsigned int row = 0; row < weight_rows; ++row)
+    if (!accurate_point_was_found[row] &&
+        merged_weights_index[row] == numbers::invalid_unsigned_int)
+      newton_rows.push_back(row);
+
+  // If there are several rows left, run the Newton iterations for as many
+  // of them at once as fit into a VectorizedArray. With only two unique
+  // directions, the scalar function uses get_intermediate_point() instead.
+  if (newton_rows.size() > 1 && n_unique_directions > 2)
+    do_get_new_points(
+      array_merged_directions,
+      make_array_view(merged_weights.begin(), merged_weights.end()),
+      weight_columns,
+      make_array_view(newton_rows.begin(), newton_rows.end()),
+      make_array_view(new_candidates.begin(), new_candidates.end()));
+  else
+    for (const unsigned int row : newton_rows)
+      {
+        const ArrayView<const double> array_merged_weights(
+          &merged_weights[row * weight_columns], n_unique_directions);
+        new_candidates[row].second =
+          get_new_point(array_merged_directions,
+                        array_merged_distances,
+                        array_merged_weights,
+                        Point<spacedim>(new_candidates[row].second));
+      }
+
   for (unsigned int row = 0; row < weight_rows; ++row)
     if (!accurate_point_was_found[row])
       {
-        if (merged_weights_index[row] == numbers::invalid_unsigned_int)
-          {
-            const ArrayView<const double> array_merged_weights(
-              &merged_weights[row * weight_columns], n_unique_directions);
-            new_candidates[row].second =
-              get_new_point(array_merged_directions,
-                            array_merged_distances,
-                            array_merged_weights,
-                            Point<spacedim>(new_candidates[row].second));
-          }
-        else
+        if (merged_weights_index[row] != numbers::invalid_unsigned_int)
           new_candidates[row].second =
             new_candidates[merged_weights_index[row]].second;
 
@@ -1028,6 +1304,15 @@ CylindricalManifold<dim, spacedim>::clone() const
 
 
 
+template <int dim, int spacedim>
+bool
+CylindricalManifold<dim, spacedim>::is_thread_safe() const
+{
+  return true;
+}
+
+
+
 template <int dim, int spacedim>
 Point<spacedim>
 CylindricalManifold<dim, spacedim>::get_new_point(
@@ -1057,6 +1342,109 @@ CylindricalManifold<dim, spacedim>::get_new_point(
 
 
 
+template <int dim, int spacedim>
+void
+CylindricalManifold<dim, spacedim>::get_new_points(
+  const ArrayView<const Point<spacedim>> &surrounding_points,
+  const Table<2, double> &                weights,
+  ArrayView<Point<spacedim>>              new_points) const
+{
+  Assert(spacedim == 3,
+         ExcMessage("CylindricalManifold can only be used for spacedim==3!"));
+  AssertDimension(surrounding_points.size(), weights.size(1));
+  AssertDimension(new_points.size(), weights.size(0));
+
+  using VectorizedDouble = VectorizedArray<double>;
+  constexpr unsigned int n_lanes  = VectorizedDouble::n_array_elements;
+  const unsigned int     n_points = surrounding_points.size();
+  const unsigned int     n_rows   = weights.size(0);
+
+  // Pull back the surrounding points once for all rows. As in
+  // FlatManifold::get_new_points(), angles that are more than half a
+  // period larger than the smallest one are shifted by a period so that
+  // the averages do not cross the discontinuity of the chart.
+  const double periodicity = 2. * numbers::PI;
+  boost::container::small_vector<Point<3>, 200> chart_points(n_points);
+  double                                         min_angle = periodicity;
+  for (unsigned int i = 0; i < n_points; ++i)
+    {
+      chart_points[i] = pull_back(surrounding_points[i]);
+      min_angle       = std::min(min_angle, chart_points[i][1]);
+    }
+  for (unsigned int i = 0; i < n_points; ++i)
+    if (chart_points[i][1] - min_angle > periodicity / 2.0)
+      chart_points[i][1] -= periodicity;
+
+  const Tensor<1, spacedim> dxn = cross_product_3d(direction, normal_direction);
+
+  for (unsigned int batch = 0; batch < n_rows; batch += n_lanes)
+    {
+      const unsigned int n_filled = std::min(n_lanes, n_rows - batch);
+
+      // The lanes of an incomplete last batch repeat its last row. Besides
+      // the average in the chart, also compute the average in space to
+      // check whether it lies on the axis, as in get_new_point().
+      Point<3, VectorizedDouble>        chart_point;
+      Point<spacedim, VectorizedDouble> middle;
+      VectorizedDouble                  average_length = 0.;
+      for (unsigned int i = 0; i < n_points; ++i)
+        {
+          VectorizedDouble weight;
+          for (unsigned int lane = 0; lane < n_lanes; ++lane)
+            weight[lane] = weights(batch + std::min(lane, n_filled - 1), i);
+
+          for (unsigned int d = 0; d < 3; ++d)
+            chart_point[d] += weight * chart_points[i][d];
+          for (unsigned int d = 0; d < spacedim; ++d)
+            middle[d] += weight * surrounding_points[i][d];
+          average_length += weight * surrounding_points[i].square();
+        }
+
+      // Push forward the average in the chart, with the angle moved back
+      // into the range of the chart
+      chart_point[1] = compare_and_apply_mask<SIMDComparison::less_than>(
+        chart_point[1],
+        VectorizedDouble(0.),
+        chart_point[1] + periodicity,
+        chart_point[1]);
+      const VectorizedDouble sine_r =
+        std::sin(chart_point[1]) * chart_point[0];
+      const VectorizedDouble cosine_r =
+        std::cos(chart_point[1]) * chart_point[0];
+
+      for (unsigned int d = 0; d < spacedim; ++d)
+        middle[d] -= point_on_axis[d];
+      VectorizedDouble lambda = 0.;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        lambda += middle[d] * direction[d];
+      VectorizedDouble distance_from_axis = 0.;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          const VectorizedDouble difference = middle[d] - direction[d] * lambda;
+          distance_from_axis += difference * difference;
+        }
+
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          const VectorizedDouble on_chart =
+            point_on_axis[d] + direction[d] * chart_point[2] +
+            (normal_direction[d] * cosine_r + dxn[d] * sine_r);
+          const VectorizedDouble on_axis =
+            point_on_axis[d] + direction[d] * lambda;
+          const VectorizedDouble coordinate =
+            compare_and_apply_mask<SIMDComparison::less_than>(
+              distance_from_axis,
+              tolerance * average_length,
+              on_axis,
+              on_chart);
+          for (unsigned int lane = 0; lane < n_filled; ++lane)
+            new_points[batch + lane][d] = coordinate[lane];
+        }
+    }
+}
+
+
+
 template <int dim, int spacedim>
 Point<3>
 CylindricalManifold<dim, spacedim>::pull_back(
@@ -1182,6 +1570,15 @@ EllipticalManifold<dim, spacedim>::clone() const
 
 
 
+template <int dim, int spacedim>
+bool
+EllipticalManifold<dim, spacedim>::is_thread_safe() const
+{
+  return true;
+}
+
+
+
 template <int dim, int spacedim>
 Tensor<1, spacedim>
 EllipticalManifold<dim, spacedim>::get_periodicity()
@@ -1521,6 +1918,15 @@ TorusManifold<dim>::clone() const
 
 
 
+template <int dim>
+bool
+TorusManifold<dim>::is_thread_safe() const
+{
+  return true;
+}
+
+
+
 template <int dim>
 DerivativeForm<1, 3, 3>
 TorusManifold<dim>::push_forward_gradient(const Point<3> &chart_point) const
@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/fe/mapping_q1.h>
@@ -35,10 +36,13 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstring>
+#include <fstream>
 #include <functional>
 #include <list>
 #include <map>
 #include <numeric>
+#include <type_traits>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -4243,6 +4247,70 @@ namespace internal
       }
 
 
+      /**
+       * A vertex created during refinement whose location has not been
+       * computed yet: the index of the vertex and the object (line, quad, or
+       * cell) at whose center it is placed, together with the second
+       * argument to be passed to TriaAccessor::center().
+       */
+      template <typename IteratorType>
+      struct NewVertex
+      {
+        unsigned int index;
+        IteratorType object;
+        bool         use_interpolation;
+      };
+
+
+      /**
+       * Ask the manifolds for the locations of the vertices in
+       * @p new_vertices and store them in the vertices array of the
+       * triangulation.
+       *
+       * The functions below first set up all new objects of one dimension,
+       * which only changes the topology of the triangulation, and then call
+       * this function for the vertices created on these objects. Each query
+       * depends only on vertices that exist already and writes into a slot
+       * of the vertices array of its own, and the array has been resized
+       * before the refinement started, so the queries can run in parallel.
+       * The result does not depend on the number of threads.
+       *
+       * Since the queries end up in user code, they are only run in
+       * parallel if all manifolds attached to the triangulation declare
+       * through Manifold::is_thread_safe() that they may be called
+       * concurrently. Objects without an attached manifold use a
+       * FlatManifold, which is thread-safe.
+       */
+      template <int dim, int spacedim, typename IteratorType>
+      static void
+      compute_new_vertex_locations(
+        Triangulation<dim, spacedim> &              triangulation,
+        const std::vector<NewVertex<IteratorType>> &new_vertices)
+      {
+        const auto compute_locations = [&](const unsigned int begin,
+                                           const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            triangulation.vertices[new_vertices[i].index] =
+              new_vertices[i].object->center(
+                true, new_vertices[i].use_interpolation);
+        };
+
+        bool manifolds_are_thread_safe = true;
+        for (const auto &manifold : triangulation.manifold)
+          if (!manifold.second->is_thread_safe())
+            manifolds_are_thread_safe = false;
+
+        if (manifolds_are_thread_safe)
+          parallel::apply_to_subranges(
+            0U,
+            static_cast<unsigned int>(new_vertices.size()),
+            compute_locations,
+            64);
+        else
+          compute_locations(0, new_vertices.size());
+      }
+
+
       /**
        * Create the children of a 2d
        * cell. The arguments indicate
@@ -4259,6 +4327,12 @@ namespace internal
        * lines, quads and cells have to
        * be passed, which point at (or
        * "before") the reserved space.
+       *
+       * The location of the new vertex
+       * at the center of the cell, if
+       * any, is not computed here;
+       * instead, the vertex is appended
+       * to @p new_cell_vertices.
        */
       template <int spacedim>
       static void create_children(
@@ -4268,7 +4342,10 @@ namespace internal
           &next_unused_line,
         typename Triangulation<2, spacedim>::raw_cell_iterator
           &                                                 next_unused_cell,
-        typename Triangulation<2, spacedim>::cell_iterator &cell)
+        typename Triangulation<2, spacedim>::cell_iterator &cell,
+        std::vector<
+          NewVertex<typename Triangulation<2, spacedim>::cell_iterator>>
+          &new_cell_vertices)
       {
         const unsigned int dim = 2;
         // clear refinement flag
@@ -4405,23 +4482,19 @@ namespace internal
             // not the case, then
             // we need to ask a
             // boundary object
+            //
+            // the location itself is computed by the caller once all
+            // cells have been set up
             if (dim == spacedim)
               {
-                // triangulation.vertices[next_unused_vertex] = new_point;
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-
                 // if the user_flag is set, i.e. if the cell is at the
                 // boundary, use a different calculation of the middle vertex
                 // here. this is of advantage if the boundary is strongly
                 // curved (whereas the cell is not) and the cell has a high
                 // aspect ratio.
-                if (cell->user_flag_set())
-                  {
-                    // first reset the user_flag and then refine
-                    cell->clear_user_flag();
-                    triangulation.vertices[next_unused_vertex] =
-                      cell->center(true, true);
-                  }
+                new_cell_vertices.push_back(
+                  {next_unused_vertex, cell, cell->user_flag_set()});
+                cell->clear_user_flag();
               }
             else
               {
@@ -4434,7 +4507,7 @@ namespace internal
 
                 // new vertex is placed on the surface according to
                 // the information stored in the boundary class
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
+                new_cell_vertices.push_back({next_unused_vertex, cell, false});
               }
           }
 
@@ -4789,6 +4862,12 @@ namespace internal
         // index of next unused vertex
         unsigned int next_unused_vertex = 0;
 
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          refined_cells;
+        std::vector<
+          NewVertex<typename Triangulation<dim, spacedim>::cell_iterator>>
+          new_cell_vertices;
+
         for (int level = triangulation.levels.size() - 2; level >= 0; --level)
           {
             typename Triangulation<dim, spacedim>::active_cell_iterator
@@ -4816,9 +4895,10 @@ namespace internal
 
                   // Now we always ask the cell itself where to put
                   // the new point. The cell in turn will query the
-                  // manifold object internally.
-                  triangulation.vertices[next_unused_vertex] =
-                    cell->center(true);
+                  // manifold object internally. This happens for all
+                  // cells at once after the loop.
+                  new_cell_vertices.push_back(
+                    {next_unused_vertex, cell, false});
 
                   triangulation.vertices_used[next_unused_vertex] = true;
 
@@ -4929,11 +5009,16 @@ namespace internal
                           right_neighbor->set_neighbor(nbnb, second_child);
                         }
                     }
-                  // inform all listeners that cell refinement is done
-                  triangulation.signals.post_refinement_on_cell(cell);
+                  refined_cells.push_back(cell);
                 }
           }
 
+        compute_new_vertex_locations(triangulation, new_cell_vertices);
+
+        // inform all listeners that cell refinement is done
+        for (const auto &cell : refined_cells)
+          triangulation.signals.post_refinement_on_cell(cell);
+
         // in 1d, we can not have distorted children unless the parent
         // was already distorted (that is because we don't use
         // boundary information for 1d triangulations). so return an
@@ -5113,7 +5198,8 @@ namespace internal
         unsigned int next_unused_vertex = 0;
 
         // first the refinement of lines.  children are stored
-        // pairwise
+        // pairwise. the locations of the new vertices are computed
+        // once all lines have been refined
         {
           // only active objects can be refined further
           typename Triangulation<dim, spacedim>::active_line_iterator
@@ -5122,6 +5208,10 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          std::vector<
+            NewVertex<typename Triangulation<dim, spacedim>::line_iterator>>
+            new_line_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5137,9 +5227,9 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                new_line_vertices.push_back({next_unused_vertex, line, false});
 
-                // now that we created the right point, make up the
+                // now that we reserved the right point, make up the
                 // two child lines.  To this end, find a pair of
                 // unused lines
                 bool pair_found = false;
@@ -5202,6 +5292,8 @@ namespace internal
                 // refinement
                 line->clear_user_flag();
               }
+
+          compute_new_vertex_locations(triangulation, new_line_vertices);
         }
 
 
@@ -5219,6 +5311,12 @@ namespace internal
         typename Triangulation<dim, spacedim>::raw_line_iterator
           next_unused_line = triangulation.begin_raw_line();
 
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          refined_cells;
+        std::vector<
+          NewVertex<typename Triangulation<dim, spacedim>::cell_iterator>>
+          new_cell_vertices;
+
         for (int level = 0;
              level < static_cast<int>(triangulation.levels.size()) - 1;
              ++level)
@@ -5250,20 +5348,28 @@ namespace internal
                                   next_unused_vertex,
                                   next_unused_line,
                                   next_unused_cell,
-                                  cell);
-
-                  if ((check_for_distorted_cells == true) &&
-                      has_distorted_children(
-                        cell,
-                        std::integral_constant<int, dim>(),
-                        std::integral_constant<int, spacedim>()))
-                    cells_with_distorted_children.distorted_cells.push_back(
-                      cell);
-                  // inform all listeners that cell refinement is done
-                  triangulation.signals.post_refinement_on_cell(cell);
+                                  cell,
+                                  new_cell_vertices);
+                  refined_cells.push_back(cell);
                 }
           }
 
+        // now that all children exist, place the new vertices at the
+        // centers of the refined cells. only then can we check the
+        // children for distortion and tell the listeners about them
+        compute_new_vertex_locations(triangulation, new_cell_vertices);
+
+        for (const auto &cell : refined_cells)
+          {
+            if ((check_for_distorted_cells == true) &&
+                has_distorted_children(cell,
+                                       std::integral_constant<int, dim>(),
+                                       std::integral_constant<int, spacedim>()))
+              cells_with_distorted_children.distorted_cells.push_back(cell);
+            // inform all listeners that cell refinement is done
+            triangulation.signals.post_refinement_on_cell(cell);
+          }
+
         return cells_with_distorted_children;
       }
 
@@ -5593,7 +5699,8 @@ namespace internal
         // index of next unused vertex
         unsigned int next_unused_vertex = 0;
 
-        // first for lines
+        // first for lines. the locations of the new vertices are
+        // computed once all lines have been refined
         {
           // only active objects can be refined further
           typename Triangulation<dim, spacedim>::active_line_iterator
@@ -5602,6 +5709,10 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          std::vector<
+            NewVertex<typename Triangulation<dim, spacedim>::line_iterator>>
+            new_line_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5617,9 +5728,9 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                new_line_vertices.push_back({next_unused_vertex, line, false});
 
-                // now that we created the right point, make up the
+                // now that we reserved the right point, make up the
                 // two child lines (++ takes care of the end of the
                 // vector)
                 next_unused_line =
@@ -5675,6 +5786,8 @@ namespace internal
                 // for refinement
                 line->clear_user_flag();
               }
+
+          compute_new_vertex_locations(triangulation, new_line_vertices);
         }
 
 
@@ -5703,6 +5816,15 @@ namespace internal
 
         // we need a loop in cases c) and d), as the anisotropic
         // children migt have a lower index than the mother quad
+        //
+        // the locations of the vertices created at the centers of the
+        // quads and of their middle lines are computed after the loop
+        std::vector<
+          NewVertex<typename Triangulation<dim, spacedim>::line_iterator>>
+          new_line_vertices;
+        std::vector<
+          NewVertex<typename Triangulation<dim, spacedim>::quad_iterator>>
+          new_quad_vertices;
         for (unsigned int loop = 0; loop < 2; ++loop)
           {
             // usually, only active objects can be refined
@@ -6076,6 +6198,14 @@ namespace internal
                             // over all cells on all levels and look
                             // for faces n+1 (switch_1) and n+2
                             // (switch_2).
+                            //
+                            // since this moves quads to other
+                            // places, first compute the new
+                            // vertices on the quads refined so far
+                            compute_new_vertex_locations(triangulation,
+                                                         new_quad_vertices);
+                            new_quad_vertices.clear();
+
                             const typename Triangulation<dim, spacedim>::
                               quad_iterator switch_1 = quad->child(1),
                                             switch_2 = quad->child(2);
@@ -6289,8 +6419,8 @@ namespace internal
                             // quads can only happen in the interior
                             // of the domain, so we need not care
                             // about boundary quads here
-                            triangulation.vertices[next_unused_vertex] =
-                              middle_line->center(true);
+                            new_line_vertices.push_back(
+                              {next_unused_vertex, middle_line, false});
                             triangulation.vertices_used[next_unused_vertex] =
                               true;
 
@@ -6383,8 +6513,10 @@ namespace internal
                     // optimal shape. their description uses the formulas
                     // underlying the TransfiniteInterpolationManifold
                     // implementation
-                    triangulation.vertices[next_unused_vertex] =
-                      quad->center(true, true);
+                    //
+                    // the location is computed once all quads are refined
+                    new_quad_vertices.push_back(
+                      {next_unused_vertex, quad, true});
                     triangulation.vertices_used[next_unused_vertex] = true;
 
                     // now that we created the right point, make up
@@ -6631,6 +6763,9 @@ namespace internal
               }     // for all quads
           }         // looped two times over all quads, all quads refined now
 
+        compute_new_vertex_locations(triangulation, new_line_vertices);
+        compute_new_vertex_locations(triangulation, new_quad_vertices);
+
         ///////////////////////////////////
         // Now, finally, set up the new
         // cells
@@ -6639,6 +6774,15 @@ namespace internal
         typename Triangulation<3, spacedim>::DistortedCellList
           cells_with_distorted_children;
 
+        // as above, the vertices at the centers of the refined hexes are
+        // placed once all of them have been refined, and only then can
+        // the children be checked for distortion
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          refined_hexes;
+        std::vector<
+          NewVertex<typename Triangulation<dim, spacedim>::cell_iterator>>
+          new_hex_vertices;
+
         for (unsigned int level = 0; level != triangulation.levels.size() - 1;
              ++level)
           {
@@ -8951,9 +9095,9 @@ namespace internal
                           // boundary. However we need to worry about
                           // Manifolds. Let the cell compute its own
                           // center, by querying the underlying manifold
-                          // object.
-                          triangulation.vertices[next_unused_vertex] =
-                            hex->center(true, true);
+                          // object, once all hexes are refined.
+                          new_hex_vertices.push_back(
+                            {next_unused_vertex, hex, true});
 
                           // set the data of the six lines.  first collect
                           // the indices of the seven vertices (consider
@@ -9710,24 +9854,28 @@ namespace internal
                         new_hexes[current_child]->set_face_rotation(f, f_ro[f]);
                       }
 
-                  // now see if we have created cells that are
-                  // distorted and if so add them to our list
-                  if ((check_for_distorted_cells == true) &&
-                      has_distorted_children(
-                        hex,
-                        std::integral_constant<int, dim>(),
-                        std::integral_constant<int, spacedim>()))
-                    cells_with_distorted_children.distorted_cells.push_back(
-                      hex);
-
                   // note that the refinement flag was already cleared
                   // at the beginning of this loop
-
-                  // inform all listeners that cell refinement is done
-                  triangulation.signals.post_refinement_on_cell(hex);
+                  refined_hexes.push_back(hex);
                 }
           }
 
+        compute_new_vertex_locations(triangulation, new_hex_vertices);
+
+        for (const auto &hex : refined_hexes)
+          {
+            // now see if we have created cells that are
+            // distorted and if so add them to our list
+            if ((check_for_distorted_cells == true) &&
+                has_distorted_children(hex,
+                                       std::integral_constant<int, dim>(),
+                                       std::integral_constant<int, spacedim>()))
+              cells_with_distorted_children.distorted_cells.push_back(hex);
+
+            // inform all listeners that cell refinement is done
+            triangulation.signals.post_refinement_on_cell(hex);
+          }
+
         // clear user data on quads. we used some of this data to
         // indicate anisotropic refinemnt cases on faces. all data
         // should be cleared by now, but the information whether we
@@ -15104,6 +15252,463 @@ Triangulation<dim, spacedim>::read_bool_vector(const unsigned int magic_number1,
 
 
 
+namespace
+{
+  // the first bytes of a file written by Triangulation::save_checkpoint(),
+  // followed by the version of the format. increase the version whenever
+  // the layout of the internal arrays changes
+  const char checkpoint_magic[8] = {'d', 'e', 'a', 'l', 'I', 'I', 't', 'r'};
+  const std::uint32_t checkpoint_format_version = 1;
+
+  // a value whose byte pattern tells apart machines with different
+  // endianness
+  const std::uint32_t checkpoint_byte_order = 0x01020304;
+
+  // arrays start at multiples of this many bytes from the beginning of
+  // the file, so that a file mapped into memory could be used in place
+  const std::size_t checkpoint_alignment = 8;
+
+
+  /**
+   * An archive in the sense of BOOST serialization that writes the internal
+   * data of a triangulation into a flat buffer. Objects of classes that can
+   * be copied bitwise, as well as arrays of them, are written as plain
+   * bytes; the latter in a single block. Vectors of bools are written as
+   * bit fields. All other classes are written through their serialize()
+   * functions, which in turn call operator& of this class.
+   */
+  class CheckpointWriter
+  {
+  public:
+    template <typename T>
+    CheckpointWriter &
+    operator&(const T &t)
+    {
+      write(t);
+      return *this;
+    }
+
+    std::vector<char> buffer;
+
+  private:
+    void
+    write_bytes(const void *data, const std::size_t n_bytes)
+    {
+      const char *begin = static_cast<const char *>(data);
+      buffer.insert(buffer.end(), begin, begin + n_bytes);
+    }
+
+    void
+    align()
+    {
+      buffer.resize((buffer.size() + checkpoint_alignment - 1) /
+                    checkpoint_alignment * checkpoint_alignment);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+    write(const T &t)
+    {
+      write_bytes(&t, sizeof(T));
+    }
+
+    template <typename T>
+    typename std::enable_if<!std::is_trivially_copyable<T>::value>::type
+    write(const T &t)
+    {
+      const_cast<T &>(t).serialize(*this, 0);
+    }
+
+    template <typename T>
+    void
+    write(const std::vector<T> &v)
+    {
+      write(static_cast<std::uint64_t>(v.size()));
+      if (std::is_trivially_copyable<T>::value)
+        {
+          align();
+          write_bytes(v.data(), v.size() * sizeof(T));
+        }
+      else
+        for (const T &t : v)
+          write(t);
+    }
+
+    void
+    write(const std::vector<bool> &v)
+    {
+      write(static_cast<std::uint64_t>(v.size()));
+      align();
+      std::vector<unsigned char> flags(v.size() / 8 + 1, 0);
+      for (std::size_t position = 0; position != v.size(); ++position)
+        if (v[position])
+          flags[position / 8] |= (1 << (position % 8));
+      write_bytes(flags.data(), flags.size());
+    }
+
+    template <typename T1, typename T2>
+    void
+    write(const std::pair<T1, T2> &p)
+    {
+      write(p.first);
+      write(p.second);
+    }
+
+    template <typename Key, typename Value>
+    void
+    write(const std::map<Key, Value> &m)
+    {
+      write(static_cast<std::uint64_t>(m.size()));
+      for (const auto &p : m)
+        write(p);
+    }
+  };
+
+
+
+  /**
+   * The counterpart of CheckpointWriter: read the internal data of a
+   * triangulation from a buffer holding the content of a whole file.
+   */
+  class CheckpointReader
+  {
+  public:
+    CheckpointReader(const std::vector<char> &buffer)
+      : buffer(buffer)
+      , position(0)
+    {}
+
+    template <typename T>
+    CheckpointReader &
+    operator&(T &t)
+    {
+      read(t);
+      return *this;
+    }
+
+    bool
+    at_end() const
+    {
+      return position == buffer.size();
+    }
+
+    std::size_t
+    remaining_bytes() const
+    {
+      return (position < buffer.size() ? buffer.size() - position : 0);
+    }
+
+  private:
+    const std::vector<char> &buffer;
+    std::size_t              position;
+
+    void
+    read_bytes(void *data, const std::size_t n_bytes)
+    {
+      AssertThrow(position + n_bytes <= buffer.size(),
+                  ExcMessage("The checkpoint file ends before all data of "
+                             "the triangulation could be read."));
+      std::memcpy(data, buffer.data() + position, n_bytes);
+      position += n_bytes;
+    }
+
+    void
+    align()
+    {
+      position = (position + checkpoint_alignment - 1) /
+                 checkpoint_alignment * checkpoint_alignment;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+    read(T &t)
+    {
+      read_bytes(&t, sizeof(T));
+    }
+
+    template <typename T>
+    typename std::enable_if<!std::is_trivially_copyable<T>::value>::type
+    read(T &t)
+    {
+      t.serialize(*this, 0);
+    }
+
+    // read the number of elements of an array, each of which takes at
+    // least the given number of bytes in the file, and check that they fit
+    // into the rest of the buffer before any memory is allocated for them
+    std::size_t
+    read_size(const std::size_t bytes_per_element)
+    {
+      std::uint64_t size = 0;
+      read(size);
+      AssertThrow(size <= remaining_bytes() / bytes_per_element,
+                  ExcMessage("The checkpoint file is corrupted."));
+      return size;
+    }
+
+    template <typename T>
+    void
+    read(std::vector<T> &v)
+    {
+      v.resize(read_size(std::is_trivially_copyable<T>::value ? sizeof(T) :
+                                                                1));
+      if (std::is_trivially_copyable<T>::value)
+        {
+          align();
+          read_bytes(v.data(), v.size() * sizeof(T));
+        }
+      else
+        for (T &t : v)
+          read(t);
+    }
+
+    void
+    read(std::vector<bool> &v)
+    {
+      // eight flags per byte, plus one byte at the end
+      const std::size_t size = read_size(1);
+      AssertThrow(size / 8 < remaining_bytes(),
+                  ExcMessage("The checkpoint file is corrupted."));
+      v.resize(size);
+      align();
+      std::vector<unsigned char> flags(v.size() / 8 + 1);
+      read_bytes(flags.data(), flags.size());
+      for (std::size_t position = 0; position != v.size(); ++position)
+        v[position] = (flags[position / 8] & (1 << (position % 8)));
+    }
+
+    template <typename T1, typename T2>
+    void
+    read(std::pair<T1, T2> &p)
+    {
+      read(p.first);
+      read(p.second);
+    }
+
+    template <typename Key, typename Value>
+    void
+    read(std::map<Key, Value> &m)
+    {
+      m.clear();
+      const std::size_t size = read_size(sizeof(Key));
+      for (std::size_t i = 0; i < size; ++i)
+        {
+          std::pair<Key, Value> p;
+          read(p);
+          m.insert(m.end(), p);
+        }
+    }
+  };
+
+
+
+  // write or read the header of a checkpoint file: everything the layout
+  // of the remaining data depends on
+  template <int dim, int spacedim, class Archive>
+  void
+  checkpoint_header(Archive &ar)
+  {
+    const std::uint32_t header[] = {checkpoint_format_version,
+                                    checkpoint_byte_order,
+                                    dim,
+                                    spacedim,
+                                    sizeof(unsigned int),
+                                    sizeof(double),
+                                    sizeof(types::boundary_id),
+                                    sizeof(types::manifold_id),
+                                    sizeof(types::subdomain_id)};
+    for (const char c : checkpoint_magic)
+      {
+        char file_c = c;
+        ar &file_c;
+        AssertThrow(file_c == c,
+                    ExcMessage("The file is not a triangulation checkpoint "
+                               "written by Triangulation::save_checkpoint()."));
+      }
+    for (const std::uint32_t h : header)
+      {
+        std::uint32_t file_h = h;
+        ar &          file_h;
+        AssertThrow(file_h == h,
+                    ExcMessage("The triangulation checkpoint was written "
+                               "with a different version of the format, on "
+                               "a machine with a different data layout, or "
+                               "for a triangulation of different dimensions."));
+      }
+  }
+} // namespace
+
+
+
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::save_checkpoint(const std::string &filename) const
+{
+  CheckpointWriter ar;
+  checkpoint_header<dim, spacedim>(ar);
+
+  // store the same data as save(), in the same order
+  ar &smooth_grid;
+
+  const unsigned int n_levels = levels.size();
+  ar &               n_levels;
+  for (const auto &level : levels)
+    ar &*level;
+
+  const bool faces_is_nullptr = (faces.get() == nullptr);
+  ar &       faces_is_nullptr;
+  if (!faces_is_nullptr)
+    ar &*faces;
+
+  ar &vertices;
+  ar &vertices_used;
+
+  ar &anisotropic_refinement;
+  ar &number_cache;
+
+  ar &check_for_distorted_cells;
+
+  if (dim == 1)
+    {
+      ar &*vertex_to_boundary_id_map_1d;
+      ar &*vertex_to_manifold_id_map_1d;
+    }
+
+  std::ofstream out(filename, std::ios::binary);
+  AssertThrow(out, ExcFileNotOpen(filename));
+  out.write(ar.buffer.data(), ar.buffer.size());
+  AssertThrow(out, ExcIO());
+}
+
+
+
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::load_checkpoint(const std::string &filename)
+{
+  // read the whole file at once
+  std::vector<char> buffer;
+  {
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    AssertThrow(in, ExcFileNotOpen(filename));
+    buffer.resize(in.tellg());
+    in.seekg(0);
+    in.read(buffer.data(), buffer.size());
+    AssertThrow(in, ExcIO());
+  }
+
+  CheckpointReader ar(buffer);
+  checkpoint_header<dim, spacedim>(ar);
+
+  // read everything into local objects first, so that a corrupt file
+  // leaves the current content of the triangulation alone
+  MeshSmoothing my_smooth_grid;
+  ar &          my_smooth_grid;
+
+  unsigned int n_levels;
+  ar &         n_levels;
+  // every level takes at least one byte in the file
+  AssertThrow(n_levels <= ar.remaining_bytes(),
+              ExcMessage("The checkpoint file is corrupted."));
+  std::vector<
+    std::unique_ptr<internal::TriangulationImplementation::TriaLevel<dim>>>
+    my_levels(n_levels);
+  for (auto &level : my_levels)
+    {
+      level = std_cxx14::make_unique<
+        internal::TriangulationImplementation::TriaLevel<dim>>();
+      ar &*level;
+    }
+
+  std::unique_ptr<internal::TriangulationImplementation::TriaFaces<dim>>
+       my_faces;
+  bool faces_is_nullptr = true;
+  ar & faces_is_nullptr;
+  if (!faces_is_nullptr)
+    {
+      my_faces = std_cxx14::make_unique<
+        internal::TriangulationImplementation::TriaFaces<dim>>();
+      ar &*my_faces;
+    }
+
+  std::vector<Point<spacedim>> my_vertices;
+  std::vector<bool>            my_vertices_used;
+  ar &                         my_vertices;
+  ar &                         my_vertices_used;
+
+  bool my_anisotropic_refinement;
+  ar & my_anisotropic_refinement;
+  internal::TriangulationImplementation::NumberCache<dim> my_number_cache;
+  ar &                                                    my_number_cache;
+
+  bool my_check_for_distorted_cells;
+  ar & my_check_for_distorted_cells;
+  AssertThrow(my_check_for_distorted_cells == check_for_distorted_cells,
+              ExcMessage("The triangulation loaded into here must have the "
+                         "same setting with regard to reporting distorted "
+                         "cell as the one previously stored."));
+
+  std::map<unsigned int, types::boundary_id> my_vertex_to_boundary_id_map_1d;
+  std::map<unsigned int, types::manifold_id> my_vertex_to_manifold_id_map_1d;
+  if (dim == 1)
+    {
+      ar &my_vertex_to_boundary_id_map_1d;
+      ar &my_vertex_to_manifold_id_map_1d;
+    }
+
+  AssertThrow(ar.at_end(),
+              ExcMessage("The checkpoint file contains more data than "
+                         "expected."));
+
+  // clear previous content. this also calls the respective signal
+  clear();
+
+  smooth_grid = my_smooth_grid;
+  levels.swap(my_levels);
+  faces = std::move(my_faces);
+  vertices.swap(my_vertices);
+  vertices_used.swap(my_vertices_used);
+  anisotropic_refinement = my_anisotropic_refinement;
+  number_cache           = my_number_cache;
+  if (dim == 1)
+    {
+      vertex_to_boundary_id_map_1d->swap(my_vertex_to_boundary_id_map_1d);
+      vertex_to_manifold_id_map_1d->swap(my_vertex_to_manifold_id_map_1d);
+    }
+
+  // as in load(), rebuild the active cell indices rather than storing them
+  for (auto &level : levels)
+    level->active_cell_indices.resize(level->refine_flags.size());
+  reset_active_cell_indices();
+
+  // trigger the create signal to indicate that new content has been
+  // imported into the triangulation
+  signals.create();
+}
+
+
+
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::compact_storage()
+{
+  for (const auto &level : levels)
+    level->compact_storage();
+
+  // cells on the coarsest level have no parents, so their parent indices
+  // are never read
+  if (levels.size() > 0)
+    std::vector<int>().swap(levels[0]->parents);
+
+  if (faces)
+    faces->compact_storage();
+
+  vertices.shrink_to_fit();
+  vertices_used.shrink_to_fit();
+}
+
+
+
 template <int dim, int spacedim>
 std::size_t
 Triangulation<dim, spacedim>::memory_consumption() const
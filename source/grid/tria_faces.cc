@@ -25,6 +25,26 @@ namespace internal
 {
   namespace TriangulationImplementation
   {
+    void
+    TriaFaces<1>::compact_storage()
+    {}
+
+
+    void
+    TriaFaces<2>::compact_storage()
+    {
+      lines.compact_storage();
+    }
+
+
+    void
+    TriaFaces<3>::compact_storage()
+    {
+      quads.compact_storage();
+      lines.compact_storage();
+    }
+
+
     std::size_t
     TriaFaces<1>::memory_consumption() const
     {
@@ -98,6 +98,22 @@ namespace internal
     }
 
 
+    template <int dim>
+    void
+    TriaLevel<dim>::compact_storage()
+    {
+      refine_flags.shrink_to_fit();
+      coarsen_flags.shrink_to_fit();
+      active_cell_indices.shrink_to_fit();
+      neighbors.shrink_to_fit();
+      subdomain_ids.shrink_to_fit();
+      level_subdomain_ids.shrink_to_fit();
+      parents.shrink_to_fit();
+      direction_flags.shrink_to_fit();
+      cells.compact_storage();
+    }
+
+
     template <int dim>
     std::size_t
     TriaLevel<dim>::memory_consumption() const
@@ -189,6 +205,21 @@ namespace internal
     }
 
 
+    void
+    TriaLevel<3>::compact_storage()
+    {
+      refine_flags.shrink_to_fit();
+      coarsen_flags.shrink_to_fit();
+      active_cell_indices.shrink_to_fit();
+      neighbors.shrink_to_fit();
+      subdomain_ids.shrink_to_fit();
+      level_subdomain_ids.shrink_to_fit();
+      parents.shrink_to_fit();
+      direction_flags.shrink_to_fit();
+      cells.compact_storage();
+    }
+
+
     std::size_t
     TriaLevel<3>::memory_consumption() const
     {
@@ -197,6 +228,7 @@ namespace internal
               MemoryConsumption::memory_consumption(active_cell_indices) +
               MemoryConsumption::memory_consumption(neighbors) +
               MemoryConsumption::memory_consumption(subdomain_ids) +
+              MemoryConsumption::memory_consumption(level_subdomain_ids) +
               MemoryConsumption::memory_consumption(parents) +
               MemoryConsumption::memory_consumption(direction_flags) +
               MemoryConsumption::memory_consumption(cells));
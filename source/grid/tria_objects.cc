@@ -83,6 +83,11 @@ namespace internal
       if (additional_single_objects > 0)
         new_size += additional_single_objects;
 
+      // arrays released by compact_storage() stay released; the functions
+      // writing to them recreate them at the size of the cells array
+      const bool children_released  = (children.empty() && !cells.empty());
+      const bool user_data_released = (user_data.empty() && !cells.empty());
+
       // only allocate space if necessary
       if (new_size > cells.size())
         {
@@ -97,20 +102,23 @@ namespace internal
                             new_size - user_flags.size(),
                             false);
 
-          const unsigned int factor =
-            GeometryInfo<G::dimension>::max_children_per_cell / 2;
-          children.reserve(factor * new_size);
-          children.insert(children.end(),
-                          factor * new_size - children.size(),
-                          -1);
-
-          if (G::dimension > 1)
+          if (!children_released)
             {
-              refinement_cases.reserve(new_size);
-              refinement_cases.insert(
-                refinement_cases.end(),
-                new_size - refinement_cases.size(),
-                RefinementCase<G::dimension>::no_refinement);
+              const unsigned int factor =
+                GeometryInfo<G::dimension>::max_children_per_cell / 2;
+              children.reserve(factor * new_size);
+              children.insert(children.end(),
+                              factor * new_size - children.size(),
+                              -1);
+
+              if (G::dimension > 1)
+                {
+                  refinement_cases.reserve(new_size);
+                  refinement_cases.insert(
+                    refinement_cases.end(),
+                    new_size - refinement_cases.size(),
+                    RefinementCase<G::dimension>::no_refinement);
+                }
             }
 
           // first reserve, then resize. Otherwise the std library can decide to
@@ -118,8 +126,11 @@ namespace internal
           boundary_or_material_id.reserve(new_size);
           boundary_or_material_id.resize(new_size);
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          if (!user_data_released)
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
           manifold_id.reserve(new_size);
           manifold_id.insert(manifold_id.end(),
@@ -173,6 +184,9 @@ namespace internal
         new_hexes + std::count(used.begin(), used.end(), true);
 
       // see above...
+      const bool children_released  = (children.empty() && !cells.empty());
+      const bool user_data_released = (user_data.empty() && !cells.empty());
+
       if (new_size > cells.size())
         {
           cells.reserve(new_size);
@@ -186,8 +200,18 @@ namespace internal
                             new_size - user_flags.size(),
                             false);
 
-          children.reserve(4 * new_size);
-          children.insert(children.end(), 4 * new_size - children.size(), -1);
+          if (!children_released)
+            {
+              children.reserve(4 * new_size);
+              children.insert(children.end(),
+                              4 * new_size - children.size(),
+                              -1);
+
+              refinement_cases.reserve(new_size);
+              refinement_cases.insert(refinement_cases.end(),
+                                      new_size - refinement_cases.size(),
+                                      RefinementCase<3>::no_refinement);
+            }
 
           // for the following fields, we know exactly how many elements
           // we need, so first reserve then resize (resize itself, at least
@@ -201,8 +225,11 @@ namespace internal
                              new_size - manifold_id.size(),
                              numbers::flat_manifold_id);
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          if (!user_data_released)
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
           face_orientations.reserve(new_size * GeometryInfo<3>::faces_per_cell);
           face_orientations.insert(face_orientations.end(),
@@ -210,11 +237,6 @@ namespace internal
                                      face_orientations.size(),
                                    true);
 
-          refinement_cases.reserve(new_size);
-          refinement_cases.insert(refinement_cases.end(),
-                                  new_size - refinement_cases.size(),
-                                  RefinementCase<3>::no_refinement);
-
           face_flips.reserve(new_size * GeometryInfo<3>::faces_per_cell);
           face_flips.insert(face_flips.end(),
                             new_size * GeometryInfo<3>::faces_per_cell -
@@ -309,13 +331,13 @@ namespace internal
              ExcMemoryInexact(cells.size(), used.size()));
       Assert(cells.size() == user_flags.size(),
              ExcMemoryInexact(cells.size(), user_flags.size()));
-      Assert(cells.size() == children.size(),
+      Assert(children.empty() || cells.size() == children.size(),
              ExcMemoryInexact(cells.size(), children.size()));
       Assert(cells.size() == boundary_or_material_id.size(),
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.empty() || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -328,15 +350,15 @@ namespace internal
              ExcMemoryInexact(cells.size(), used.size()));
       Assert(cells.size() == user_flags.size(),
              ExcMemoryInexact(cells.size(), user_flags.size()));
-      Assert(2 * cells.size() == children.size(),
+      Assert(children.empty() || 2 * cells.size() == children.size(),
              ExcMemoryInexact(cells.size(), children.size()));
-      Assert(cells.size() == refinement_cases.size(),
+      Assert(children.empty() || cells.size() == refinement_cases.size(),
              ExcMemoryInexact(cells.size(), refinement_cases.size()));
       Assert(cells.size() == boundary_or_material_id.size(),
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.empty() || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -348,13 +370,13 @@ namespace internal
              ExcMemoryInexact(cells.size(), used.size()));
       Assert(cells.size() == user_flags.size(),
              ExcMemoryInexact(cells.size(), user_flags.size()));
-      Assert(4 * cells.size() == children.size(),
+      Assert(children.empty() || 4 * cells.size() == children.size(),
              ExcMemoryInexact(cells.size(), children.size()));
       Assert(cells.size() == boundary_or_material_id.size(),
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.empty() || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
       Assert(cells.size() * GeometryInfo<3>::faces_per_cell ==
                face_orientations.size(),
@@ -419,6 +441,60 @@ namespace internal
     }
 
 
+    template <typename G>
+    void
+    TriaObjects<G>::compact_storage()
+    {
+      // without children, all refinement cases are no_refinement as well,
+      // so neither array carries any information
+      if (std::find_if(children.begin(), children.end(), [](const int c) {
+            return c != -1;
+          }) == children.end())
+        {
+          std::vector<int>().swap(children);
+          std::vector<RefinementCase<G::dimension>>().swap(refinement_cases);
+        }
+
+      // clear_user_data(i) only resets the index part of the union, so for
+      // user indices the upper bytes of the pointer may not be zero
+      if (std::find_if(user_data.begin(),
+                       user_data.end(),
+                       [this](const UserData &data) {
+                         return (user_data_type == data_index ?
+                                   data.i != 0 :
+                                   data.p != nullptr);
+                       }) == user_data.end())
+        std::vector<UserData>().swap(user_data);
+
+      cells.shrink_to_fit();
+      children.shrink_to_fit();
+      refinement_cases.shrink_to_fit();
+      used.shrink_to_fit();
+      user_flags.shrink_to_fit();
+      boundary_or_material_id.shrink_to_fit();
+      manifold_id.shrink_to_fit();
+      user_data.shrink_to_fit();
+    }
+
+
+    void
+    TriaObjectsHex::compact_storage()
+    {
+      TriaObjects<TriaObject<3>>::compact_storage();
+      face_orientations.shrink_to_fit();
+      face_flips.shrink_to_fit();
+      face_rotations.shrink_to_fit();
+    }
+
+
+    void
+    TriaObjectsQuad3D::compact_storage()
+    {
+      TriaObjects<TriaObject<2>>::compact_storage();
+      line_orientations.shrink_to_fit();
+    }
+
+
     template <typename G>
     std::size_t
     TriaObjects<G>::memory_consumption() const
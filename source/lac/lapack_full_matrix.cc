@@ -18,6 +18,7 @@
 #include <deal.II/lac/blas_extension_templates.h>
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/full_matrix_kernels.h>
 #include <deal.II/lac/lapack_full_matrix.h>
 #include <deal.II/lac/lapack_support.h>
 #include <deal.II/lac/lapack_templates.h>
@@ -237,6 +238,25 @@ namespace internal
             integer_work.data(),
             &info);
     }
+
+
+
+    // whether a product with the given dimensions is small enough to be
+    // computed with the kernels in FullMatrixKernels rather than with gemm.
+    // the kernels work on row-major data, so the column-major values of a
+    // LAPACKFullMatrix are passed to them as the transpose of the matrix
+    template <typename number>
+    bool
+    use_small_kernels(const types::blas_int m,
+                      const types::blas_int n,
+                      const types::blas_int k)
+    {
+      const std::size_t product_size = std::size_t(m) * n * k;
+      return VectorizedArray<number>::n_array_elements > 1 &&
+             product_size != 0 &&
+             product_size <=
+               FullMatrixKernels::max_product_size_below_blas;
+    }
   } // namespace LAPACKFullMatrixImplementation
 } // namespace internal
 
@@ -954,6 +974,24 @@ LAPACKFullMatrix<number>::mmult(LAPACKFullMatrix<number> &      C,
   const number          alpha = 1.;
   const number          beta  = (adding ? 1. : 0.);
 
+  // C^T = B^T A^T
+  if (internal::LAPACKFullMatrixImplementation::use_small_kernels<number>(mm,
+                                                                         nn,
+                                                                         kk))
+    {
+      internal::FullMatrixKernels::gemm<false>(nn,
+                                               mm,
+                                               kk,
+                                               B.values.data(),
+                                               kk,
+                                               this->values.data(),
+                                               mm,
+                                               C.values.data(),
+                                               mm,
+                                               adding);
+      return;
+    }
+
   gemm("N",
        "N",
        &mm,
@@ -1143,6 +1181,21 @@ LAPACKFullMatrix<number>::Tmmult(LAPACKFullMatrix<number> &      C,
 
       C.property = symmetric;
     }
+  else if (internal::LAPACKFullMatrixImplementation::use_small_kernels<
+             number>(mm, nn, kk))
+    {
+      // C^T = B^T A
+      internal::FullMatrixKernels::gemm_transpose_b(nn,
+                                                    mm,
+                                                    kk,
+                                                    B.values.data(),
+                                                    kk,
+                                                    this->values.data(),
+                                                    kk,
+                                                    C.values.data(),
+                                                    mm,
+                                                    adding);
+    }
   else
     {
       gemm("T",
@@ -1180,7 +1233,26 @@ LAPACKFullMatrix<number>::Tmmult(FullMatrix<number> &            C,
   const number          beta  = (adding ? 1. : 0.);
 
   // since FullMatrix stores the matrix in transposed order compared to this
-  // matrix, compute B^T * A = (A^T * B)^T
+  // matrix, the entries of A^T * B are scalar products of the stored
+  // columns of A and B
+  if (internal::LAPACKFullMatrixImplementation::use_small_kernels<number>(mm,
+                                                                         nn,
+                                                                         kk))
+    {
+      internal::FullMatrixKernels::gemm_transpose_b(mm,
+                                                    nn,
+                                                    kk,
+                                                    this->values.data(),
+                                                    kk,
+                                                    B.values.data(),
+                                                    kk,
+                                                    &C(0, 0),
+                                                    nn,
+                                                    adding);
+      return;
+    }
+
+  // otherwise compute B^T * A = (A^T * B)^T
   gemm("T",
        "N",
        &nn,
@@ -1235,6 +1307,21 @@ LAPACKFullMatrix<number>::mTmult(LAPACKFullMatrix<number> &      C,
 
       C.property = symmetric;
     }
+  else if (internal::LAPACKFullMatrixImplementation::use_small_kernels<
+             number>(mm, nn, kk))
+    {
+      // C^T = B A^T
+      internal::FullMatrixKernels::gemm<true>(nn,
+                                              mm,
+                                              kk,
+                                              B.values.data(),
+                                              nn,
+                                              this->values.data(),
+                                              mm,
+                                              C.values.data(),
+                                              mm,
+                                              adding);
+    }
   else
     {
       gemm("N",
@@ -1273,7 +1360,26 @@ LAPACKFullMatrix<number>::mTmult(FullMatrix<number> &            C,
   const number          beta  = (adding ? 1. : 0.);
 
   // since FullMatrix stores the matrix in transposed order compared to this
-  // matrix, compute B * A^T = (A * B^T)^T
+  // matrix, the stored columns of A and B are the rows of A^T and B^T,
+  // whose product A * B^T = (A^T)^T * B^T the kernels compute directly
+  if (internal::LAPACKFullMatrixImplementation::use_small_kernels<number>(mm,
+                                                                         nn,
+                                                                         kk))
+    {
+      internal::FullMatrixKernels::gemm<true>(mm,
+                                              nn,
+                                              kk,
+                                              this->values.data(),
+                                              mm,
+                                              B.values.data(),
+                                              nn,
+                                              &C(0, 0),
+                                              nn,
+                                              adding);
+      return;
+    }
+
+  // otherwise compute B * A^T = (A * B^T)^T
   gemm("N",
        "T",
        &nn,
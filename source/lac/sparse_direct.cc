@@ -14,6 +14,8 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/timer.h>
 
 #include <deal.II/lac/block_sparse_matrix.h>
 #include <deal.II/lac/sparse_direct.h>
@@ -192,15 +194,8 @@ SparseDirectUMFPACK::sort_arrays(const BlockSparseMatrix<number> &matrix)
 
 template <class Matrix>
 void
-SparseDirectUMFPACK::factorize(const Matrix &matrix)
+SparseDirectUMFPACK::copy_matrix(const Matrix &matrix)
 {
-  Assert(matrix.m() == matrix.n(), ExcNotQuadratic())
-
-    clear();
-
-  _m = matrix.m();
-  _n = matrix.n();
-
   const size_type N = matrix.m();
 
   // copy over the data from the matrix to the data structures UMFPACK
@@ -266,45 +261,123 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   // careful for block sparse matrices, so ship this task out to a
   // different function
   sort_arrays(matrix);
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::analyze(const Matrix &matrix)
+{
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+
+  clear();
 
-  int status;
-  status = umfpack_dl_symbolic(N,
-                               N,
-                               Ap.data(),
-                               Ai.data(),
-                               Ax.data(),
-                               &symbolic_decomposition,
-                               control.data(),
-                               nullptr);
+  _m = matrix.m();
+  _n = matrix.n();
+
+  copy_matrix(matrix);
+
+  Timer timer;
+
+  const int status = umfpack_dl_symbolic(_m,
+                                         _n,
+                                         Ap.data(),
+                                         Ai.data(),
+                                         Ax.data(),
+                                         &symbolic_decomposition,
+                                         control.data(),
+                                         nullptr);
   AssertThrow(status == UMFPACK_OK,
               ExcUMFPACKError("umfpack_dl_symbolic", status));
 
-  status = umfpack_dl_numeric(Ap.data(),
-                              Ai.data(),
-                              Ax.data(),
-                              symbolic_decomposition,
-                              &numeric_decomposition,
-                              control.data(),
-                              nullptr);
+  statistics.analysis_time += timer.wall_time();
+  ++statistics.n_analyses;
+}
+
+
+
+void
+SparseDirectUMFPACK::numeric_factorization()
+{
+  Assert(symbolic_decomposition != nullptr, ExcNotInitialized());
+
+  if (numeric_decomposition != nullptr)
+    {
+      umfpack_dl_free_numeric(&numeric_decomposition);
+      numeric_decomposition = nullptr;
+    }
+
+  Timer timer;
+
+  const int status = umfpack_dl_numeric(Ap.data(),
+                                        Ai.data(),
+                                        Ax.data(),
+                                        symbolic_decomposition,
+                                        &numeric_decomposition,
+                                        control.data(),
+                                        nullptr);
   AssertThrow(status == UMFPACK_OK,
               ExcUMFPACKError("umfpack_dl_numeric", status));
 
-  umfpack_dl_free_symbolic(&symbolic_decomposition);
+  statistics.numeric_factorization_time += timer.wall_time();
+  ++statistics.n_numeric_factorizations;
 }
 
 
 
+template <class Matrix>
 void
-SparseDirectUMFPACK::solve(Vector<double> &rhs_and_solution,
-                           bool            transpose /*=false*/) const
+SparseDirectUMFPACK::factorize(const Matrix &matrix)
 {
-  // make sure that some kind of factorize() call has happened before
-  Assert(Ap.size() != 0, ExcNotInitialized());
-  Assert(Ai.size() != 0, ExcNotInitialized());
-  Assert(Ai.size() == Ax.size(), ExcNotInitialized());
+  analyze(matrix);
+  numeric_factorization();
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::factorize_numeric(const Matrix &matrix)
+{
+  Assert(symbolic_decomposition != nullptr,
+         ExcMessage("You need to call analyze() or factorize() before "
+                    "factorize_numeric()."));
+  AssertDimension(matrix.m(), _m);
+  AssertDimension(matrix.n(), _n);
+
+#ifdef DEBUG
+  const std::vector<types::suitesparse_index> Ap_old = Ap;
+  const std::vector<types::suitesparse_index> Ai_old = Ai;
+#endif
+
+  copy_matrix(matrix);
+
+  Assert(Ap == Ap_old && Ai == Ai_old,
+         ExcMessage("The sparsity pattern of the matrix differs from the one "
+                    "of the matrix passed to analyze()."));
+
+  numeric_factorization();
+}
+
+
+
+void
+SparseDirectUMFPACK::solve_with_workspace(
+  double *                               rhs_and_solution,
+  const bool                             transpose,
+  std::vector<types::suitesparse_index> &index_workspace,
+  std::vector<double> &                  workspace) const
+{
+  // umfpack_dl_wsolve needs n indices and, if iterative refinement is
+  // enabled, 5n values as work space. we need another n values to store the
+  // right hand side since it is overwritten by the solution
+  const bool with_refinement = control[UMFPACK_IRSTEP] > 0;
+  index_workspace.resize(_m);
+  workspace.resize((with_refinement ? 6 : 2) * _m);
 
-  Vector<double> rhs(rhs_and_solution.size());
-  rhs = rhs_and_solution;
+  double *rhs = workspace.data() + (with_refinement ? 5 : 1) * _m;
+  std::copy(rhs_and_solution, rhs_and_solution + _m, rhs);
 
   // solve the system. note that since UMFPACK wants compressed column
   // storage instead of the compressed row storage format we use in
@@ -312,17 +385,84 @@ SparseDirectUMFPACK::solve(Vector<double> &rhs_and_solution,
 
   // Conversely, if we solve for the transpose, we have to use UMFPACK_A
   // instead.
-  const int status = umfpack_dl_solve(transpose ? UMFPACK_A : UMFPACK_At,
-                                      Ap.data(),
-                                      Ai.data(),
-                                      Ax.data(),
-                                      rhs_and_solution.begin(),
-                                      rhs.begin(),
-                                      numeric_decomposition,
-                                      control.data(),
-                                      nullptr);
+  const int status = umfpack_dl_wsolve(transpose ? UMFPACK_A : UMFPACK_At,
+                                       Ap.data(),
+                                       Ai.data(),
+                                       Ax.data(),
+                                       rhs_and_solution,
+                                       rhs,
+                                       numeric_decomposition,
+                                       control.data(),
+                                       nullptr,
+                                       index_workspace.data(),
+                                       workspace.data());
   AssertThrow(status == UMFPACK_OK,
-              ExcUMFPACKError("umfpack_dl_solve", status));
+              ExcUMFPACKError("umfpack_dl_wsolve", status));
+}
+
+
+
+void
+SparseDirectUMFPACK::solve(Vector<double> &rhs_and_solution,
+                           bool            transpose /*=false*/) const
+{
+  // make sure that some kind of factorize() call has happened before
+  Assert(Ap.size() != 0, ExcNotInitialized());
+  Assert(Ai.size() != 0, ExcNotInitialized());
+  Assert(Ai.size() == Ax.size(), ExcNotInitialized());
+  Assert(numeric_decomposition != nullptr, ExcNotInitialized());
+  AssertDimension(rhs_and_solution.size(), _m);
+
+  Timer timer;
+
+  std::vector<types::suitesparse_index> index_workspace;
+  std::vector<double>                   workspace;
+  solve_with_workspace(rhs_and_solution.begin(),
+                       transpose,
+                       index_workspace,
+                       workspace);
+
+  std::lock_guard<std::mutex> lock(statistics_mutex);
+  statistics.solve_time += timer.wall_time();
+  ++statistics.n_solves;
+}
+
+
+
+void
+SparseDirectUMFPACK::solve(std::vector<Vector<double>> &rhs_and_solutions,
+                           const bool                   transpose) const
+{
+  // make sure that some kind of factorize() call has happened before
+  Assert(numeric_decomposition != nullptr, ExcNotInitialized());
+  for (const Vector<double> &v : rhs_and_solutions)
+    {
+      AssertDimension(v.size(), _m);
+      (void)v;
+    }
+
+  Timer timer;
+
+  // the numeric factorization is only read during the substitutions, so
+  // the vectors can be processed concurrently as long as every thread has
+  // its own work arrays
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(rhs_and_solutions.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      std::vector<types::suitesparse_index> index_workspace;
+      std::vector<double>                   workspace;
+      for (unsigned int i = begin; i < end; ++i)
+        solve_with_workspace(rhs_and_solutions[i].begin(),
+                             transpose,
+                             index_workspace,
+                             workspace);
+    },
+    1);
+
+  std::lock_guard<std::mutex> lock(statistics_mutex);
+  statistics.solve_time += timer.wall_time();
+  statistics.n_solves += rhs_and_solutions.size();
 }
 
 
@@ -391,6 +531,28 @@ SparseDirectUMFPACK::factorize(const Matrix &)
 }
 
 
+template <class Matrix>
+void
+SparseDirectUMFPACK::analyze(const Matrix &)
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::factorize_numeric(const Matrix &)
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
 void
 SparseDirectUMFPACK::solve(Vector<double> &, bool) const
 {
@@ -412,6 +574,17 @@ SparseDirectUMFPACK::solve(BlockVector<double> &, bool) const
 }
 
 
+
+void
+SparseDirectUMFPACK::solve(std::vector<Vector<double>> &, const bool) const
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
 template <class Matrix>
 void
 SparseDirectUMFPACK::solve(const Matrix &, Vector<double> &, bool)
@@ -495,17 +668,25 @@ SparseDirectUMFPACK::n() const
   return _n;
 }
 
+const SparseDirectUMFPACK::Statistics &
+SparseDirectUMFPACK::get_statistics() const
+{
+  return statistics;
+}
+
 
 // explicit instantiations for SparseMatrixUMFPACK
-#define InstantiateUMFPACK(MatrixType)                              \
-  template void SparseDirectUMFPACK::factorize(const MatrixType &); \
-  template void SparseDirectUMFPACK::solve(const MatrixType &,      \
-                                           Vector<double> &,        \
-                                           bool);                   \
-  template void SparseDirectUMFPACK::solve(const MatrixType &,      \
-                                           BlockVector<double> &,   \
-                                           bool);                   \
-  template void SparseDirectUMFPACK::initialize(const MatrixType &, \
+#define InstantiateUMFPACK(MatrixType)                                      \
+  template void SparseDirectUMFPACK::factorize(const MatrixType &);         \
+  template void SparseDirectUMFPACK::analyze(const MatrixType &);           \
+  template void SparseDirectUMFPACK::factorize_numeric(const MatrixType &); \
+  template void SparseDirectUMFPACK::solve(const MatrixType &,              \
+                                           Vector<double> &,                \
+                                           bool);                           \
+  template void SparseDirectUMFPACK::solve(const MatrixType &,              \
+                                           BlockVector<double> &,           \
+                                           bool);                           \
+  template void SparseDirectUMFPACK::initialize(const MatrixType &,         \
                                                 const AdditionalData)
 
 InstantiateUMFPACK(SparseMatrix<double>);
@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/utilities.h>
 
@@ -543,6 +544,74 @@ SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
 
 
 
+void
+SparsityPattern::copy_from(
+  const size_type                                    n_rows,
+  const size_type                                    n_cols,
+  const ArrayView<const ArrayView<const size_type>> &sorted_rows)
+{
+  AssertDimension(sorted_rows.size(), n_rows);
+
+  // the rows are independent of each other, but each of them is short, so
+  // only hand out chunks of many rows to the threads
+  const unsigned int grain_size = 1024;
+
+  // if the matrix is quadratic, then we might have to add an additional
+  // entry for the diagonal, if that is not yet present. since the rows are
+  // sorted, we can find out with a binary search
+  const bool                do_diag_optimize = (n_rows == n_cols);
+  std::vector<unsigned int> row_lengths(n_rows);
+  parallel::apply_to_subranges(
+    size_type(0),
+    n_rows,
+    [&](const size_type begin, const size_type end) {
+      for (size_type row = begin; row < end; ++row)
+        {
+          const ArrayView<const size_type> &columns = sorted_rows[row];
+          Assert(std::adjacent_find(columns.begin(),
+                                    columns.end(),
+                                    std::greater_equal<size_type>()) ==
+                   columns.end(),
+                 ExcMessage("The column indices of each row must be sorted "
+                            "and must not contain duplicates."));
+          row_lengths[row] = columns.size();
+          if (do_diag_optimize &&
+              !std::binary_search(columns.begin(), columns.end(), row))
+            ++row_lengths[row];
+        }
+    },
+    grain_size);
+  reinit(n_rows, n_cols, row_lengths);
+
+  // now enter all the elements into the matrix. note that if the matrix is
+  // quadratic, then we already have the diagonal element preallocated. every
+  // thread only writes into the rows it works on
+  if (this->n_rows() != 0 && this->n_cols() != 0)
+    parallel::apply_to_subranges(
+      size_type(0),
+      n_rows,
+      [&](const size_type begin, const size_type end) {
+        for (size_type row = begin; row < end; ++row)
+          {
+            size_type *cols =
+              &colnums[rowstart[row]] + (do_diag_optimize ? 1 : 0);
+            for (const size_type col : sorted_rows[row])
+              {
+                Assert(col < n_cols, ExcIndexRange(col, 0, n_cols));
+                if ((col != row) || !do_diag_optimize)
+                  *cols++ = col;
+              }
+          }
+      },
+      grain_size);
+
+  // the rows were sorted on input and we have allocated exactly the right
+  // amount of memory, so there is no need to call compress()
+  compressed = true;
+}
+
+
+
 template <typename number>
 void
 SparsityPattern::copy_from(const FullMatrix<number> &matrix)
@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/triangular_level_schedule.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace
+{
+  using size_type = TriangularLevelSchedule::size_type;
+
+  /**
+   * Sort the rows by the given levels (a counting sort, so rows stay in
+   * increasing order within each level) and set up the start of each level.
+   */
+  void
+  sort_by_level(const std::vector<unsigned int> &level,
+                std::vector<size_type> &         level_start,
+                std::vector<size_type> &         rows)
+  {
+    const unsigned int n_levels =
+      level.empty() ? 0 : *std::max_element(level.begin(), level.end()) + 1;
+
+    level_start.assign(n_levels + 1, 0);
+    for (const unsigned int l : level)
+      ++level_start[l + 1];
+    for (unsigned int l = 0; l < n_levels; ++l)
+      level_start[l + 1] += level_start[l];
+
+    std::vector<size_type> next(level_start.begin(), level_start.end() - 1);
+    rows.resize(level.size());
+    for (size_type row = 0; row < level.size(); ++row)
+      rows[next[level[row]]++] = row;
+  }
+} // namespace
+
+
+
+void
+TriangularLevelSchedule::initialize(const SparsityPattern &sparsity)
+{
+  Assert(sparsity.is_compressed(), SparsityPattern::ExcNotCompressed());
+  AssertDimension(sparsity.n_rows(), sparsity.n_cols());
+
+  const size_type           n = sparsity.n_rows();
+  std::vector<unsigned int> level(n, 0);
+
+  // row i has to wait for all rows j<i it couples to in the forward
+  // substitution
+  for (size_type row = 0; row < n; ++row)
+    for (auto entry = sparsity.begin(row); entry != sparsity.end(row); ++entry)
+      if (entry->column() < row)
+        level[row] = std::max(level[row], level[entry->column()] + 1);
+  sort_by_level(level, forward_level_start, forward_rows);
+
+  // and for all rows j>i in the backward substitution
+  std::fill(level.begin(), level.end(), 0);
+  for (size_type row = n; row-- > 0;)
+    for (auto entry = sparsity.begin(row); entry != sparsity.end(row); ++entry)
+      if (entry->column() > row)
+        level[row] = std::max(level[row], level[entry->column()] + 1);
+  sort_by_level(level, backward_level_start, backward_rows);
+}
+
+
+
+void
+TriangularLevelSchedule::clear()
+{
+  forward_level_start.clear();
+  forward_rows.clear();
+  backward_level_start.clear();
+  backward_rows.clear();
+}
+
+
+
+std::size_t
+TriangularLevelSchedule::memory_consumption() const
+{
+  return MemoryConsumption::memory_consumption(forward_level_start) +
+         MemoryConsumption::memory_consumption(forward_rows) +
+         MemoryConsumption::memory_consumption(backward_level_start) +
+         MemoryConsumption::memory_consumption(backward_rows);
+}
+
+DEAL_II_NAMESPACE_CLOSE
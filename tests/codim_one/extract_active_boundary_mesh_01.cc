@@ -0,0 +1,122 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// check that GridGenerator::extract_active_boundary_mesh creates a flat
+// surface mesh whose cells are the active cells of the one created by
+// GridGenerator::extract_boundary_mesh, with the same vertex order and
+// boundary indicators, and that it copies the manifold ids of edges
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(Triangulation<dim> &volume_mesh, const std::string &name)
+{
+  Triangulation<dim - 1, dim> surface_mesh, refined_surface_mesh;
+  const auto                  surface_to_volume =
+    GridGenerator::extract_active_boundary_mesh(volume_mesh, surface_mesh);
+  const auto refined_surface_to_volume =
+    GridGenerator::extract_boundary_mesh(volume_mesh, refined_surface_mesh);
+
+  std::map<typename Triangulation<dim>::face_iterator,
+           typename Triangulation<dim - 1, dim>::cell_iterator>
+    refined_cell_of_face;
+  for (const auto &entry : refined_surface_to_volume)
+    if (entry.first->active())
+      refined_cell_of_face[entry.second] = entry.first;
+
+  unsigned int n_mismatches = 0;
+  for (const auto &cell : surface_mesh.active_cell_iterators())
+    {
+      const auto face = surface_to_volume.at(cell);
+      if (face->has_children() ||
+          refined_cell_of_face.find(face) == refined_cell_of_face.end())
+        {
+          ++n_mismatches;
+          continue;
+        }
+
+      const auto refined_cell = refined_cell_of_face[face];
+      for (unsigned int v = 0; v < GeometryInfo<dim - 1>::vertices_per_cell;
+           ++v)
+        if (cell->vertex(v).distance(refined_cell->vertex(v)) > 1e-12)
+          ++n_mismatches;
+      if (cell->material_id() != refined_cell->material_id())
+        ++n_mismatches;
+    }
+
+  unsigned int n_curved_lines = 0;
+  if (dim == 3)
+    for (const auto &cell : surface_mesh.active_cell_iterators())
+      for (unsigned int l = 0; l < GeometryInfo<dim - 1>::lines_per_cell; ++l)
+        if (cell->line(l)->manifold_id() == 1)
+          ++n_curved_lines;
+
+  deallog << name << ": " << surface_mesh.n_levels() << " level, "
+          << surface_mesh.n_active_cells() << " cells ("
+          << refined_surface_mesh.n_active_cells() << " active cells in "
+          << refined_surface_mesh.n_levels() << " levels), "
+          << surface_mesh.n_used_vertices() << " vertices, " << n_mismatches
+          << " mismatches, " << n_curved_lines
+          << " cell edges with manifold id" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    // hanging nodes are allowed in 2d
+    Triangulation<2> tria;
+    GridGenerator::hyper_cube(tria, -1, 1, true);
+    tria.refine_global(2);
+    tria.begin_active()->set_refine_flag();
+    tria.execute_coarsening_and_refinement();
+    test(tria, "2d adaptive");
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_cube(tria, -1, 1, true);
+    tria.refine_global(2);
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->center()[0] > 0.5)
+        for (unsigned int f = 0; f < GeometryInfo<3>::faces_per_cell; ++f)
+          if (cell->face(f)->at_boundary())
+            for (unsigned int l = 0; l < GeometryInfo<2>::lines_per_cell; ++l)
+              cell->face(f)->line(l)->set_manifold_id(1);
+    test(tria, "3d global");
+  }
+  {
+    // refinement away from the boundary does not create hanging nodes on
+    // the surface
+    Triangulation<3> tria;
+    GridGenerator::hyper_cube(tria, -1, 1);
+    tria.refine_global(2);
+    for (const auto &cell : tria.active_cell_iterators())
+      if (!cell->at_boundary())
+        cell->set_refine_flag();
+    tria.execute_coarsening_and_refinement();
+    test(tria, "3d interior refinement");
+  }
+}
@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that DoFTools::make_compressed_sparsity_pattern produces the same
+// sparsity pattern as DoFTools::make_sparsity_pattern into a
+// DynamicSparsityPattern followed by SparsityPattern::copy_from, with and
+// without keeping constrained entries, for hanging node constraints and for
+// hp::DoFHandler objects
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/hp/fe_collection.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+template <typename DoFHandlerType>
+void
+compare(const DoFHandlerType &dof_handler, const bool keep_constrained_dofs)
+{
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler,
+                                  dsp,
+                                  constraints,
+                                  keep_constrained_dofs);
+  SparsityPattern reference;
+  reference.copy_from(dsp);
+
+  SparsityPattern sparsity;
+  DoFTools::make_compressed_sparsity_pattern(dof_handler,
+                                             sparsity,
+                                             constraints,
+                                             keep_constrained_dofs);
+
+  bool identical = (sparsity.n_rows() == reference.n_rows() &&
+                    sparsity.n_cols() == reference.n_cols() &&
+                    sparsity.n_nonzero_elements() ==
+                      reference.n_nonzero_elements());
+  for (unsigned int row = 0; identical && row < reference.n_rows(); ++row)
+    {
+      if (sparsity.row_length(row) != reference.row_length(row))
+        identical = false;
+      for (unsigned int i = 0; identical && i < reference.row_length(row);
+           ++i)
+        if (sparsity.column_number(row, i) != reference.column_number(row, i))
+          identical = false;
+    }
+
+  deallog << "keep_constrained_dofs=" << keep_constrained_dofs << ": "
+          << (identical ? "identical" : "different") << std::endl;
+}
+
+
+
+template <int dim>
+void
+refine_mesh(Triangulation<dim> &tria)
+{
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 3 : 2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5 && cell->center()[1] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog.push(Utilities::int_to_string(dim) + "d");
+
+  Triangulation<dim> tria;
+  refine_mesh(tria);
+
+  {
+    const FESystem<dim> fe(FE_Q<dim>(2), 2);
+    DoFHandler<dim>     dof_handler(tria);
+    dof_handler.distribute_dofs(fe);
+    compare(dof_handler, true);
+    compare(dof_handler, false);
+  }
+
+  {
+    hp::FECollection<dim> fe_collection;
+    fe_collection.push_back(FE_Q<dim>(1));
+    fe_collection.push_back(FE_Q<dim>(3));
+    hp::DoFHandler<dim> dof_handler(tria);
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      cell->set_active_fe_index(cell->center()[0] < 0.5 ? 1 : 0);
+    dof_handler.distribute_dofs(fe_collection);
+    compare(dof_handler, true);
+    compare(dof_handler, false);
+  }
+
+  deallog.pop();
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check FullMatrix::mmult, Tmmult, mTmult, vmult and Tvmult for float and
+// double matrices against plain loops for all sizes up to 13, which covers
+// all remainders of the register blocks in internal::FullMatrixKernels.
+// vmult and Tvmult use these kernels if the number of matrix entries is at
+// most FullMatrixKernels::max_product_size_below_blas, which holds for all
+// sizes in this test. The matrix-matrix products
+// use them without LAPACK, and with LAPACK only if the product of the three
+// dimensions is at most FullMatrixKernels::max_product_size_below_blas;
+// the larger products in this test go to BLAS gemm
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <typename number>
+void
+fill(FullMatrix<number> &A)
+{
+  for (unsigned int i = 0; i < A.m(); ++i)
+    for (unsigned int j = 0; j < A.n(); ++j)
+      A(i, j) = random_value<number>();
+}
+
+
+
+template <typename number>
+number
+difference(const FullMatrix<number> &A, const FullMatrix<number> &B)
+{
+  number diff = 0;
+  for (unsigned int i = 0; i < A.m(); ++i)
+    for (unsigned int j = 0; j < A.n(); ++j)
+      diff = std::max(diff, std::abs(A(i, j) - B(i, j)));
+  return diff;
+}
+
+
+
+template <typename number>
+void
+test(const number tolerance)
+{
+  number max_diff = 0;
+  for (unsigned int m = 1; m < 14; ++m)
+    for (unsigned int n = 1; n < 14; ++n)
+      for (unsigned int l = 1; l < 14; l += 3)
+        for (const bool adding : {false, true})
+          {
+            FullMatrix<number> A(m, l), At(l, m), B(l, n), Bt(n, l);
+            fill(A);
+            fill(B);
+            At.copy_transposed(A);
+            Bt.copy_transposed(B);
+
+            FullMatrix<number> initial(m, n), reference(m, n);
+            fill(initial);
+            for (unsigned int i = 0; i < m; ++i)
+              for (unsigned int j = 0; j < n; ++j)
+                {
+                  number sum = adding ? initial(i, j) : number();
+                  for (unsigned int k = 0; k < l; ++k)
+                    sum += A(i, k) * B(k, j);
+                  reference(i, j) = sum;
+                }
+
+            FullMatrix<number> C(initial);
+            A.mmult(C, B, adding);
+            max_diff = std::max(max_diff, difference(C, reference));
+
+            C = initial;
+            At.Tmmult(C, B, adding);
+            max_diff = std::max(max_diff, difference(C, reference));
+
+            C = initial;
+            A.mTmult(C, Bt, adding);
+            max_diff = std::max(max_diff, difference(C, reference));
+
+            // matrix-vector products with the first column of B and of the
+            // reference result
+            Vector<number> x(l), y(m), y_reference(m);
+            for (unsigned int k = 0; k < l; ++k)
+              x(k) = B(k, 0);
+            for (unsigned int i = 0; i < m; ++i)
+              y(i) = y_reference(i) = initial(i, 0);
+            if (!adding)
+              y_reference = 0;
+            for (unsigned int i = 0; i < m; ++i)
+              for (unsigned int k = 0; k < l; ++k)
+                y_reference(i) += A(i, k) * x(k);
+
+            A.vmult(y, x, adding);
+            y -= y_reference;
+            max_diff = std::max(max_diff, y.linfty_norm());
+
+            for (unsigned int i = 0; i < m; ++i)
+              y(i) = initial(i, 0);
+            At.Tvmult(y, x, adding);
+            y -= y_reference;
+            max_diff = std::max(max_diff, y.linfty_norm());
+          }
+
+  deallog << (max_diff < tolerance ? "OK" : "Failed") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<double>(1e-12);
+  test<float>(1e-4);
+}
@@ -0,0 +1,106 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Test GridTools::batched_compute_point_locations: locate random points,
+// some of which lie outside the mesh, on a curved mesh and compare with
+// GridTools::compute_point_locations_try_all
+
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int n_refinements, const unsigned int n_points)
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(n_refinements);
+
+  const MappingQGeneric<dim> mapping(3);
+  GridTools::Cache<dim>      cache(tria, mapping);
+
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < n_points; ++i)
+    points.push_back(random_point<dim>(-1.1, 1.1));
+
+  const auto batched =
+    GridTools::batched_compute_point_locations(cache, points);
+  const auto reference =
+    GridTools::compute_point_locations_try_all(cache, points);
+
+  // collect the results of both functions by point
+  std::vector<std::pair<typename Triangulation<dim>::active_cell_iterator,
+                        Point<dim>>>
+    batched_by_point(n_points), reference_by_point(n_points);
+  for (unsigned int c = 0; c < std::get<0>(batched).size(); ++c)
+    for (unsigned int q = 0; q < std::get<2>(batched)[c].size(); ++q)
+      batched_by_point[std::get<2>(batched)[c][q]] =
+        std::make_pair(std::get<0>(batched)[c], std::get<1>(batched)[c][q]);
+  for (unsigned int c = 0; c < std::get<0>(reference).size(); ++c)
+    for (unsigned int q = 0; q < std::get<2>(reference)[c].size(); ++q)
+      reference_by_point[std::get<2>(reference)[c][q]] =
+        std::make_pair(std::get<0>(reference)[c], std::get<1>(reference)[c][q]);
+
+  std::vector<unsigned int> reference_missing = std::get<3>(reference);
+  std::sort(reference_missing.begin(), reference_missing.end());
+
+  unsigned int n_mismatches = 0;
+  for (unsigned int i = 0; i < n_points; ++i)
+    if (batched_by_point[i].first != reference_by_point[i].first ||
+        batched_by_point[i].second.distance(reference_by_point[i].second) >
+          1e-8)
+      ++n_mismatches;
+
+  // points must be sorted within every cell, and the cells by their first
+  // point
+  bool sorted = std::is_sorted(std::get<3>(batched).begin(),
+                               std::get<3>(batched).end());
+  for (unsigned int c = 0; c < std::get<0>(batched).size(); ++c)
+    {
+      sorted = sorted && std::is_sorted(std::get<2>(batched)[c].begin(),
+                                        std::get<2>(batched)[c].end());
+      if (c > 0)
+        sorted =
+          sorted && std::get<2>(batched)[c - 1][0] < std::get<2>(batched)[c][0];
+    }
+
+  deallog << "points found in " << std::get<0>(batched).size()
+          << " cells, points not found: " << std::get<3>(batched).size()
+          << std::endl;
+  deallog << "same points not found: "
+          << (std::get<3>(batched) == reference_missing ? "yes" : "no")
+          << ", mismatches: " << n_mismatches
+          << ", sorted: " << (sorted ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(3, 1000);
+  test<3>(2, 1000);
+}
@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that Triangulation::compact_storage() reduces the memory
+// consumption of a flattened mesh, that the released children, refinement
+// cases and user data read as their default values, and that the mesh can
+// still be refined, coarsened and given user indices afterwards, with the
+// same result as a mesh that has not been compacted
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+bool
+all_unrefined(const Triangulation<dim> &tria)
+{
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      if (cell->has_children() ||
+          cell->refinement_case() != RefinementCase<dim>::no_refinement ||
+          cell->user_index() != 0)
+        return false;
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->face(f)->has_children() || cell->face(f)->user_index() != 0)
+          return false;
+      for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+        if (cell->line(l)->has_children())
+          return false;
+    }
+  return true;
+}
+
+
+
+template <int dim>
+bool
+same_mesh(const Triangulation<dim> &tria_1, const Triangulation<dim> &tria_2)
+{
+  if (tria_1.n_active_cells() != tria_2.n_active_cells() ||
+      tria_1.n_levels() != tria_2.n_levels())
+    return false;
+
+  auto cell_2 = tria_2.begin();
+  for (const auto &cell_1 : tria_1.cell_iterators())
+    {
+      if (cell_1->has_children() != cell_2->has_children() ||
+          cell_1->refinement_case() != cell_2->refinement_case() ||
+          cell_1->center().distance(cell_2->center()) > 1e-12 ||
+          (cell_1->level() > 0 &&
+           cell_1->parent()->index() != cell_2->parent()->index()))
+        return false;
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell_1->face(f)->has_children() != cell_2->face(f)->has_children())
+          return false;
+      ++cell_2;
+    }
+  return true;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> refined_tria;
+  GridGenerator::hyper_cube(refined_tria, -1, 1);
+  refined_tria.refine_global(6 - dim);
+
+  Triangulation<dim> tria, reference_tria;
+  GridGenerator::flatten_triangulation(refined_tria, tria);
+  GridGenerator::flatten_triangulation(refined_tria, reference_tria);
+
+  const std::size_t memory_before = tria.memory_consumption();
+  tria.compact_storage();
+  const std::size_t memory_after = tria.memory_consumption();
+
+  deallog << "cells: " << tria.n_active_cells() << ", memory reduced: "
+          << (memory_after < memory_before ? "yes" : "no")
+          << ", unrefined: " << (all_unrefined(tria) ? "yes" : "no")
+          << std::endl;
+
+  // user indices recreate the released array; compacting again keeps the
+  // indices that have been set
+  for (const auto &cell : tria.active_cell_iterators())
+    cell->set_user_index(cell->active_cell_index() % 3);
+  tria.compact_storage();
+  bool user_indices_ok = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->user_index() != cell->active_cell_index() % 3)
+      user_indices_ok = false;
+  tria.clear_user_data();
+  deallog << "user indices: " << (user_indices_ok ? "OK" : "wrong")
+          << std::endl;
+
+  // refine and coarsen both meshes in the same way
+  for (unsigned int cycle = 0; cycle < 3; ++cycle)
+    {
+      for (Triangulation<dim> *t : {&tria, &reference_tria})
+        {
+          for (const auto &cell : t->active_cell_iterators())
+            if (cell->center()[0] > 0.3 * cycle && cell->center()[1] > 0)
+              cell->set_refine_flag();
+            else if (cycle > 0 && cell->level() > 0)
+              cell->set_coarsen_flag();
+          t->execute_coarsening_and_refinement();
+        }
+      deallog << "cycle " << cycle << ": cells: " << tria.n_active_cells()
+              << ", same mesh: "
+              << (same_mesh(tria, reference_tria) ? "yes" : "no") << std::endl;
+
+      tria.compact_storage();
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
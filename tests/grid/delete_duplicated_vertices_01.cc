@@ -0,0 +1,150 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// check that GridTools::delete_duplicated_vertices() gives the same result
+// as comparing all pairs of vertices, both for a mesh in which every cell
+// has its own copy of its vertices and for chains of vertices that are
+// closer to their neighbors than the tolerance, but not to each other
+
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+// the quadratic algorithm used before
+template <int spacedim>
+std::vector<unsigned int>
+reference_numbers(const std::vector<Point<spacedim>> &vertices,
+                  const double                        tol)
+{
+  std::vector<unsigned int> new_vertex_numbers(vertices.size());
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    new_vertex_numbers[i] = i;
+  for (unsigned int i = 0; i < vertices.size(); ++i)
+    if (new_vertex_numbers[i] == i)
+      for (unsigned int j = i + 1; j < vertices.size(); ++j)
+        {
+          bool equal = true;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            equal &= (std::abs(vertices[j][d] - vertices[i][d]) < tol);
+          if (equal)
+            new_vertex_numbers[j] = i;
+        }
+  return new_vertex_numbers;
+}
+
+
+
+template <int dim>
+void
+check(const std::vector<Point<dim>> &   vertices,
+      const std::vector<CellData<dim>> &cells,
+      const double                      tol,
+      const std::string &               name)
+{
+  std::vector<Point<dim>>    new_vertices = vertices;
+  std::vector<CellData<dim>> new_cells    = cells;
+  SubCellData                subcell_data;
+  std::vector<unsigned int>  considered_vertices;
+  GridTools::delete_duplicated_vertices(
+    new_vertices, new_cells, subcell_data, considered_vertices, tol);
+
+  // compare the positions of the cell vertices with the ones of the
+  // representatives chosen by the quadratic algorithm
+  const std::vector<unsigned int> numbers = reference_numbers(vertices, tol);
+  const std::set<unsigned int> representatives(numbers.begin(), numbers.end());
+
+  bool same = true;
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      if (new_vertices[new_cells[c].vertices[v]] !=
+          vertices[numbers[cells[c].vertices[v]]])
+        same = false;
+
+  deallog << name << ": " << vertices.size() << " -> " << new_vertices.size()
+          << " vertices, expected " << representatives.size()
+          << ", same as quadratic algorithm: " << (same ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  const double tol = 1e-8;
+
+  // a structured mesh in which every cell has its own vertices, slightly
+  // perturbed
+  {
+    const unsigned int         n = (dim == 3 ? 8 : 20);
+    std::vector<Point<dim>>    vertices;
+    std::vector<CellData<dim>> cells;
+    unsigned int               perturbation = 0;
+    for (unsigned int c = 0; c < Utilities::pow(n, dim); ++c)
+      {
+        CellData<dim> cell;
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            Point<dim>   p;
+            unsigned int index = c;
+            for (unsigned int d = 0; d < dim; ++d, index /= n)
+              p[d] = (index % n + GeometryInfo<dim>::unit_cell_vertex(v)[d]) /
+                       n +
+                     0.3 * tol * ((perturbation++ % 3) - 1.);
+            cell.vertices[v] = vertices.size();
+            vertices.push_back(p);
+          }
+        cells.push_back(cell);
+      }
+    check(vertices, cells, tol, "separate cells");
+  }
+
+  // cells whose vertices form chains along the first coordinate direction
+  // with spacing 0.6*tol
+  {
+    std::vector<Point<dim>>    vertices;
+    std::vector<CellData<dim>> cells;
+    for (unsigned int c = 0; c < 5; ++c)
+      {
+        CellData<dim> cell;
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            Point<dim> p = GeometryInfo<dim>::unit_cell_vertex(v);
+            p[0] += 0.6 * tol * c;
+            cell.vertices[v] = vertices.size();
+            vertices.push_back(p);
+          }
+        cells.push_back(cell);
+      }
+    check(vertices, cells, tol, "chains");
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1>();
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,143 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that reading the binary variant of the GMSH-4.1 format gives the same
+// mesh as reading the ASCII variant of the same file
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+gmsh_grid(const char *name_ascii, const char *name_binary)
+{
+  Triangulation<dim> tria_ascii;
+  {
+    GridIn<dim> grid_in;
+    grid_in.attach_triangulation(tria_ascii);
+    std::ifstream input_file(name_ascii);
+    grid_in.read_msh(input_file);
+  }
+
+  Triangulation<dim> tria_binary;
+  {
+    GridIn<dim> grid_in;
+    grid_in.attach_triangulation(tria_binary);
+    std::ifstream input_file(name_binary, std::ios::binary);
+    grid_in.read_msh(input_file);
+  }
+
+  // both files describe the nodes in the same order, so even the vertex
+  // indices have to match
+  AssertThrow(tria_ascii.n_vertices() == tria_binary.n_vertices(),
+              ExcInternalError());
+  for (unsigned int v = 0; v < tria_ascii.n_vertices(); ++v)
+    AssertThrow(tria_ascii.get_vertices()[v] == tria_binary.get_vertices()[v],
+                ExcInternalError());
+  AssertThrow(tria_ascii.n_active_cells() == tria_binary.n_active_cells(),
+              ExcInternalError());
+  deallog << "  " << tria_ascii.n_active_cells() << " active cells"
+          << std::endl;
+
+  auto       cell_ascii  = tria_ascii.begin_active();
+  auto       cell_binary = tria_binary.begin_active();
+  const auto end_ascii   = tria_ascii.end();
+  for (; cell_ascii != end_ascii; ++cell_ascii, ++cell_binary)
+    {
+      AssertThrow(cell_ascii->material_id() == cell_binary->material_id(),
+                  ExcInternalError());
+      for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell; ++i)
+        {
+          AssertThrow((cell_ascii->vertex(i) - cell_binary->vertex(i)).norm() <
+                        1.e-10,
+                      ExcInternalError());
+        }
+      for (unsigned int i = 0; i < GeometryInfo<dim>::faces_per_cell; ++i)
+        {
+          AssertThrow(cell_ascii->face(i)->boundary_id() ==
+                        cell_binary->face(i)->boundary_id(),
+                      ExcInternalError());
+        }
+      for (unsigned int i = 0; i < GeometryInfo<dim>::lines_per_cell; ++i)
+        {
+          AssertThrow(cell_ascii->line(i)->boundary_id() ==
+                        cell_binary->line(i)->boundary_id(),
+                      ExcInternalError());
+        }
+    }
+  deallog << "  OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  try
+    {
+      deallog << "/grid_in_msh_01.2d.v41b.msh" << std::endl;
+      gmsh_grid<2>(SOURCE_DIR "/grids/grid_in_msh_01.2d.v41.msh",
+                   SOURCE_DIR "/grids/grid_in_msh_01.2d.v41b.msh");
+      deallog << "/grid_in_msh_01.2da.v41b.msh" << std::endl;
+      gmsh_grid<2>(SOURCE_DIR "/grids/grid_in_msh_01.2da.v41.msh",
+                   SOURCE_DIR "/grids/grid_in_msh_01.2da.v41b.msh");
+      deallog << "/grid_in_msh_01.3d.v41b.msh" << std::endl;
+      gmsh_grid<3>(SOURCE_DIR "/grids/grid_in_msh_01.3d.v41.msh",
+                   SOURCE_DIR "/grids/grid_in_msh_01.3d.v41b.msh");
+      deallog << "/grid_in_msh_01.3da.v41b.msh" << std::endl;
+      gmsh_grid<3>(SOURCE_DIR "/grids/grid_in_msh_01.3da.v41.msh",
+                   SOURCE_DIR "/grids/grid_in_msh_01.3da.v41b.msh");
+      deallog << "/grid_in_msh_01.3d_neg.v41b.msh" << std::endl;
+      gmsh_grid<3>(SOURCE_DIR "/grids/grid_in_msh_01.3d_neg.v41.msh",
+                   SOURCE_DIR "/grids/grid_in_msh_01.3d_neg.v41b.msh");
+    }
+  catch (std::exception &exc)
+    {
+      deallog << std::endl
+              << std::endl
+              << "----------------------------------------------------"
+              << std::endl;
+      deallog << "Exception on processing: " << std::endl
+              << exc.what() << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------"
+              << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      deallog << std::endl
+              << std::endl
+              << "----------------------------------------------------"
+              << std::endl;
+      deallog << "Unknown exception!" << std::endl
+              << "Aborting!" << std::endl
+              << "----------------------------------------------------"
+              << std::endl;
+      return 1;
+    };
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that invalid node tags in a binary GMSH-4.1 file are reported to the
+// caller with the exception for the first element that uses them, even
+// though the blocks of nodes and elements are converted in parallel
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+
+#include <cstdint>
+#include <sstream>
+
+#include "../tests.h"
+
+
+template <typename T>
+void
+write(std::ostream &out, const T t)
+{
+  out.write(reinterpret_cast<const char *>(&t), sizeof(T));
+}
+
+
+
+// write an n x n mesh of quadrilaterals in the binary GMSH-4.1 format. the
+// node with tag bad_node_tag (if not zero) is given the tag 100000, and the
+// element with index bad_element (if valid) refers to node 100000
+std::string
+binary_mesh(const unsigned int  n,
+            const std::uint64_t bad_node_tag,
+            const unsigned int  bad_element)
+{
+  const std::uint64_t one = 1, n_nodes = (n + 1) * (n + 1),
+                      n_elements = n * n;
+
+  std::ostringstream out;
+  out << "$MeshFormat\n4.1 1 8\n";
+  write<int>(out, 1);
+  out << "\n$EndMeshFormat\n$Entities\n";
+  for (const std::uint64_t n_entities : {0, 0, 1, 0})
+    write<std::uint64_t>(out, n_entities);
+  write<int>(out, 1);
+  for (const double x : {0., 0., 0., 1., 1., 0.})
+    write<double>(out, x);
+  write<std::uint64_t>(out, 0); // physical tags
+  write<std::uint64_t>(out, 0); // bounding curves
+  out << "\n$EndEntities\n$Nodes\n";
+  // one block, the number of nodes, and the range of their tags
+  for (const std::uint64_t x : {one, n_nodes, one, n_nodes})
+    write<std::uint64_t>(out, x);
+  write<int>(out, 2);
+  write<int>(out, 1);
+  write<int>(out, 0);
+  write<std::uint64_t>(out, n_nodes);
+  for (std::uint64_t tag = 1; tag <= n_nodes; ++tag)
+    write<std::uint64_t>(out, tag == bad_node_tag ? 100000 : tag);
+  for (unsigned int j = 0; j <= n; ++j)
+    for (unsigned int i = 0; i <= n; ++i)
+      for (const double x : {1. * i / n, 1. * j / n, 0.})
+        write<double>(out, x);
+  out << "\n$EndNodes\n$Elements\n";
+  for (const std::uint64_t x : {one, n_elements, one, n_elements})
+    write<std::uint64_t>(out, x);
+  write<int>(out, 2);
+  write<int>(out, 1);
+  write<int>(out, 3);
+  write<std::uint64_t>(out, n_elements);
+  for (unsigned int j = 0; j < n; ++j)
+    for (unsigned int i = 0; i < n; ++i)
+      {
+        const unsigned int  e    = j * n + i;
+        const std::uint64_t node = 1 + j * (n + 1) + i;
+        write<std::uint64_t>(out, e + 1);
+        for (const std::uint64_t tag :
+             {node, node + 1, node + n + 2, node + n + 1})
+          write<std::uint64_t>(out, e == bad_element ? 100000 : tag);
+      }
+  out << "\n$EndElements\n";
+  return out.str();
+}
+
+
+
+void
+check(const std::string &name, const std::string &content)
+{
+  deallog << name << std::endl;
+
+  Triangulation<2> tria;
+  GridIn<2>        grid_in;
+  grid_in.attach_triangulation(tria);
+  std::istringstream in(content);
+  try
+    {
+      grid_in.read_msh(in);
+      deallog << "  " << tria.n_active_cells() << " active cells" << std::endl;
+    }
+  catch (ExceptionBase &exc)
+    {
+      std::ostringstream message;
+      exc.print_info(message);
+      std::string text = message.str();
+      text.erase(0, text.find_first_not_of(' '));
+      text.erase(text.find_last_not_of('\n') + 1);
+      deallog << "  " << text << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // enough elements for the parallel loops to split the blocks
+  const unsigned int n = 100;
+
+  check("valid file", binary_mesh(n, 0, numbers::invalid_unsigned_int));
+  check("node tag out of range",
+        binary_mesh(n, 5000, numbers::invalid_unsigned_int));
+  check("element with an unknown node", binary_mesh(n, 0, 7000));
+}
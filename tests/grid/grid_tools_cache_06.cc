@@ -0,0 +1,129 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that GridTools::Cache updates the vertex to cell map, the used
+// vertices and the rtrees of used vertices and cell bounding boxes
+// incrementally after local refinement and coarsening, that the results
+// are the same as the ones computed from scratch, and that it falls back
+// to rebuilding them when too many cells changed
+
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check(const GridTools::Cache<dim> &cache)
+{
+  const Triangulation<dim> &tria = cache.get_triangulation();
+
+  const bool vertex_to_cells_ok =
+    (cache.get_vertex_to_cell_map() == GridTools::vertex_to_cell_map(tria));
+
+  const auto used_vertices =
+    GridTools::extract_used_vertices(tria, cache.get_mapping());
+  const bool used_vertices_ok = (cache.get_used_vertices() == used_vertices);
+
+  std::map<unsigned int, Point<dim>> tree_vertices;
+  for (const auto &entry : cache.get_used_vertices_rtree())
+    tree_vertices[entry.second] = entry.first;
+  const bool vertex_rtree_ok =
+    (cache.get_used_vertices_rtree().size() == used_vertices.size()) &&
+    (tree_vertices == used_vertices);
+
+  std::map<typename Triangulation<dim>::active_cell_iterator,
+           std::pair<Point<dim>, Point<dim>>>
+    tree_boxes;
+  for (const auto &entry : cache.get_cell_bounding_boxes_rtree())
+    tree_boxes[entry.second] = entry.first.get_boundary_points();
+  bool cell_rtree_ok = (tree_boxes.size() == tria.n_active_cells());
+  for (const auto &cell : tria.active_cell_iterators())
+    if (tree_boxes.find(cell) == tree_boxes.end() ||
+        tree_boxes[cell] !=
+          cache.get_mapping().get_bounding_box(cell).get_boundary_points())
+      cell_rtree_ok = false;
+
+  const auto &statistics = cache.get_statistics();
+  deallog << "cells: " << tria.n_active_cells()
+          << ", vertex to cell map: " << (vertex_to_cells_ok ? "OK" : "wrong")
+          << ", used vertices: " << (used_vertices_ok ? "OK" : "wrong")
+          << ", vertex rtree: " << (vertex_rtree_ok ? "OK" : "wrong")
+          << ", cell rtree: " << (cell_rtree_ok ? "OK" : "wrong") << std::endl;
+  deallog << "hits: " << statistics.n_hits
+          << ", incremental updates: " << statistics.n_incremental_updates
+          << ", full updates: " << statistics.n_full_updates << std::endl;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int n_global_refinements)
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  if (dim == 1)
+    GridGenerator::hyper_cube(tria, -1, 1);
+  else
+    GridGenerator::hyper_ball(tria);
+  tria.refine_global(n_global_refinements);
+
+  GridTools::Cache<dim> cache(tria);
+  check(cache);
+
+  // refine a few cells, then coarsen some of them again while refining
+  // others
+  for (unsigned int cycle = 0; cycle < 3; ++cycle)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->active_cell_index() % 41 == 7 * cycle)
+          cell->set_refine_flag();
+        else if (cycle > 0 && cell->level() == tria.n_levels() - 1 &&
+                 cell->parent()->index() % 2 == 0)
+          cell->set_coarsen_flag();
+      tria.execute_coarsening_and_refinement();
+      check(cache);
+    }
+
+  // two refinement steps without using the cache in between
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  tria.last_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  check(cache);
+
+  // too many changed cells
+  tria.refine_global(1);
+  check(cache);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1>(6);
+  test<2>(3);
+  test<3>(2);
+}
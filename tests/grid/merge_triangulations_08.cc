@@ -0,0 +1,82 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// merge_triangulations() only considers the boundary vertices of the
+// input triangulations for merging. check that subdivided blocks are
+// welded along their common faces, and that triangulations without any
+// boundary, which have no vertices to merge, are still combined
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim, int spacedim>
+void
+print(const Triangulation<dim, spacedim> &tria)
+{
+  unsigned int n_boundary_faces = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      if (cell->face(f)->at_boundary())
+        ++n_boundary_faces;
+
+  deallog << "cells: " << tria.n_active_cells()
+          << ", vertices: " << tria.n_used_vertices()
+          << ", boundary faces: " << n_boundary_faces << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_blocks()
+{
+  Triangulation<dim> blocks[3];
+  for (unsigned int b = 0; b < 3; ++b)
+    {
+      GridGenerator::subdivided_hyper_cube(blocks[b], 4 - dim);
+      Tensor<1, dim> shift;
+      shift[0] = b;
+      GridTools::shift(shift, blocks[b]);
+    }
+
+  Triangulation<dim> result;
+  GridGenerator::merge_triangulations({&blocks[0], &blocks[1], &blocks[2]},
+                                      result);
+  print(result);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_blocks<1>();
+  test_blocks<2>();
+  test_blocks<3>();
+
+  Triangulation<2, 3> sphere_1, sphere_2, result;
+  GridGenerator::hyper_sphere(sphere_1);
+  GridGenerator::hyper_sphere(sphere_2, Point<3>(3, 0, 0));
+  GridGenerator::merge_triangulations(sphere_1, sphere_2, result);
+  print(result);
+}
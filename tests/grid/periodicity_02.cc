@@ -0,0 +1,102 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// check that GridTools::collect_periodic_faces() finds the matching faces
+// on subdivided meshes, also with an offset, and that all of the matched
+// faces actually lie opposite to each other
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check(const Triangulation<dim> &tria,
+      const unsigned int        direction,
+      const Tensor<1, dim> &    offset,
+      const bool                print_pairs,
+      const std::string &       name)
+{
+  std::vector<
+    GridTools::PeriodicFacePair<typename Triangulation<dim>::cell_iterator>>
+    pairs;
+  GridTools::collect_periodic_faces(
+    tria, 2 * direction, 2 * direction + 1, direction, pairs, offset);
+
+  unsigned int n_wrong = 0;
+  for (const auto &pair : pairs)
+    {
+      Tensor<1, dim> distance = pair.cell[1]->face(pair.face_idx[1])->center() -
+                                pair.cell[0]->face(pair.face_idx[0])->center() -
+                                offset;
+      distance[direction] = 0;
+      if (distance.norm() > 1e-12)
+        ++n_wrong;
+    }
+
+  deallog << name << ": " << pairs.size() << " pairs, " << n_wrong
+          << " wrong" << std::endl;
+  if (print_pairs)
+    for (const auto &pair : pairs)
+      deallog << "  cell " << pair.cell[0]->index() << " face "
+              << pair.face_idx[0] << " <-> cell " << pair.cell[1]->index()
+              << " face " << pair.face_idx[1] << ", orientation "
+              << pair.orientation << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<2> tria;
+    GridGenerator::subdivided_hyper_rectangle(
+      tria, {4, 3}, Point<2>(), Point<2>(1, 1), true);
+    check(tria, 0, Tensor<1, 2>(), true, "2d x");
+    check(tria, 1, Tensor<1, 2>(), true, "2d y");
+
+    // shear the mesh so that the right boundary is shifted upwards by one
+    // cell
+    GridTools::transform(
+      [](const Point<2> &p) { return Point<2>(p[0], p[1] + p[0] / 3.); },
+      tria);
+    Tensor<1, 2> offset;
+    offset[1] = 1. / 3.;
+    check(tria, 0, offset, true, "2d sheared");
+  }
+
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_rectangle(
+      tria, {3, 2, 2}, Point<3>(), Point<3>(3, 2, 2), true);
+    check(tria, 2, Tensor<1, 3>(), true, "3d z");
+  }
+
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_rectangle(
+      tria, {12, 12, 12}, Point<3>(-1, -1, -1), Point<3>(1, 1, 1), true);
+    for (unsigned int d = 0; d < 3; ++d)
+      check(tria, d, Tensor<1, 3>(), false, "3d large");
+  }
+}
@@ -0,0 +1,149 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// the locations of the vertices created during refinement are computed
+// in parallel once the topology of the refined mesh has been set
+// up. check that every new vertex is where the object it was created on
+// puts its center, and that this is already the case when the
+// post_refinement_on_cell signal is triggered
+
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim, int spacedim>
+bool
+center_vertex_matches(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+{
+  // in 2d, cells at the boundary use transfinite interpolation to place
+  // their center
+  const bool use_interpolation =
+    (dim == 3) || (dim == 2 && dim == spacedim && cell->at_boundary());
+  const Point<spacedim> center = cell->center(true, use_interpolation);
+  const Point<spacedim> vertex =
+    cell->child(0)->vertex(GeometryInfo<dim>::max_children_per_cell - 1);
+  return (center - vertex).norm() == 0.;
+}
+
+
+
+template <typename CellIterator>
+unsigned int
+count_misplaced_face_centers(const CellIterator &)
+{
+  return 0;
+}
+
+
+
+unsigned int
+count_misplaced_face_centers(const Triangulation<3>::cell_iterator &cell)
+{
+  unsigned int n_mismatches = 0;
+  for (unsigned int f = 0; f < GeometryInfo<3>::faces_per_cell; ++f)
+    if (cell->face(f)->has_children() &&
+        (cell->face(f)->center(true, true) - cell->face(f)->child(0)->vertex(3))
+            .norm() != 0.)
+      ++n_mismatches;
+  return n_mismatches;
+}
+
+
+
+template <int dim, int spacedim>
+void
+check(Triangulation<dim, spacedim> &tria, const std::string &name)
+{
+  unsigned int n_signal_mismatches = 0;
+  tria.signals.post_refinement_on_cell.connect(
+    [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+      if (dim > 1 && !center_vertex_matches<dim, spacedim>(cell))
+        ++n_signal_mismatches;
+    });
+
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  unsigned int n_mismatches = 0;
+  for (const auto &cell : tria.cell_iterators())
+    if (cell->has_children())
+      {
+        if (dim == 1)
+          {
+            if ((cell->center(true) - cell->child(0)->vertex(1)).norm() != 0.)
+              ++n_mismatches;
+          }
+        else if (!center_vertex_matches<dim, spacedim>(cell))
+          ++n_mismatches;
+
+        if (dim > 1)
+          for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+            if (cell->line(l)->has_children() &&
+                (cell->line(l)->center(true) -
+                 cell->line(l)->child(0)->vertex(1))
+                    .norm() != 0.)
+              ++n_mismatches;
+
+        n_mismatches += count_misplaced_face_centers(cell);
+      }
+
+  deallog << name << ": " << n_mismatches << " misplaced vertices, "
+          << n_signal_mismatches << " misplaced at signal" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<1> tria;
+    GridGenerator::hyper_cube(tria);
+    check(tria, "1d hyper_cube");
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_ball(tria);
+    check(tria, "2d hyper_ball");
+  }
+  {
+    Triangulation<2, 3> tria;
+    GridGenerator::hyper_sphere(tria);
+    check(tria, "2d-in-3d hyper_sphere");
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_ball(tria);
+    check(tria, "3d hyper_ball");
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_shell(tria, Point<3>(), 0.5, 1., 6);
+    check(tria, "3d hyper_shell");
+  }
+}
@@ -0,0 +1,148 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// like refine_vertex_locations_01, but for anisotropic refinement in 3d
+// next to isotropically refined cells. This turns isotropically refined
+// faces into anisotropically refined ones, which moves quads to other
+// places in the middle of the refinement, while the locations of the new
+// vertices on other quads are still to be computed. Check that the existing
+// vertices do not move and that the new vertices on lines, isotropically
+// refined quads and isotropically refined cells are at the centers of these
+// objects
+
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+// quads are identified by their vertices since the refinement may renumber
+// them
+template <int structdim>
+std::vector<unsigned int>
+vertex_indices(const TriaIterator<TriaAccessor<structdim, 3, 3>> &object)
+{
+  std::vector<unsigned int> indices;
+  for (unsigned int v = 0; v < GeometryInfo<structdim>::vertices_per_cell; ++v)
+    indices.push_back(object->vertex_index(v));
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+
+
+void
+test(const unsigned int axis)
+{
+  Triangulation<3> tria;
+  GridGenerator::hyper_shell(tria, Point<3>(), 0.5, 1., 6);
+
+  // refine one of the six cells isotropically
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  // remember what exists before the anisotropic refinement
+  const std::vector<Point<3>> old_vertices      = tria.get_vertices();
+  const std::vector<bool>     old_used_vertices = tria.get_used_vertices();
+  std::set<std::vector<unsigned int>> isotropic_quads;
+  for (const auto &cell : tria.cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<3>::faces_per_cell; ++f)
+      if (cell->face(f)->refinement_case() ==
+          RefinementCase<2>::isotropic_refinement)
+        isotropic_quads.insert(vertex_indices(cell->face(f)));
+  const auto is_new = [&](const unsigned int vertex_index) {
+    return vertex_index >= old_used_vertices.size() ||
+           !old_used_vertices[vertex_index];
+  };
+
+  // refine the other coarse cells anisotropically along the given axis,
+  // and half of the children of the refined cell isotropically. Depending
+  // on the orientation of the shared faces, the isotropically refined faces
+  // become cut_x or cut_y refined, and the quads are swapped in the former
+  // case
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->level() == 0)
+      cell->set_refine_flag(RefinementCase<3>::cut_axis(axis));
+    else if (cell->index() % 2 == 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  unsigned int n_moved = 0;
+  for (unsigned int v = 0; v < old_vertices.size(); ++v)
+    if (old_used_vertices[v] &&
+        (tria.get_vertices()[v] - old_vertices[v]).norm() != 0.)
+      ++n_moved;
+
+  unsigned int n_misplaced = 0, n_cut_x = 0, n_cut_y = 0;
+  std::set<std::vector<unsigned int>> visited_quads;
+  for (const auto &cell : tria.cell_iterators())
+    {
+      if (cell->refinement_case() == RefinementCase<3>::isotropic_refinement &&
+          is_new(cell->child(0)->vertex_index(7)) &&
+          (cell->center(true, true) - cell->child(0)->vertex(7)).norm() != 0.)
+        ++n_misplaced;
+
+      for (unsigned int l = 0; l < GeometryInfo<3>::lines_per_cell; ++l)
+        {
+          const auto line = cell->line(l);
+          if (line->has_children() && is_new(line->child(0)->vertex_index(1)) &&
+              (line->center(true) - line->child(0)->vertex(1)).norm() != 0.)
+            ++n_misplaced;
+        }
+
+      for (unsigned int f = 0; f < GeometryInfo<3>::faces_per_cell; ++f)
+        {
+          const auto face = cell->face(f);
+          if (!face->has_children() ||
+              !visited_quads.insert(vertex_indices(face)).second)
+            continue;
+
+          if (isotropic_quads.count(vertex_indices(face)) == 1)
+            {
+              if (face->refinement_case() == RefinementCase<2>::cut_x)
+                ++n_cut_x;
+              else if (face->refinement_case() == RefinementCase<2>::cut_y)
+                ++n_cut_y;
+            }
+
+          if (face->refinement_case() ==
+                RefinementCase<2>::isotropic_refinement &&
+              is_new(face->child(0)->vertex_index(3)) &&
+              (face->center(true, true) - face->child(0)->vertex(3)).norm() !=
+                0.)
+            ++n_misplaced;
+        }
+    }
+
+  deallog << "cut_axis(" << axis << "): isotropically refined faces made "
+          << "cut_x: " << n_cut_x << ", cut_y: " << n_cut_y << std::endl;
+  deallog << n_moved << " moved vertices, " << n_misplaced
+          << " misplaced vertices" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int axis = 0; axis < 3; ++axis)
+    test(axis);
+}
@@ -0,0 +1,121 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// the locations of the vertices created during refinement are only
+// computed in parallel if all manifolds attached to the triangulation
+// declare that they are thread-safe. check that a manifold that does not
+// is never called concurrently, and that the vertices are the same as
+// with a thread-safe manifold that computes the same points
+
+
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/std_cxx14/memory.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+
+#include <atomic>
+
+#include "../tests.h"
+
+
+// a spherical manifold that does not declare that it can be called from
+// several threads at once, and that records how many threads call it at
+// the same time
+class SerialSphericalManifold : public Manifold<3>
+{
+public:
+  SerialSphericalManifold()
+    : n_active_calls(0)
+    , max_active_calls(0)
+  {}
+
+  virtual std::unique_ptr<Manifold<3>>
+  clone() const override
+  {
+    return std_cxx14::make_unique<SerialSphericalManifold>();
+  }
+
+  virtual Point<3>
+  get_new_point(const ArrayView<const Point<3>> &surrounding_points,
+                const ArrayView<const double> &  weights) const override
+  {
+    const unsigned int n_calls = ++n_active_calls;
+    if (n_calls > max_active_calls)
+      max_active_calls = n_calls;
+    const Point<3> point = sphere.get_new_point(surrounding_points, weights);
+    --n_active_calls;
+    return point;
+  }
+
+  const SphericalManifold<3>        sphere;
+  mutable std::atomic<unsigned int> n_active_calls;
+  mutable std::atomic<unsigned int> max_active_calls;
+};
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(4);
+
+  deallog << "thread-safe: FlatManifold "
+          << FlatManifold<3>().is_thread_safe() << ", SphericalManifold "
+          << SphericalManifold<3>().is_thread_safe()
+          << ", SerialSphericalManifold "
+          << SerialSphericalManifold().is_thread_safe() << std::endl;
+
+  Triangulation<3> tria_1, tria_2;
+  GridGenerator::hyper_shell(tria_1, Point<3>(), 0.5, 1., 6);
+  GridGenerator::hyper_shell(tria_2, Point<3>(), 0.5, 1., 6);
+
+  // the manifold is copied into the triangulation, so ask the copy
+  tria_2.set_manifold(0, SerialSphericalManifold());
+  const auto &manifold =
+    dynamic_cast<const SerialSphericalManifold &>(tria_2.get_manifold(0));
+
+  for (unsigned int cycle = 0; cycle < 3; ++cycle)
+    {
+      for (auto *tria : {&tria_1, &tria_2})
+        {
+          for (const auto &cell : tria->active_cell_iterators())
+            if (cell->center()[0] > -0.3 * cycle)
+              cell->set_refine_flag();
+          tria->execute_coarsening_and_refinement();
+        }
+
+      double max_distance = 0;
+      for (unsigned int v = 0; v < tria_1.n_vertices(); ++v)
+        max_distance = std::max(max_distance,
+                                (tria_1.get_vertices()[v] -
+                                 tria_2.get_vertices()[v])
+                                  .norm());
+
+      deallog << "cycle " << cycle << ": " << tria_2.n_active_cells()
+              << " cells, same vertices: "
+              << (tria_1.n_vertices() == tria_2.n_vertices() &&
+                      max_distance == 0. ?
+                    "yes" :
+                    "no")
+              << std::endl;
+    }
+
+  deallog << "largest number of concurrent calls: "
+          << manifold.max_active_calls << std::endl;
+}
@@ -0,0 +1,224 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// check GridTools::reorder_hilbert() on meshes whose cells and vertices
+// have been shuffled: neighboring cells and the vertices of a cell should
+// get close indices, while the mesh, its boundary and manifold indicators
+// and its manifolds stay the same
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+// recreate the triangulation with the cells and vertices in a scrambled
+// order, as it may come out of a mesh generator
+template <int dim, int spacedim>
+void
+shuffle(Triangulation<dim, spacedim> &tria)
+{
+  std::vector<Point<spacedim>> vertices;
+  std::vector<CellData<dim>>   cells;
+  SubCellData                  subcelldata;
+  std::tie(vertices, cells, subcelldata) =
+    GridTools::get_coarse_mesh_description(tria);
+
+  // multiplication by a prime that does not divide the number of objects
+  // is a permutation
+  const auto permute = [](const unsigned int i, const unsigned int n) {
+    unsigned int factor = 7;
+    for (const unsigned int prime : {11, 13, 17})
+      if (n % factor == 0)
+        factor = prime;
+    return (i * factor + 3) % n;
+  };
+
+  std::vector<CellData<dim>> shuffled_cells(cells.size());
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    shuffled_cells[permute(c, cells.size())] = cells[c];
+
+  std::vector<Point<spacedim>> shuffled_vertices(vertices.size());
+  for (unsigned int v = 0; v < vertices.size(); ++v)
+    shuffled_vertices[permute(v, vertices.size())] = vertices[v];
+  for (auto &cell : shuffled_cells)
+    for (auto &vertex_index : cell.vertices)
+      vertex_index = permute(vertex_index, vertices.size());
+  for (auto &quad : subcelldata.boundary_quads)
+    for (auto &vertex_index : quad.vertices)
+      vertex_index = permute(vertex_index, vertices.size());
+  for (auto &line : subcelldata.boundary_lines)
+    for (auto &vertex_index : line.vertices)
+      vertex_index = permute(vertex_index, vertices.size());
+
+  // keep the manifold, which is deleted along with the triangulation
+  const auto manifold_ids = tria.get_manifold_ids();
+
+  std::unique_ptr<Manifold<dim, spacedim>> manifold;
+  if (std::find(manifold_ids.begin(), manifold_ids.end(), 0) !=
+      manifold_ids.end())
+    manifold = tria.get_manifold(0).clone();
+
+  tria.clear();
+  tria.create_triangulation(shuffled_vertices, shuffled_cells, subcelldata);
+  if (manifold)
+    tria.set_manifold(0, *manifold);
+}
+
+
+
+// the average distance of the indices of neighboring cells, and of the
+// vertex indices within a cell
+template <int dim, int spacedim>
+std::pair<double, double>
+index_distances(const Triangulation<dim, spacedim> &tria)
+{
+  double       cell_distance = 0, vertex_distance = 0;
+  unsigned int n_neighbors   = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (!cell->at_boundary(f))
+          {
+            cell_distance +=
+              std::abs(cell->index() - cell->neighbor(f)->index());
+            ++n_neighbors;
+          }
+
+      unsigned int min_vertex = numbers::invalid_unsigned_int, max_vertex = 0;
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        {
+          min_vertex = std::min(min_vertex, cell->vertex_index(v));
+          max_vertex = std::max(max_vertex, cell->vertex_index(v));
+        }
+      vertex_distance += max_vertex - min_vertex;
+    }
+  return {cell_distance / n_neighbors, vertex_distance / tria.n_cells()};
+}
+
+
+
+// a summary of the mesh that does not depend on the order of cells
+template <int dim, int spacedim>
+std::string
+summary(const Triangulation<dim, spacedim> &tria)
+{
+  double                                     sum_of_diameters = 0;
+  std::map<types::boundary_id, unsigned int> boundary_faces;
+  std::map<types::manifold_id, unsigned int> manifold_cells;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      sum_of_diameters += cell->diameter();
+      ++manifold_cells[cell->manifold_id()];
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->face(f)->at_boundary())
+          ++boundary_faces[cell->face(f)->boundary_id()];
+    }
+
+  std::ostringstream out;
+  out << tria.n_active_cells() << " cells, " << tria.n_used_vertices()
+      << " vertices, sum of diameters " << sum_of_diameters
+      << ", boundary faces";
+  for (const auto &entry : boundary_faces)
+    out << ' ' << static_cast<unsigned int>(entry.first) << ':'
+        << entry.second;
+  out << ", cell manifolds";
+  for (const auto &entry : manifold_cells)
+    out << ' ' << static_cast<int>(entry.first) << ':' << entry.second;
+  return out.str();
+}
+
+
+
+template <int dim, int spacedim>
+void
+test(Triangulation<dim, spacedim> &tria, const std::string &name)
+{
+  shuffle(tria);
+  Triangulation<dim, spacedim> reference_tria;
+  reference_tria.copy_triangulation(tria);
+  const auto distances_before = index_distances(tria);
+
+  GridTools::reorder_hilbert(tria);
+  const auto distances_after = index_distances(tria);
+
+  deallog << name << ": " << summary(tria) << std::endl;
+  deallog << "  same mesh: "
+          << (summary(tria) == summary(reference_tria) ? "yes" : "no")
+          << ", neighbor index distance reduced: "
+          << (distances_after.first < distances_before.first ? "yes" : "no")
+          << ", vertex index distance reduced: "
+          << (distances_after.second < distances_before.second ? "yes" : "no")
+          << std::endl;
+
+  // the manifolds are still attached, so refinement gives the same mesh
+  tria.refine_global(1);
+  reference_tria.refine_global(1);
+  deallog << "  refined: " << summary(tria) << std::endl;
+  deallog << "  same refined mesh: "
+          << (summary(tria) == summary(reference_tria) ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(6);
+
+  {
+    Triangulation<1> tria;
+    GridGenerator::subdivided_hyper_rectangle(
+      tria, std::vector<unsigned int>{20}, Point<1>(-1), Point<1>(1), true);
+    test(tria, "1d");
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::subdivided_hyper_rectangle(
+      tria, {16, 12}, Point<2>(0, 0), Point<2>(4, 3), true);
+    test(tria, "2d rectangle");
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_shell(tria, Point<2>(), 0.5, 1., 24, true);
+    test(tria, "2d shell");
+  }
+  {
+    Triangulation<2, 3> tria;
+    GridGenerator::hyper_sphere(tria);
+    tria.refine_global(2);
+    Triangulation<2, 3> flat_tria;
+    GridGenerator::flatten_triangulation(tria, flat_tria);
+    flat_tria.set_all_manifold_ids(0);
+    flat_tria.set_manifold(0, SphericalManifold<2, 3>());
+    test(flat_tria, "2d sphere surface");
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(1);
+    Triangulation<3> flat_tria;
+    GridGenerator::flatten_triangulation(tria, flat_tria);
+    flat_tria.set_all_manifold_ids_on_boundary(0);
+    flat_tria.set_manifold(0, SphericalManifold<3>());
+    test(flat_tria, "3d ball");
+  }
+}
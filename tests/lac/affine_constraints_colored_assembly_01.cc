@@ -0,0 +1,254 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// assemble a Laplace matrix with hanging node constraints once with
+// WorkStream and a serial copier and once with cells colored by
+// AffineConstraints::get_conflict_indices(), where the copiers of one color
+// run concurrently, and check that the results agree and that the cells of
+// one color indeed write into disjoint rows
+
+#include <deal.II/base/graph_coloring.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/work_stream.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+struct ScratchData
+{
+  ScratchData(const FiniteElement<dim> &fe, const Quadrature<dim> &quadrature)
+    : fe_values(fe,
+                quadrature,
+                update_values | update_gradients | update_quadrature_points |
+                  update_JxW_values)
+  {}
+
+  ScratchData(const ScratchData &scratch)
+    : fe_values(scratch.fe_values.get_fe(),
+                scratch.fe_values.get_quadrature(),
+                scratch.fe_values.get_update_flags())
+  {}
+
+  FEValues<dim> fe_values;
+};
+
+
+
+struct CopyData
+{
+  FullMatrix<double>                   cell_matrix;
+  Vector<double>                       cell_rhs;
+  std::vector<types::global_dof_index> local_dof_indices;
+};
+
+
+
+template <int dim>
+class Assembler
+{
+public:
+  using CellIterator = typename DoFHandler<dim>::active_cell_iterator;
+
+  Assembler(const DoFHandler<dim> &          dof_handler,
+            const AffineConstraints<double> &constraints,
+            SparseMatrix<double> &           matrix,
+            Vector<double> &                 rhs)
+    : dof_handler(dof_handler)
+    , constraints(constraints)
+    , matrix(matrix)
+    , rhs(rhs)
+  {}
+
+  void
+  local_assemble(const CellIterator &cell,
+                 ScratchData<dim> &  scratch,
+                 CopyData &          copy_data) const
+  {
+    const unsigned int dofs_per_cell = cell->get_fe().dofs_per_cell;
+    copy_data.cell_matrix.reinit(dofs_per_cell, dofs_per_cell);
+    copy_data.cell_rhs.reinit(dofs_per_cell);
+    copy_data.local_dof_indices.resize(dofs_per_cell);
+
+    scratch.fe_values.reinit(cell);
+    const FEValues<dim> &fe_values = scratch.fe_values;
+    for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        {
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            copy_data.cell_matrix(i, j) +=
+              (fe_values.shape_grad(i, q) * fe_values.shape_grad(j, q) +
+               fe_values.shape_value(i, q) * fe_values.shape_value(j, q)) *
+              fe_values.JxW(q);
+          copy_data.cell_rhs(i) += fe_values.shape_value(i, q) *
+                                   fe_values.quadrature_point(q)[0] *
+                                   fe_values.JxW(q);
+        }
+    cell->get_dof_indices(copy_data.local_dof_indices);
+  }
+
+  void
+  copy_local_to_global(const CopyData &copy_data)
+  {
+    constraints.distribute_local_to_global(copy_data.cell_matrix,
+                                           copy_data.cell_rhs,
+                                           copy_data.local_dof_indices,
+                                           matrix,
+                                           rhs);
+  }
+
+  template <typename IteratorRange>
+  void
+  run(const IteratorRange &cells, const Quadrature<dim> &quadrature)
+  {
+    matrix = 0;
+    rhs    = 0;
+    WorkStream::run(cells,
+                    [this](const CellIterator &cell,
+                           ScratchData<dim> &  scratch,
+                           CopyData &          copy_data) {
+                      local_assemble(cell, scratch, copy_data);
+                    },
+                    [this](const CopyData &copy_data) {
+                      copy_local_to_global(copy_data);
+                    },
+                    ScratchData<dim>(dof_handler.get_fe(), quadrature),
+                    CopyData());
+  }
+
+private:
+  const DoFHandler<dim> &          dof_handler;
+  const AffineConstraints<double> &constraints;
+  SparseMatrix<double> &           matrix;
+  Vector<double> &                 rhs;
+};
+
+
+
+template <int dim>
+void
+test(const unsigned int degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 5 : 3);
+  // refine the cells of one quadrant once more to get hanging nodes
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5 && cell->center()[1] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  const QGauss<dim> quadrature(degree + 1);
+
+  // serial copier
+  SparseMatrix<double> matrix_serial(sparsity);
+  Vector<double>       rhs_serial(dof_handler.n_dofs());
+  Assembler<dim> assembler_serial(dof_handler,
+                                  constraints,
+                                  matrix_serial,
+                                  rhs_serial);
+
+  assembler_serial.run(
+    IteratorRange<typename DoFHandler<dim>::active_cell_iterator>(
+      dof_handler.begin_active(), dof_handler.end()),
+    quadrature);
+
+  // concurrent copiers on colored cells
+  const std::vector<
+    std::vector<typename DoFHandler<dim>::active_cell_iterator>>
+    colored_cells = GraphColoring::make_graph_coloring(
+      dof_handler.begin_active(),
+      dof_handler.end(),
+      [&constraints](
+        const typename DoFHandler<dim>::active_cell_iterator &cell) {
+        return constraints.get_conflict_indices(cell);
+      });
+
+  SparseMatrix<double> matrix_colored(sparsity);
+  Vector<double>       rhs_colored(dof_handler.n_dofs());
+  Assembler<dim> assembler_colored(dof_handler,
+                                   constraints,
+                                   matrix_colored,
+                                   rhs_colored);
+  assembler_colored.run(colored_cells, quadrature);
+
+  // check that the cells of each color write into disjoint rows
+  bool coloring_ok = true;
+  for (const auto &color : colored_cells)
+    {
+      std::vector<types::global_dof_index> rows;
+      for (const auto &cell : color)
+        {
+          const std::vector<types::global_dof_index> indices =
+            constraints.get_conflict_indices(cell);
+          rows.insert(rows.end(), indices.begin(), indices.end());
+        }
+      std::sort(rows.begin(), rows.end());
+      if (std::adjacent_find(rows.begin(), rows.end()) != rows.end())
+        coloring_ok = false;
+    }
+
+  matrix_colored.add(-1., matrix_serial);
+  rhs_colored -= rhs_serial;
+  deallog << dim << "d, degree " << degree << ": coloring "
+          << (coloring_ok ? "OK" : "has conflicts") << ", results "
+          << (matrix_colored.frobenius_norm() <
+                  1e-12 * matrix_serial.frobenius_norm() &&
+                  rhs_colored.l2_norm() < 1e-12 * rhs_serial.l2_norm() ?
+                "agree" :
+                "differ")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(2);
+  test<2>(4);
+  test<3>(2);
+}
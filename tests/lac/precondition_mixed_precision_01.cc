@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// solve a double precision FE_Q Laplace problem with SolverCG, SolverGMRES
+// and SolverFGMRES, preconditioned by SSOR, Jacobi and ILU applied in float
+// through PreconditionMixedPrecision, and check that the solution reaches
+// the double precision tolerance
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/precondition_mixed_precision.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/matrix_tools.h>
+
+#include "../tests.h"
+
+
+template <typename SolverType, typename PreconditionerType>
+void
+check_solve(const SparseMatrix<double> &A,
+            const Vector<double> &      b,
+            const PreconditionerType &  preconditioner,
+            const std::string &         name)
+{
+  const double   tolerance = 1e-12 * b.l2_norm();
+  SolverControl  control(1000, tolerance, false, false);
+  SolverType     solver(control);
+  Vector<double> x(b.size());
+  solver.solve(A, x, b, preconditioner);
+
+  Vector<double> r(b.size());
+  const double   residual = A.residual(r, x, b);
+  deallog << name << ": "
+          << (residual <= 10. * tolerance ? "converged" : "not converged")
+          << std::endl;
+}
+
+
+template <typename PreconditionerType>
+void
+check_solvers(const SparseMatrix<double> &A,
+              const Vector<double> &      b,
+              const PreconditionerType &  preconditioner,
+              const std::string &         name)
+{
+  check_solve<SolverCG<Vector<double>>>(A, b, preconditioner, name + " CG");
+  check_solve<SolverGMRES<Vector<double>>>(A,
+                                           b,
+                                           preconditioner,
+                                           name + " GMRES");
+  check_solve<SolverFGMRES<Vector<double>>>(A,
+                                            b,
+                                            preconditioner,
+                                            name + " FGMRES");
+}
+
+
+int
+main()
+{
+  initlog();
+
+  const int          dim = 2;
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(4);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs(), dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<double> A(sparsity), M(sparsity);
+  MatrixCreator::create_laplace_matrix(dof_handler, QGauss<dim>(3), A);
+  MatrixCreator::create_mass_matrix(dof_handler, QGauss<dim>(3), M);
+  A.add(1., M);
+
+  Vector<double> b(A.m());
+  for (unsigned int i = 0; i < b.size(); ++i)
+    b(i) = random_value<double>();
+
+  {
+    PreconditionMixedPrecision<PreconditionSSOR<SparseMatrix<float>>> prec;
+    prec.initialize(A, 1.2);
+    AssertThrow(&prec.get_matrix().get_sparsity_pattern() == &sparsity,
+                ExcInternalError());
+    check_solvers(A, b, prec, "SSOR");
+  }
+  {
+    PreconditionMixedPrecision<PreconditionJacobi<SparseMatrix<float>>> prec;
+    prec.initialize(A);
+    check_solvers(A, b, prec, "Jacobi");
+  }
+  {
+    PreconditionMixedPrecision<SparseILU<float>> prec;
+    prec.initialize(A);
+    check_solvers(A, b, prec, "ILU");
+
+    // update the values only, reusing the storage
+    A.add(1., M);
+    prec.initialize(A);
+    check_solvers(A, b, prec, "ILU updated");
+  }
+}
@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// reinitialize the sparsity pattern of the matrix in place between two
+// calls to PreconditionMixedPrecision::initialize(), with a larger size and
+// more entries, and check that the low-precision copy follows the new
+// pattern and that the preconditioner still works
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/precondition_mixed_precision.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// a banded symmetric positive definite matrix with the given number of
+// off-diagonals on each side of the diagonal
+void
+make_banded_matrix(const unsigned int    size,
+                   const unsigned int    bandwidth,
+                   SparsityPattern &     sparsity,
+                   SparseMatrix<double> &matrix)
+{
+  DynamicSparsityPattern dsp(size, size);
+  for (unsigned int i = 0; i < size; ++i)
+    for (unsigned int j = (i < bandwidth ? 0 : i - bandwidth);
+         j <= std::min(i + bandwidth, size - 1);
+         ++j)
+      dsp.add(i, j);
+  sparsity.copy_from(dsp);
+
+  matrix.reinit(sparsity);
+  for (unsigned int i = 0; i < size; ++i)
+    for (auto entry = matrix.begin(i); entry != matrix.end(i); ++entry)
+      entry->value() = (entry->column() == i ? 4. * bandwidth : -1.);
+}
+
+
+
+void
+check(const SparseMatrix<double> &                                       A,
+      const PreconditionMixedPrecision<PreconditionSSOR<SparseMatrix<float>>>
+        &                                                                prec,
+      const std::string &                                                name)
+{
+  const SparseMatrix<float> &A_low = prec.get_matrix();
+
+  bool same_entries = (A_low.m() == A.m() && A_low.n() == A.n() &&
+                       A_low.n_nonzero_elements() == A.n_nonzero_elements());
+  for (unsigned int i = 0; same_entries && i < A.m(); ++i)
+    for (auto entry = A.begin(i); entry != A.end(i); ++entry)
+      if (A_low.el(i, entry->column()) != static_cast<float>(entry->value()))
+        same_entries = false;
+
+  Vector<double> b(A.m()), x(A.m());
+  for (unsigned int i = 0; i < b.size(); ++i)
+    b(i) = random_value<double>();
+  SolverControl            control(1000, 1e-12 * b.l2_norm(), false, false);
+  SolverCG<Vector<double>> solver(control);
+  solver.solve(A, x, b, prec);
+
+  Vector<double> r(b.size());
+  deallog << name << ": " << A_low.m() << " rows, "
+          << A_low.n_nonzero_elements() << " entries, "
+          << (same_entries ? "same" : "different") << " entries, "
+          << (A.residual(r, x, b) <= 1e-11 * b.l2_norm() ? "converged" :
+                                                           "not converged")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  SparsityPattern      sparsity;
+  SparseMatrix<double> A;
+  PreconditionMixedPrecision<PreconditionSSOR<SparseMatrix<float>>> prec;
+
+  make_banded_matrix(50, 1, sparsity, A);
+  prec.initialize(A, 1.2);
+  check(A, prec, "tridiagonal");
+
+  // the same SparsityPattern object, now with more rows and entries
+  make_banded_matrix(200, 3, sparsity, A);
+  prec.initialize(A, 1.2);
+  check(A, prec, "seven bands");
+
+  // and back to fewer entries
+  make_banded_matrix(80, 2, sparsity, A);
+  prec.initialize(A, 1.2);
+  check(A, prec, "five bands");
+}
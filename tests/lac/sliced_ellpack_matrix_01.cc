@@ -0,0 +1,166 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check SlicedEllpackMatrix against SparseMatrix on FE_Q matrices of
+// degree 1 to 4: products, residual, diagonal, and a CG solve
+// preconditioned with PreconditionChebyshev, with and without sorting the
+// rows
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sliced_ellpack_matrix.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/matrix_tools.h>
+
+#include "../tests.h"
+
+
+void
+check_equal(const Vector<double> &a, const Vector<double> &b)
+{
+  Vector<double> diff(a);
+  diff -= b;
+  AssertThrow(diff.l2_norm() <= 1e-12 * b.l2_norm(), ExcInternalError());
+}
+
+
+template <int dim>
+void
+test(const unsigned int degree, const unsigned int sigma)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  // a locally refined mesh gives rows of varying length
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs(), dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<double> A(sparsity), M(sparsity);
+  MatrixCreator::create_laplace_matrix(dof_handler, QGauss<dim>(degree + 1), A);
+  MatrixCreator::create_mass_matrix(dof_handler, QGauss<dim>(degree + 1), M);
+  A.add(1., M);
+
+  SlicedEllpackMatrix<double> B(A, sigma);
+  AssertThrow(B.m() == A.m() && B.n() == A.n(), ExcInternalError());
+  AssertThrow(B.n_nonzero_elements() == A.n_nonzero_elements(),
+              ExcInternalError());
+  AssertThrow(B.n_stored_elements() >= A.n_nonzero_elements(),
+              ExcInternalError());
+
+  Vector<double> x(A.n()), y(A.m()), z(A.m());
+  for (unsigned int i = 0; i < x.size(); ++i)
+    x(i) = random_value<double>();
+
+  A.vmult(y, x);
+  B.vmult(z, x);
+  check_equal(z, y);
+
+  A.vmult_add(y, x);
+  B.vmult_add(z, x);
+  check_equal(z, y);
+
+  A.Tvmult(y, x);
+  B.Tvmult(z, x);
+  check_equal(z, y);
+
+  Vector<double> r1(A.m()), r2(A.m());
+  const double   norm1 = A.residual(r1, x, y);
+  const double   norm2 = B.residual(r2, x, y);
+  check_equal(r2, r1);
+  AssertThrow(std::abs(norm1 - norm2) <= 1e-12 * norm1, ExcInternalError());
+
+  for (unsigned int i = 0; i < A.m(); ++i)
+    AssertThrow(B.diag_element(i) == A.diag_element(i), ExcInternalError());
+  for (unsigned int i = 0; i < A.m(); i += 7)
+    for (auto entry = A.begin(i); entry != A.end(i); ++entry)
+      AssertThrow(B.el(i, entry->column()) == entry->value(),
+                  ExcInternalError());
+
+  // only the values change when copying in another matrix with the same
+  // sparsity pattern
+  B.copy_from(M);
+  M.vmult(y, x);
+  B.vmult(z, x);
+  check_equal(z, y);
+  B.copy_from(A);
+
+  // solve with both matrices and compare
+  PreconditionChebyshev<SlicedEllpackMatrix<double>>::AdditionalData data;
+  data.degree          = 3;
+  data.smoothing_range = 20.;
+  PreconditionChebyshev<SlicedEllpackMatrix<double>> precondition;
+  precondition.initialize(B, data);
+
+  PreconditionChebyshev<SparseMatrix<double>>::AdditionalData data_csr;
+  data_csr.degree          = 3;
+  data_csr.smoothing_range = 20.;
+  PreconditionChebyshev<SparseMatrix<double>> precondition_csr;
+  precondition_csr.initialize(A, data_csr);
+
+  Vector<double> sol1(A.m()), sol2(A.m());
+  {
+    SolverControl            control(1000, 1e-12 * x.l2_norm(), false, false);
+    SolverCG<Vector<double>> solver(control);
+    solver.solve(A, sol1, x, precondition_csr);
+  }
+  {
+    SolverControl            control(1000, 1e-12 * x.l2_norm(), false, false);
+    SolverCG<Vector<double>> solver(control);
+    solver.solve(B, sol2, x, precondition);
+  }
+  sol2 -= sol1;
+  AssertThrow(sol2.l2_norm() <= 1e-8 * sol1.l2_norm(), ExcInternalError());
+
+  deallog << "FE_Q<" << dim << ">(" << degree << "), sigma=" << sigma << ": OK"
+          << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int degree = 1; degree <= 4; ++degree)
+    {
+      test<2>(degree, 1);
+      test<2>(degree, 32);
+    }
+  test<3>(2, 1);
+  test<3>(2, 32);
+}
@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check the products of SlicedEllpackMatrix with vectors that cannot be
+// read with gather instructions: vectors with a value type different from
+// the one of the matrix, and block vectors. The matrix has rows of
+// different lengths and a number of rows that is not a multiple of the
+// slice size
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/sliced_ellpack_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <typename VectorType1, typename VectorType2>
+double
+relative_difference(const VectorType1 &result, const VectorType2 &reference)
+{
+  double difference = 0, norm = 0;
+  for (unsigned int i = 0; i < reference.size(); ++i)
+    {
+      difference = std::max(
+        difference, std::abs(double(result(i)) - double(reference(i))));
+      norm = std::max(norm, std::abs(double(reference(i))));
+    }
+  return difference / norm;
+}
+
+
+
+void
+check(const SparseMatrix<double> &A, const unsigned int sigma)
+{
+  const unsigned int n = A.m();
+
+  Vector<double> x(n), y(n), z(n);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      x(i) = random_value<double>();
+      z(i) = random_value<double>();
+    }
+
+  // double matrix, float source vector
+  {
+    Vector<float> x_float(x);
+    Vector<double> x_rounded(x_float), reference(n), result(n);
+    A.vmult(reference, x_rounded);
+
+    SlicedEllpackMatrix<double> S(A, sigma);
+    S.vmult(result, x_float);
+    deallog << "double matrix, float vector: "
+            << (relative_difference(result, reference) < 1e-14 ? "OK" :
+                                                                 "FAILED")
+            << std::endl;
+  }
+
+  // float matrix, double vectors
+  {
+    Vector<double> reference(n), result(n);
+    A.vmult(reference, x);
+
+    SlicedEllpackMatrix<float> S(A, sigma);
+    S.vmult(result, x);
+    deallog << "float matrix, double vector: "
+            << (relative_difference(result, reference) < 1e-6 ? "OK" :
+                                                                "FAILED")
+            << std::endl;
+  }
+
+  // block vectors with blocks that do not line up with the slices
+  {
+    std::vector<types::global_dof_index> block_sizes = {n / 3, n - n / 3};
+    BlockVector<double> x_block(block_sizes), z_block(block_sizes),
+      result(block_sizes);
+    x_block = x;
+    z_block = z;
+
+    SlicedEllpackMatrix<double> S(A, sigma);
+
+    A.vmult(y, x);
+    S.vmult(result, x_block);
+    deallog << "block vector vmult: "
+            << (relative_difference(result, y) < 1e-14 ? "OK" : "FAILED")
+            << std::endl;
+
+    y = z;
+    A.vmult_add(y, x);
+    result = z_block;
+    S.vmult_add(result, x_block);
+    deallog << "block vector vmult_add: "
+            << (relative_difference(result, y) < 1e-14 ? "OK" : "FAILED")
+            << std::endl;
+
+    A.Tvmult(y, x);
+    S.Tvmult(result, x_block);
+    deallog << "block vector Tvmult: "
+            << (relative_difference(result, y) < 1e-14 ? "OK" : "FAILED")
+            << std::endl;
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // a nonsymmetric matrix with between one and six entries per row
+  const unsigned int n = 37;
+  SparsityPattern    sparsity(n, n, 6);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int k = 0; k < 1 + (i * 5) % 6; ++k)
+      sparsity.add(i, (i + 7 * k * k) % n);
+  sparsity.compress();
+
+  SparseMatrix<double> A(sparsity);
+  for (unsigned int i = 0; i < n; ++i)
+    for (auto entry = A.begin(i); entry != A.end(i); ++entry)
+      entry->value() = random_value<double>(-1, 1) + (i == entry->column());
+
+  for (const unsigned int sigma : {1, 16})
+    {
+      deallog << "sigma = " << sigma << std::endl;
+      check(A, sigma);
+    }
+}
@@ -0,0 +1,209 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check SparseMatrix::vmult_multiple against vmult, also for float vectors,
+// and SolverMultipleCG against separate solves with SolverCG for several
+// right-hand sides, one of them zero and one of them much easier than the
+// others so that it is deflated early. With a ReductionControl, blocks are
+// deflated once their own residual is reduced, even though the tolerance is
+// far below the final residual. With a ConsecutiveControl, the iteration
+// stops once all blocks are deflated rather than calling the control with
+// the same residual until it reports convergence
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_multiple_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+template <typename PreconditionerType>
+void
+check(const SparseMatrix<double> &A,
+      const BlockVector<double> & b,
+      const PreconditionerType &  preconditioner,
+      const std::string &         name)
+{
+  BlockVector<double> x(b.n_blocks(), A.m());
+
+  SolverControl      control(1000, 1e-10, false, false);
+  SolverMultipleCG<> solver(control);
+  solver.solve(A, x, b, preconditioner);
+  deallog << name << " multiple CG steps: " << control.last_step()
+          << ", active blocks: " << solver.n_active_blocks() << std::endl;
+
+  BlockVector<double> residual(b.n_blocks(), A.m());
+  for (unsigned int c = 0; c < b.n_blocks(); ++c)
+    {
+      SolverControl            control_cg(1000,
+                                          1e-10 / std::sqrt(1. * b.n_blocks()),
+                                          false,
+                                          false);
+      SolverCG<Vector<double>> solver_cg(control_cg);
+      Vector<double>           x_cg(A.m());
+      solver_cg.solve(A, x_cg, b.block(c), preconditioner);
+
+      x_cg -= x.block(c);
+      A.residual(residual.block(c), x.block(c), b.block(c));
+      deallog << name << " block " << c
+              << " CG steps: " << control_cg.last_step() << ", solutions "
+              << (x_cg.l2_norm() <= 1e-8 * (1. + x.block(c).l2_norm()) ?
+                    "agree" :
+                    "differ")
+              << std::endl;
+    }
+  deallog << name << " residual "
+          << (residual.l2_norm() < 1e-9 ? "OK" : "too large") << std::endl;
+}
+
+
+
+void
+check_reduction(const SparseMatrix<double> &A, const BlockVector<double> &b)
+{
+  BlockVector<double> x(b.n_blocks(), A.m());
+
+  const double       reduction = 1e-6;
+  ReductionControl   control(1000, 1e-16, reduction, false, false);
+  SolverMultipleCG<> solver(control);
+  solver.solve(A, x, b, PreconditionIdentity());
+  deallog << "Reduction multiple CG steps: " << control.last_step()
+          << ", active blocks: " << solver.n_active_blocks() << std::endl;
+
+  BlockVector<double> residual(b.n_blocks(), A.m());
+  for (unsigned int c = 0; c < b.n_blocks(); ++c)
+    A.residual(residual.block(c), x.block(c), b.block(c));
+  deallog << "Reduction residual "
+          << (residual.l2_norm() <= reduction * b.l2_norm() ? "OK" :
+                                                              "too large")
+          << std::endl;
+}
+
+
+void
+check_consecutive(const SparseMatrix<double> &A, const BlockVector<double> &b)
+{
+  BlockVector<double> x(b.n_blocks(), A.m());
+
+  ConsecutiveControl control(1000, 1e-10, 5, false, false);
+  SolverMultipleCG<> solver(control);
+  solver.solve(A, x, b, PreconditionIdentity());
+
+  BlockVector<double> residual(b.n_blocks(), A.m());
+  for (unsigned int c = 0; c < b.n_blocks(); ++c)
+    A.residual(residual.block(c), x.block(c), b.block(c));
+  deallog << "Consecutive multiple CG steps: " << control.last_step()
+          << ", active blocks: " << solver.n_active_blocks() << ", residual "
+          << (residual.l2_norm() < 1e-9 ? "OK" : "too large") << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  // vmult_multiple with a number of vectors that is not a multiple of the
+  // group size
+  {
+    const unsigned int                  n_vectors = 6;
+    std::vector<Vector<double>>         src(n_vectors, Vector<double>(dim));
+    std::vector<Vector<double>>         dst(n_vectors, Vector<double>(dim));
+    std::vector<Vector<double> *>       dst_ptr;
+    std::vector<const Vector<double> *> src_ptr;
+    for (unsigned int c = 0; c < n_vectors; ++c)
+      {
+        for (unsigned int i = 0; i < dim; ++i)
+          src[c](i) = random_value<double>();
+        src_ptr.push_back(&src[c]);
+        dst_ptr.push_back(&dst[c]);
+      }
+    A.vmult_multiple(dst_ptr, src_ptr);
+
+    double error = 0;
+    for (unsigned int c = 0; c < n_vectors; ++c)
+      {
+        Vector<double> reference(dim);
+        A.vmult(reference, src[c]);
+        reference -= dst[c];
+        error = std::max(error, reference.linfty_norm());
+      }
+    deallog << "vmult_multiple error: " << error << std::endl;
+
+    // with float vectors, the products with the double matrix are summed up
+    // in double, so only the result is rounded
+    std::vector<Vector<float>>         src_float(n_vectors);
+    std::vector<Vector<float>>         dst_float(n_vectors, Vector<float>(dim));
+    std::vector<Vector<float> *>       dst_float_ptr;
+    std::vector<const Vector<float> *> src_float_ptr;
+    for (unsigned int c = 0; c < n_vectors; ++c)
+      {
+        src_float[c] = src[c];
+        src_float_ptr.push_back(&src_float[c]);
+        dst_float_ptr.push_back(&dst_float[c]);
+      }
+    A.vmult_multiple(dst_float_ptr, src_float_ptr);
+
+    bool rounded_once = true;
+    for (unsigned int c = 0; c < n_vectors; ++c)
+      {
+        Vector<double> reference(dim), src_double(dim);
+        src_double = src_float[c];
+        A.vmult(reference, src_double);
+        for (unsigned int i = 0; i < dim; ++i)
+          if (std::abs(dst_float[c](i) - reference(i)) >
+              0.5 * std::numeric_limits<float>::epsilon() *
+                std::abs(reference(i)))
+            rounded_once = false;
+      }
+    deallog << "vmult_multiple with float vectors "
+            << (rounded_once ? "OK" : "FAILED") << std::endl;
+  }
+
+  BlockVector<double> b(5, dim);
+  for (unsigned int c = 0; c < 5; ++c)
+    if (c != 2)
+      for (unsigned int i = 0; i < dim; ++i)
+        b.block(c)(i) = random_value<double>();
+  // a smooth right-hand side converges much faster
+  for (unsigned int i = 0; i < dim; ++i)
+    b.block(4)(i) = 1.;
+
+  PreconditionIdentity identity;
+  check(A, b, identity, "Identity");
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+  check(A, b, ssor, "SSOR");
+
+  check_reduction(A, b);
+
+  check_consecutive(A, b);
+}
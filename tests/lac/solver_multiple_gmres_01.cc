@@ -0,0 +1,159 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check SolverMultipleGMRES against separate solves with SolverGMRES for
+// several right-hand sides of a nonsymmetric matrix, one of them zero and one
+// of them much easier than the others so that it is deflated early, with a
+// basis small enough that the iteration is restarted
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/solver_multiple_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+template <typename PreconditionerType>
+void
+check(const SparseMatrix<double> &A,
+      const BlockVector<double> & b,
+      const PreconditionerType &  preconditioner,
+      const std::string &         name)
+{
+  BlockVector<double> x(b.n_blocks(), A.m());
+
+  SolverControl         control(1000, 1e-10, false, false);
+  SolverMultipleGMRES<> solver(
+    control, SolverMultipleGMRES<>::AdditionalData(12));
+  solver.solve(A, x, b, preconditioner);
+  deallog << name << " multiple GMRES steps: " << control.last_step()
+          << ", active blocks: " << solver.n_active_blocks() << std::endl;
+
+  BlockVector<double> residual(b.n_blocks(), A.m());
+  const double        tolerance = 1e-10 / std::sqrt(1. * b.n_blocks());
+  for (unsigned int c = 0; c < b.n_blocks(); ++c)
+    {
+      SolverControl               control_gmres(1000, tolerance, false, false);
+      SolverGMRES<Vector<double>> solver_gmres(
+        control_gmres, SolverGMRES<Vector<double>>::AdditionalData(12));
+      Vector<double> x_gmres(A.m());
+      solver_gmres.solve(A, x_gmres, b.block(c), preconditioner);
+
+      x_gmres -= x.block(c);
+      A.residual(residual.block(c), x.block(c), b.block(c));
+      deallog << name << " block " << c
+              << " GMRES steps: " << control_gmres.last_step()
+              << ", solutions "
+              << (x_gmres.l2_norm() <= 1e-7 * (1. + x.block(c).l2_norm()) ?
+                    "agree" :
+                    "differ")
+              << std::endl;
+    }
+  deallog << name << " residual "
+          << (residual.l2_norm() < 1e-8 ? "OK" : "too large") << std::endl;
+}
+
+
+
+// a control that does not report convergence before a minimum number of
+// steps. the iteration has to stop once all blocks are deflated instead of
+// calling the control with the same residual until that number is reached
+class MinimumStepsControl : public SolverControl
+{
+public:
+  MinimumStepsControl(const unsigned int min_steps)
+    : SolverControl(1000, 1e-10, false, false)
+    , min_steps(min_steps)
+  {}
+
+  virtual State
+  check(const unsigned int step, const double check_value) override
+  {
+    const State state = SolverControl::check(step, check_value);
+    if (state == success && step < min_steps)
+      {
+        lcheck = iterate;
+        return iterate;
+      }
+    return state;
+  }
+
+private:
+  const unsigned int min_steps;
+};
+
+
+
+void
+check_minimum_steps(const SparseMatrix<double> &A,
+                    const BlockVector<double> & b)
+{
+  BlockVector<double> x(b.n_blocks(), A.m());
+
+  MinimumStepsControl   control(500);
+  SolverMultipleGMRES<> solver(control);
+  solver.solve(A, x, b, PreconditionIdentity());
+
+  BlockVector<double> residual(b.n_blocks(), A.m());
+  for (unsigned int c = 0; c < b.n_blocks(); ++c)
+    A.residual(residual.block(c), x.block(c), b.block(c));
+  deallog << "Minimum steps multiple GMRES steps: " << control.last_step()
+          << ", active blocks: " << solver.n_active_blocks() << ", residual "
+          << (residual.l2_norm() < 1e-8 ? "OK" : "too large") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+
+  // a convection-diffusion matrix
+  SparseMatrix<double> A(structure), convection(structure);
+  testproblem.five_point(A);
+  testproblem.upwind(convection);
+  A.add(2., convection);
+
+  BlockVector<double> b(4, dim);
+  for (unsigned int c = 0; c < 4; ++c)
+    if (c != 1)
+      for (unsigned int i = 0; i < dim; ++i)
+        b.block(c)(i) = random_value<double>();
+  // a small right-hand side reaches the absolute tolerance much earlier
+  b.block(3) *= 1e-6;
+
+  PreconditionIdentity identity;
+  check(A, b, identity, "Identity");
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+  check(A, b, ssor, "SSOR");
+
+  check_minimum_steps(A, b);
+}
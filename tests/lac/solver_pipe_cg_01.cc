@@ -0,0 +1,91 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that SolverPipeCG takes the same number of iterations as SolverCG
+// and computes the same solution, both with Vector<double> and with
+// LinearAlgebra::distributed::Vector<double> which uses the merged
+// reduction
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_pipe_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+check(const SparseMatrix<double> &A,
+      const PreconditionerType &  preconditioner,
+      const std::string &         name)
+{
+  VectorType b, x_cg, x_pipe;
+  b.reinit(A.m());
+  x_cg.reinit(A.m());
+  x_pipe.reinit(A.m());
+  for (unsigned int i = 0; i < A.m(); ++i)
+    b(i) = random_value<double>();
+
+  SolverControl        control_cg(1000, 1e-10, false, false);
+  SolverCG<VectorType> solver_cg(control_cg);
+  solver_cg.solve(A, x_cg, b, preconditioner);
+
+  SolverControl            control_pipe(1000, 1e-10, false, false);
+  SolverPipeCG<VectorType> solver_pipe(control_pipe);
+  solver_pipe.solve(A, x_pipe, b, preconditioner);
+
+  deallog << name << " CG steps: " << control_cg.last_step()
+          << ", pipelined CG steps: " << control_pipe.last_step()
+          << std::endl;
+
+  x_pipe -= x_cg;
+  deallog << name << " solutions "
+          << (x_pipe.linfty_norm() < 1e-8 * x_cg.linfty_norm() ? "agree" :
+                                                                  "differ")
+          << std::endl;
+}
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  initlog();
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  PreconditionIdentity identity;
+  check<Vector<double>>(A, identity, "Vector Identity");
+  check<LinearAlgebra::distributed::Vector<double>>(A,
+                                                    identity,
+                                                    "distributed Identity");
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+  check<Vector<double>>(A, ssor, "Vector SSOR");
+}
@@ -0,0 +1,93 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that SparseMatrix::Tvmult and SparseMatrix::Tvmult_add give the
+// same result with and without the transposed index cache on a
+// rectangular, non-symmetric matrix, and that the cache is only built on
+// demand and released again when disabled
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int m, const unsigned int n)
+{
+  DynamicSparsityPattern dsp(m, n);
+  for (unsigned int i = 0; i < m; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      if ((i * 7 + j * 3) % 5 < 2 || i == j)
+        dsp.add(i, j);
+  SparsityPattern sp;
+  sp.copy_from(dsp);
+
+  SparseMatrix<double> A(sp);
+  for (unsigned int i = 0; i < m; ++i)
+    for (SparsityPattern::const_iterator p = sp.begin(i); p != sp.end(i);
+         ++p)
+      A.set(i, p->column(), Testing::rand() % 100 - 50.);
+
+  Vector<double> x(m), y(n), z(n);
+  for (unsigned int i = 0; i < m; ++i)
+    x(i) = Testing::rand() % 100 - 50.;
+
+  A.Tvmult(y, x);
+
+  AssertThrow(A.transpose_cache_memory_consumption() == 0,
+              ExcInternalError());
+  A.set_transpose_cache(true);
+  AssertThrow(A.transpose_cache_memory_consumption() == 0,
+              ExcInternalError());
+
+  A.Tvmult(z, x);
+  AssertThrow(A.transpose_cache_memory_consumption() > 0,
+              ExcInternalError());
+  z -= y;
+  AssertThrow(z.l2_norm() <= 1e-12 * y.l2_norm(), ExcInternalError());
+
+  // Tvmult_add on top of an existing result, now with changed values but
+  // the same (cached) structure
+  A *= 2.;
+  z = y;
+  A.Tvmult_add(z, x);
+  y *= 3.;
+  z -= y;
+  AssertThrow(z.l2_norm() <= 1e-12 * y.l2_norm(), ExcInternalError());
+
+  A.set_transpose_cache(false);
+  AssertThrow(A.transpose_cache_memory_consumption() == 0,
+              ExcInternalError());
+
+  deallog << "OK" << std::endl;
+}
+
+
+int
+main()
+{
+  const std::string logname = "output";
+  std::ofstream     logfile(logname.c_str());
+  deallog.attach(logfile);
+  Testing::srand(3391466);
+
+  test(3, 3);
+  test(17, 11);
+  test(1000, 1400);
+}
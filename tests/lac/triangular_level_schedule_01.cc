@@ -0,0 +1,140 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check TriangularLevelSchedule on a 2D five-point stencil, whose levels are
+// the anti-diagonals of the grid, and check that the level-scheduled SSOR
+// sweeps of SparseMatrix give the same result as the sequential ones and
+// that SparseILU::vmult is the adjoint of the (sequential) SparseILU::Tvmult
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/triangular_level_schedule.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int     N = 40, n = N * N;
+  DynamicSparsityPattern dsp(n, n);
+  for (unsigned int i = 0; i < N; ++i)
+    for (unsigned int j = 0; j < N; ++j)
+      {
+        const unsigned int row = i * N + j;
+        dsp.add(row, row);
+        if (i > 0)
+          dsp.add(row, row - N);
+        if (i < N - 1)
+          dsp.add(row, row + N);
+        if (j > 0)
+          dsp.add(row, row - 1);
+        if (j < N - 1)
+          dsp.add(row, row + 1);
+      }
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  TriangularLevelSchedule schedule;
+  schedule.initialize(sparsity);
+  deallog << "forward levels: " << schedule.n_forward_levels() << std::endl;
+  deallog << "backward levels: " << schedule.n_backward_levels()
+          << std::endl;
+
+  // every row is visited exactly once, and only after all rows it depends
+  // on
+  {
+    std::vector<unsigned int> count(n, 0);
+    schedule.apply_forward(
+      [&](const types::global_dof_index row) { ++count[row]; });
+    for (unsigned int row = 0; row < n; ++row)
+      AssertThrow(count[row] == 1, ExcInternalError());
+  }
+  {
+    std::vector<unsigned int> done(n, 0);
+    schedule.apply_forward([&](const types::global_dof_index row) {
+      for (auto entry = sparsity.begin(row); entry != sparsity.end(row);
+           ++entry)
+        if (entry->column() < row)
+          AssertThrow(done[entry->column()] == 1, ExcInternalError());
+      done[row] = 1;
+    });
+    std::fill(done.begin(), done.end(), 0);
+    schedule.apply_backward([&](const types::global_dof_index row) {
+      for (auto entry = sparsity.begin(row); entry != sparsity.end(row);
+           ++entry)
+        if (entry->column() > row)
+          AssertThrow(done[entry->column()] == 1, ExcInternalError());
+      done[row] = 1;
+    });
+  }
+
+  // a non-symmetric matrix
+  SparseMatrix<double> A(sparsity);
+  for (unsigned int row = 0; row < n; ++row)
+    for (auto entry = A.begin(row); entry != A.end(row); ++entry)
+      entry->value() = (entry->column() == row) ?
+                         4.5 :
+                         -1. + 0.1 * (entry->column() > row) +
+                           0.01 * random_value<double>();
+
+  Vector<double> x(n), y1(n), y2(n);
+  for (unsigned int i = 0; i < n; ++i)
+    x(i) = random_value<double>();
+
+  // SSOR: the same sweeps in a different order give the same numbers
+  {
+    std::vector<std::size_t> pos_right_of_diagonal(n);
+    for (unsigned int row = 0; row < n; ++row)
+      {
+        auto it = A.begin(row) + 1;
+        for (; it < A.end(row); ++it)
+          if (it->column() > row)
+            break;
+        pos_right_of_diagonal[row] = it - A.begin();
+      }
+    A.precondition_SSOR(y1, x, 1.2, pos_right_of_diagonal);
+    A.precondition_SSOR(y2, x, 1.2, pos_right_of_diagonal, schedule);
+    for (unsigned int i = 0; i < n; ++i)
+      AssertThrow(y1(i) == y2(i), ExcInternalError());
+
+    PreconditionSSOR<SparseMatrix<double>> ssor;
+    ssor.initialize(A, 1.2);
+    ssor.vmult(y2, x);
+    for (unsigned int i = 0; i < n; ++i)
+      AssertThrow(y1(i) == y2(i), ExcInternalError());
+    deallog << "SSOR OK" << std::endl;
+  }
+
+  // ILU: (z, (LU)^{-1} x) = ((LU)^{-T} z, x)
+  {
+    SparseILU<double> ilu;
+    ilu.initialize(A);
+    Vector<double> z(n);
+    for (unsigned int i = 0; i < n; ++i)
+      z(i) = random_value<double>();
+    ilu.vmult(y1, x);
+    ilu.Tvmult(y2, z);
+    AssertThrow(std::abs(z * y1 - y2 * x) < 1e-12 * std::abs(z * y1),
+                ExcInternalError());
+    deallog << "ILU OK" << std::endl;
+  }
+}
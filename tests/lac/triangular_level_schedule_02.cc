@@ -0,0 +1,150 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// like triangular_level_schedule_01, but on a grid whose levels are larger
+// than the grain size, so that the rows of a level are split into several
+// subranges and run on several threads. the level-scheduled SSOR sweeps and
+// the SparseILU substitutions must give the same result, bit by bit, as the
+// sequential SSOR sweeps and as SparseILU with every level run as a single
+// range
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/triangular_level_schedule.h>
+#include <deal.II/lac/vector.h>
+
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "../tests.h"
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(4);
+
+  const unsigned int grain_size = 16;
+  internal::SparseMatrixImplementation::minimum_parallel_grain_size =
+    grain_size;
+
+  const unsigned int     N = 60, n = N * N;
+  DynamicSparsityPattern dsp(n, n);
+  for (unsigned int i = 0; i < N; ++i)
+    for (unsigned int j = 0; j < N; ++j)
+      {
+        const unsigned int row = i * N + j;
+        dsp.add(row, row);
+        if (i > 0)
+          dsp.add(row, row - N);
+        if (i < N - 1)
+          dsp.add(row, row + N);
+        if (j > 0)
+          dsp.add(row, row - 1);
+        if (j < N - 1)
+          dsp.add(row, row + 1);
+      }
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  TriangularLevelSchedule schedule;
+  schedule.initialize(sparsity);
+
+  // the levels are the anti-diagonals of the grid, with up to N rows
+  {
+    std::vector<unsigned int> level_size(schedule.n_forward_levels(), 0);
+    for (unsigned int i = 0; i < N; ++i)
+      for (unsigned int j = 0; j < N; ++j)
+        ++level_size[i + j];
+    unsigned int n_split = 0;
+    for (const unsigned int size : level_size)
+      if (size > grain_size)
+        ++n_split;
+    deallog << "forward levels: " << schedule.n_forward_levels()
+            << ", larger than the grain size: " << n_split << std::endl;
+  }
+
+  // the rows of the levels are processed by more than one thread
+  {
+    std::mutex                mutex;
+    std::set<std::thread::id> thread_ids;
+    schedule.apply_forward([&](const types::global_dof_index) {
+      std::lock_guard<std::mutex> lock(mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    });
+    AssertThrow(thread_ids.size() > 1, ExcInternalError());
+    deallog << "rows run on several threads" << std::endl;
+  }
+
+  // a non-symmetric matrix
+  SparseMatrix<double> A(sparsity);
+  for (unsigned int row = 0; row < n; ++row)
+    for (auto entry = A.begin(row); entry != A.end(row); ++entry)
+      entry->value() = (entry->column() == row) ?
+                         4.5 :
+                         -1. + 0.1 * (entry->column() > row) +
+                           0.01 * random_value<double>();
+
+  Vector<double> x(n), y1(n), y2(n);
+  for (unsigned int i = 0; i < n; ++i)
+    x(i) = random_value<double>();
+
+  // SSOR: the level-scheduled sweeps give the same numbers as the
+  // sequential ones
+  {
+    PreconditionSSOR<SparseMatrix<double>> ssor;
+    ssor.initialize(A, 1.2);
+    ssor.vmult(y2, x);
+
+    std::vector<std::size_t> pos_right_of_diagonal(n);
+    for (unsigned int row = 0; row < n; ++row)
+      {
+        auto it = A.begin(row) + 1;
+        for (; it < A.end(row); ++it)
+          if (it->column() > row)
+            break;
+        pos_right_of_diagonal[row] = it - A.begin();
+      }
+    A.precondition_SSOR(y1, x, 1.2, pos_right_of_diagonal);
+
+    for (unsigned int i = 0; i < n; ++i)
+      AssertThrow(y1(i) == y2(i), ExcInternalError());
+    deallog << "SSOR OK" << std::endl;
+  }
+
+  // ILU: the result with split levels is the same as with every level run
+  // as a single range, i.e., sequentially
+  {
+    SparseILU<double> ilu;
+    ilu.initialize(A);
+
+    ilu.vmult(y2, x);
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size = n;
+    ilu.vmult(y1, x);
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size =
+      grain_size;
+
+    for (unsigned int i = 0; i < n; ++i)
+      AssertThrow(y1(i) == y2(i), ExcInternalError());
+    deallog << "ILU OK" << std::endl;
+  }
+}
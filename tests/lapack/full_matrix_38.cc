@@ -0,0 +1,98 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Tests LAPACKFullMatrix::mmult, Tmmult and mTmult for matrices small
+// enough to be computed without BLAS, into both LAPACKFullMatrix and
+// FullMatrix results
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <iostream>
+
+#include "../tests.h"
+
+
+
+template <typename MatrixType>
+double
+difference(const FullMatrix<double> &reference, const MatrixType &C)
+{
+  double diff = 0;
+  for (unsigned int i = 0; i < reference.m(); ++i)
+    for (unsigned int j = 0; j < reference.n(); ++j)
+      diff = std::max(diff, std::abs(reference(i, j) - C(i, j)));
+  return diff;
+}
+
+
+
+void
+test(const unsigned int m, const unsigned int n, const unsigned int k)
+{
+  FullMatrix<double>       A(m, k), At(k, m), B(k, n), Bt(n, k);
+  LAPACKFullMatrix<double> AL(m, k), AtL(k, m), BL(k, n), BtL(n, k);
+  for (unsigned int i = 0; i < m; ++i)
+    for (unsigned int j = 0; j < k; ++j)
+      A(i, j) = At(j, i) = AL(i, j) = AtL(j, i) = random_value<double>();
+  for (unsigned int i = 0; i < k; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      B(i, j) = Bt(j, i) = BL(i, j) = BtL(j, i) = random_value<double>();
+
+  FullMatrix<double> reference(m, n);
+  A.mmult(reference, B);
+
+  double                   diff = 0;
+  LAPACKFullMatrix<double> CL(m, n);
+  FullMatrix<double>       C(m, n);
+
+  AL.mmult(CL, BL);
+  diff = std::max(diff, difference(reference, CL));
+  AL.mmult(C, BL);
+  diff = std::max(diff, difference(reference, C));
+
+  AtL.Tmmult(CL, BL);
+  diff = std::max(diff, difference(reference, CL));
+  AtL.Tmmult(C, BL);
+  diff = std::max(diff, difference(reference, C));
+
+  AL.mTmult(CL, BtL);
+  diff = std::max(diff, difference(reference, CL));
+  AL.mTmult(C, BtL);
+  diff = std::max(diff, difference(reference, C));
+
+  // adding to the previous result doubles it
+  AL.mTmult(C, BtL, true);
+  reference *= 2.;
+  diff = std::max(diff, difference(reference, C));
+
+  if (diff > 1e-13)
+    deallog << "Failed for sizes " << m << " " << n << " " << k << std::endl;
+}
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int m = 1; m < 9; ++m)
+    for (unsigned int n = 1; n < 9; ++n)
+      for (unsigned int k = 1; k < 9; ++k)
+        test(m, n, k);
+
+  deallog << "OK" << std::endl;
+}
@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// CylindricalManifold::get_new_points() computes several new points at once
+// using VectorizedArray. Check that it gives the same points as
+// get_new_point(), which computes one point at a time with scalar
+// arithmetic, also for points around the discontinuity of the angle in
+// cylindrical coordinates and for new points on the axis.
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/table.h>
+
+#include <deal.II/grid/manifold_lib.h>
+
+#include "../tests.h"
+
+
+void
+check(const CylindricalManifold<3> &manifold,
+      const std::vector<Point<3>> & surrounding_points,
+      const Table<2, double> &      weights,
+      const std::string &           name)
+{
+  const unsigned int    n_rows = weights.size(0);
+  std::vector<Point<3>> new_points(n_rows);
+  manifold.get_new_points(make_array_view(surrounding_points),
+                          weights,
+                          make_array_view(new_points));
+
+  double max_difference = 0.;
+  for (unsigned int row = 0; row < n_rows; ++row)
+    {
+      const Point<3> new_point = manifold.get_new_point(
+        make_array_view(surrounding_points),
+        make_array_view(&weights(row, 0), &weights(row, 0) + weights.size(1)));
+      max_difference =
+        std::max(max_difference, new_point.distance(new_points[row]));
+    }
+
+  deallog << name << ", " << n_rows << " points: "
+          << (max_difference < 1e-12 ? "OK" : "differences found")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const Tensor<1, 3>           axis({0.3, 0.6, 0.8});
+  const Point<3>               point_on_axis(1., 2., 3.);
+  const CylindricalManifold<3> manifold(axis, point_on_axis);
+
+  // two orthonormal vectors perpendicular to the axis
+  const Tensor<1, 3> unit_axis = axis / axis.norm();
+  Tensor<1, 3>       e1({0.8, 0., -0.3});
+  e1 -= (e1 * unit_axis) * unit_axis;
+  e1 /= e1.norm();
+  const Tensor<1, 3> e2 = cross_product_3d(unit_axis, e1);
+
+  // the vertices of cells of a cylinder shell spanning a range of angles
+  for (const double first_angle : {-0.3, 2.8, 5.9})
+    {
+      std::vector<Point<3>> surrounding_points;
+      for (const double height : {0., 0.7})
+        for (const double radius : {0.5, 1.})
+          for (const double angle : {first_angle, first_angle + 1.2})
+            surrounding_points.push_back(
+              point_on_axis + height * unit_axis +
+              radius * (std::cos(angle) * e1 + std::sin(angle) * e2));
+
+      for (const unsigned int n_points_per_direction : {1, 2, 3})
+        {
+          const unsigned int n_rows =
+            Utilities::fixed_power<3>(n_points_per_direction);
+          Table<2, double> weights(n_rows, surrounding_points.size());
+          for (unsigned int row = 0; row < n_rows; ++row)
+            {
+              Point<3>     unit_point;
+              unsigned int index = row;
+              for (unsigned int d = 0; d < 3; ++d)
+                {
+                  unit_point[d] = (index % n_points_per_direction + 0.5) /
+                                  n_points_per_direction;
+                  index /= n_points_per_direction;
+                }
+              for (unsigned int v = 0; v < surrounding_points.size(); ++v)
+                weights(row, v) =
+                  GeometryInfo<3>::d_linear_shape_function(unit_point, v);
+            }
+
+          check(manifold,
+                surrounding_points,
+                weights,
+                "angle " + std::to_string(first_angle));
+        }
+    }
+
+  // the center of a cell around the axis lies on the axis, whereas points
+  // next to it do not
+  {
+    std::vector<Point<3>> surrounding_points;
+    for (const double height : {0., 0.7})
+      for (const double angle :
+           {0., 0.5 * numbers::PI, 1.5 * numbers::PI, numbers::PI})
+        surrounding_points.push_back(
+          point_on_axis + height * unit_axis +
+          (std::cos(angle) * e1 + std::sin(angle) * e2));
+    Table<2, double> weights(5, surrounding_points.size());
+    for (unsigned int v = 0; v < surrounding_points.size(); ++v)
+      weights(0, v) = 1. / surrounding_points.size();
+    for (unsigned int row = 1; row < 5; ++row)
+      for (unsigned int v = 0; v < surrounding_points.size(); ++v)
+        weights(row, v) = (v == row ? 0.3 : 0.1);
+
+    check(manifold, surrounding_points, weights, "axis");
+  }
+}
@@ -0,0 +1,102 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// SphericalManifold::get_new_points() runs the Newton iterations for
+// several new points at once using VectorizedArray. Check that it gives the
+// same points as get_new_point(), which computes one point at a time with
+// scalar arithmetic, for points that are far enough apart for the Newton
+// iteration to be used.
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/table.h>
+
+#include <deal.II/grid/manifold_lib.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check(const std::vector<Point<3>> &surrounding_points,
+      const unsigned int           n_points_per_direction)
+{
+  const SphericalManifold<dim, 3> manifold(Point<3>(0.1, 0.2, -0.1));
+
+  // tensor product weights at the points of a regular grid in the unit
+  // cell, as during refinement with more than one point per direction
+  const unsigned int n_rows =
+    Utilities::fixed_power<dim>(n_points_per_direction);
+  Table<2, double> weights(n_rows, surrounding_points.size());
+  for (unsigned int row = 0; row < n_rows; ++row)
+    {
+      Point<dim>   unit_point;
+      unsigned int index = row;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          unit_point[d] =
+            (index % n_points_per_direction + 0.5) / n_points_per_direction;
+          index /= n_points_per_direction;
+        }
+      for (unsigned int v = 0; v < surrounding_points.size(); ++v)
+        weights(row, v) =
+          GeometryInfo<dim>::d_linear_shape_function(unit_point, v);
+    }
+
+  std::vector<Point<3>> new_points(n_rows);
+  manifold.get_new_points(make_array_view(surrounding_points),
+                          weights,
+                          make_array_view(new_points));
+
+  double max_difference = 0.;
+  for (unsigned int row = 0; row < n_rows; ++row)
+    {
+      const Point<3> new_point = manifold.get_new_point(
+        make_array_view(surrounding_points),
+        make_array_view(&weights(row, 0), &weights(row, 0) + weights.size(1)));
+      max_difference =
+        std::max(max_difference, new_point.distance(new_points[row]));
+    }
+
+  deallog << "dim=" << dim << ", " << n_rows << " points: "
+          << (max_difference < 1e-12 ? "OK" : "differences found")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // the vertices of a coarse cell of a spherical shell, and of one of its
+  // faces
+  std::vector<Point<3>> hex_vertices;
+  for (const double radius : {0.5, 1.})
+    for (const double phi : {-0.6, 0.7})
+      for (const double theta : {0.5, 1.5})
+        hex_vertices.emplace_back(
+          0.1 + radius * std::sin(theta) * std::cos(phi),
+          0.2 + radius * std::sin(theta) * std::sin(phi),
+          -0.1 + radius * std::cos(theta));
+  std::vector<Point<3>> quad_vertices(hex_vertices.begin() + 4,
+                                      hex_vertices.end());
+
+  check<2>(quad_vertices, 1);
+  check<2>(quad_vertices, 4);
+  check<2>(quad_vertices, 7);
+  check<3>(hex_vertices, 2);
+  check<3>(hex_vertices, 3);
+}
@@ -0,0 +1,111 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that MappingQGeneric::transform_points_real_to_unit_cell() gives
+// the same results as MappingQGeneric::transform_real_to_unit_cell() for
+// points inside and outside of curved cells
+
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim, int spacedim>
+void
+test(const Triangulation<dim, spacedim> &tria, const unsigned int degree)
+{
+  const MappingQGeneric<dim, spacedim> mapping(degree);
+
+  unsigned int n_points = 0, n_failed = 0, n_mismatches = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      // points inside the cell, close to it, and further away
+      std::vector<Point<spacedim>> real_points;
+      for (unsigned int i = 0; i < 11; ++i)
+        real_points.push_back(mapping.transform_unit_to_real_cell(
+          cell, random_point<dim>(i < 6 ? 0. : -0.5, i < 6 ? 1. : 1.5)));
+      real_points.push_back(cell->center() + Point<spacedim>::unit_vector(0) *
+                                               (4. * cell->diameter()));
+
+      std::vector<Point<dim>> unit_points(real_points.size());
+      mapping.transform_points_real_to_unit_cell(cell,
+                                                 make_array_view(real_points),
+                                                 make_array_view(unit_points));
+
+      for (unsigned int i = 0; i < real_points.size(); ++i)
+        {
+          ++n_points;
+          try
+            {
+              const Point<dim> unit_point =
+                mapping.transform_real_to_unit_cell(cell, real_points[i]);
+              if (unit_point.distance(unit_points[i]) > 1e-8)
+                ++n_mismatches;
+            }
+          catch (
+            const typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+            {
+              // the batched version may still find a point far outside of
+              // the reference cell
+              ++n_failed;
+              if (GeometryInfo<dim>::is_inside_unit_cell(unit_points[i]))
+                ++n_mismatches;
+            }
+        }
+    }
+
+  deallog << "dim=" << dim << ", spacedim=" << spacedim
+          << ", degree=" << degree << ": " << n_points << " points, "
+          << n_failed << " failed, " << n_mismatches << " mismatches"
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<1> tria;
+    GridGenerator::hyper_cube(tria);
+    tria.refine_global(2);
+    for (unsigned int degree = 1; degree < 4; ++degree)
+      test(tria, degree);
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(1);
+    for (unsigned int degree = 1; degree < 5; ++degree)
+      test(tria, degree);
+  }
+  {
+    Triangulation<2, 3> tria;
+    GridGenerator::hyper_sphere(tria);
+    for (unsigned int degree = 1; degree < 4; ++degree)
+      test(tria, degree);
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_ball(tria);
+    for (unsigned int degree = 1; degree < 5; ++degree)
+      test(tria, degree);
+  }
+}
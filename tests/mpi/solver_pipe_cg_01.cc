@@ -0,0 +1,157 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that SolverPipeCG takes the same number of iterations as SolverCG
+// and computes the same solution with LinearAlgebra::distributed::Vector
+// distributed over several processes, where the inner products are summed
+// up with a non-blocking reduction
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_pipe_cg.h>
+
+#include "../tests.h"
+
+
+// a finite difference matrix for the reaction-diffusion operator
+// c u - (a(x) u')' on the unit interval with a(x) = 1 + 10 x and
+// homogeneous Dirichlet boundary conditions, scaled such that the reaction
+// term has unit weight. It keeps the condition number moderate, so that the
+// recurrence for the residual in SolverPipeCG does not limit the accuracy.
+// The matrix is applied to vectors that are split into contiguous ranges
+class LaplaceOperator
+{
+public:
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  LaplaceOperator(const unsigned int size)
+    : size(size)
+  {}
+
+  double
+  coefficient(const unsigned int i) const
+  {
+    // a(x) in the middle between the nodes i-1 and i
+    return 1. + 10. * (i + 0.5) / (size + 1);
+  }
+
+  double
+  diagonal(const unsigned int i) const
+  {
+    return 1. + coefficient(i) + coefficient(i + 1);
+  }
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    src.update_ghost_values();
+    for (const auto i : dst.locally_owned_elements())
+      {
+        dst(i) = diagonal(i) * src(i);
+        if (i > 0)
+          dst(i) -= coefficient(i) * src(i - 1);
+        if (i + 1 < size)
+          dst(i) -= coefficient(i + 1) * src(i + 1);
+      }
+    src.zero_out_ghosts();
+  }
+
+private:
+  const unsigned int size;
+};
+
+
+
+template <typename PreconditionerType>
+void
+check(const LaplaceOperator &                           A,
+      const LinearAlgebra::distributed::Vector<double> &b,
+      const PreconditionerType &                        preconditioner,
+      const std::string &                               name)
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  VectorType x_cg, x_pipe;
+  x_cg.reinit(b);
+  x_pipe.reinit(b);
+
+  SolverControl        control_cg(1000, 1e-10, false, false);
+  SolverCG<VectorType> solver_cg(control_cg);
+  solver_cg.solve(A, x_cg, b, preconditioner);
+
+  SolverControl            control_pipe(1000, 1e-10, false, false);
+  SolverPipeCG<VectorType> solver_pipe(control_pipe);
+  solver_pipe.solve(A, x_pipe, b, preconditioner);
+
+  deallog << name << " CG steps: " << control_cg.last_step()
+          << ", pipelined CG steps: " << control_pipe.last_step()
+          << std::endl;
+
+  x_pipe -= x_cg;
+  deallog << name << " solutions "
+          << (x_pipe.linfty_norm() < 1e-8 * x_cg.linfty_norm() ? "agree" :
+                                                                  "differ")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  const unsigned int size    = 200;
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const unsigned int my_id =
+    Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  const unsigned int begin = size * my_id / n_procs;
+  const unsigned int end   = size * (my_id + 1) / n_procs;
+
+  IndexSet locally_owned(size), ghost(size);
+  locally_owned.add_range(begin, end);
+  if (begin > 0)
+    ghost.add_index(begin - 1);
+  if (end < size)
+    ghost.add_index(end);
+
+  LinearAlgebra::distributed::Vector<double> b(locally_owned,
+                                               ghost,
+                                               MPI_COMM_WORLD);
+  for (const auto i : locally_owned)
+    b(i) = std::sin(0.1 * i) + 0.5;
+
+  const LaplaceOperator A(size);
+
+  PreconditionIdentity identity;
+  check(A, b, identity, "Identity");
+
+  LinearAlgebra::distributed::Vector<double> inverse_diagonal;
+  inverse_diagonal.reinit(b);
+  for (const auto i : locally_owned)
+    inverse_diagonal(i) = 1. / A.diagonal(i);
+  DiagonalMatrix<LinearAlgebra::distributed::Vector<double>> jacobi(
+    inverse_diagonal);
+  check(A, b, jacobi, "Jacobi");
+}
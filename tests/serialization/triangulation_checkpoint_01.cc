@@ -0,0 +1,238 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check Triangulation::save_checkpoint() and
+// Triangulation::load_checkpoint(): the loaded triangulation must agree
+// with the stored one, and must be refined in the same way afterwards
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <fstream>
+#include <iterator>
+
+#include "../tests.h"
+
+namespace dealii
+{
+  template <int dim, int spacedim>
+  bool
+  operator==(const Triangulation<dim, spacedim> &t1,
+             const Triangulation<dim, spacedim> &t2)
+  {
+    // test a few attributes, though we can't
+    // test everything unfortunately...
+    if (t1.n_active_cells() != t2.n_active_cells())
+      return false;
+
+    if (t1.n_cells() != t2.n_cells())
+      return false;
+
+    if (t1.n_faces() != t2.n_faces())
+      return false;
+
+    typename Triangulation<dim, spacedim>::cell_iterator c1 = t1.begin(),
+                                                         c2 = t2.begin();
+    for (; (c1 != t1.end()) && (c2 != t2.end()); ++c1, ++c2)
+      {
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            if (c1->vertex(v) != c2->vertex(v))
+              return false;
+            if (c1->vertex_index(v) != c2->vertex_index(v))
+              return false;
+          }
+
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          {
+            if (c1->face(f)->at_boundary() != c2->face(f)->at_boundary())
+              return false;
+
+            if (c1->face(f)->manifold_id() != c2->face(f)->manifold_id())
+              return false;
+
+            if (c1->face(f)->at_boundary())
+              {
+                if (c1->face(f)->boundary_id() != c2->face(f)->boundary_id())
+                  return false;
+              }
+            else
+              {
+                if (c1->neighbor(f)->level() != c2->neighbor(f)->level())
+                  return false;
+                if (c1->neighbor(f)->index() != c2->neighbor(f)->index())
+                  return false;
+              }
+          }
+
+        if (c1->active() && c2->active() &&
+            (c1->subdomain_id() != c2->subdomain_id()))
+          return false;
+
+        if (c1->level_subdomain_id() != c2->level_subdomain_id())
+          return false;
+
+        if (c1->material_id() != c2->material_id())
+          return false;
+
+        if (c1->user_index() != c2->user_index())
+          return false;
+
+        if (c1->user_flag_set() != c2->user_flag_set())
+          return false;
+
+        if (c1->manifold_id() != c2->manifold_id())
+          return false;
+
+        if (c1->active() && c2->active())
+          if (c1->active_cell_index() != c2->active_cell_index())
+            return false;
+
+        if (c1->level() > 0)
+          if (c1->parent_index() != c2->parent_index())
+            return false;
+      }
+
+    // also check the order of raw iterators as they contain
+    // something about the history of the triangulation
+    typename Triangulation<dim, spacedim>::cell_iterator r1 = t1.begin(),
+                                                         r2 = t2.begin();
+    for (; (r1 != t1.end()) && (r2 != t2.end()); ++r1, ++r2)
+      {
+        if (r1->level() != r2->level())
+          return false;
+        if (r1->index() != r2->index())
+          return false;
+      }
+
+    return true;
+  }
+} // namespace dealii
+
+
+template <int dim, int spacedim>
+void
+test()
+{
+  Triangulation<dim, spacedim> tria_1, tria_2;
+
+  GridGenerator::hyper_cube(tria_1);
+  tria_1.refine_global(2);
+  tria_1.begin_active()->set_refine_flag();
+  tria_1.execute_coarsening_and_refinement();
+
+  unsigned int index = 0;
+  for (const auto &cell : tria_1.active_cell_iterators())
+    {
+      cell->set_subdomain_id(index % 3);
+      cell->set_level_subdomain_id(index % 4);
+      cell->set_material_id(index % 5);
+      cell->set_manifold_id(index % 2);
+      cell->set_user_index(index);
+      if (index % 2 == 0)
+        cell->set_user_flag();
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->at_boundary(f))
+          cell->face(f)->set_boundary_id(index % 7);
+      ++index;
+    }
+  tria_1.begin_active()->set_refine_flag();
+  tria_1.last_active()->set_coarsen_flag();
+
+  tria_1.save_checkpoint("checkpoint");
+  tria_2.load_checkpoint("checkpoint");
+
+  const bool equal_after_loading = (tria_1 == tria_2);
+
+  // the flags set before have been stored as well
+  tria_1.execute_coarsening_and_refinement();
+  tria_2.execute_coarsening_and_refinement();
+  tria_1.refine_global(1);
+  tria_2.refine_global(1);
+
+  deallog << dim << ' ' << spacedim << ": "
+          << (equal_after_loading ? "equal" : "different")
+          << " after loading, "
+          << ((tria_1 == tria_2) ? "equal" : "different")
+          << " after refinement" << std::endl;
+
+  // files that end early or that contain nonsensical sizes must be
+  // rejected, and must leave the triangulation loaded into alone
+  std::string contents;
+  {
+    std::ifstream in("checkpoint", std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+  }
+
+  // the header takes 44 bytes and is followed by the mesh smoothing flag,
+  // the number of levels, and the number of refinement flags on level 0
+  const std::string truncated = contents.substr(0, contents.size() / 2);
+
+  std::string wrong_n_levels = contents;
+  std::fill(wrong_n_levels.begin() + 48, wrong_n_levels.begin() + 52, '\xff');
+
+  std::string wrong_n_flags = contents;
+  std::fill(wrong_n_flags.begin() + 52, wrong_n_flags.begin() + 60, '\x7f');
+
+  for (const auto &corrupted : {std::make_pair(truncated, "truncated"),
+                                std::make_pair(wrong_n_levels, "n_levels"),
+                                std::make_pair(wrong_n_flags, "n_flags")})
+    {
+      {
+        std::ofstream out("checkpoint_corrupted", std::ios::binary);
+        out.write(corrupted.first.data(), corrupted.first.size());
+      }
+
+      Triangulation<dim, spacedim> tria_3;
+      tria_3.copy_triangulation(tria_1);
+      bool rejected = false;
+      try
+        {
+          tria_3.load_checkpoint("checkpoint_corrupted");
+        }
+      catch (const ExceptionBase &)
+        {
+          rejected = true;
+        }
+
+      const bool unchanged = (tria_3 == tria_1);
+
+      Triangulation<dim, spacedim> reference;
+      reference.copy_triangulation(tria_1);
+      tria_3.refine_global(1);
+      reference.refine_global(1);
+      deallog << "  " << corrupted.second << ": file "
+              << (rejected ? "rejected" : "accepted") << ", triangulation "
+              << (unchanged ? "unchanged" : "changed") << ", "
+              << ((tria_3 == reference) ? "usable" : "broken") << std::endl;
+    }
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test<1, 1>();
+  test<1, 2>();
+  test<2, 2>();
+  test<2, 3>();
+  test<3, 3>();
+}
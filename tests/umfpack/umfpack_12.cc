@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test SparseDirectUMFPACK::analyze() followed by several calls to
+// factorize_numeric() with matrices that share the same sparsity pattern,
+// and the solve() function for several vectors at once
+
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../testmatrix.h"
+#include "../tests.h"
+
+
+void
+check_solution(const SparseMatrix<double> &       A,
+               const std::vector<Vector<double>> &x,
+               const std::vector<Vector<double>> &b,
+               const bool                         transpose)
+{
+  double error = 0;
+  for (unsigned int c = 0; c < b.size(); ++c)
+    {
+      Vector<double> r(A.m());
+      if (transpose)
+        A.Tvmult(r, x[c]);
+      else
+        A.vmult(r, x[c]);
+      r -= b[c];
+      error = std::max(error, r.linfty_norm() / b[c].linfty_norm());
+    }
+  deallog << (transpose ? "transpose " : "") << "solve "
+          << (error < 1e-12 ? "OK" : "failed") << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 20;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+
+  // a nonsymmetric matrix, so that the transpose solve is checked as well
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  std::vector<Vector<double>> b(5, Vector<double>(dim));
+  for (Vector<double> &v : b)
+    for (unsigned int i = 0; i < dim; ++i)
+      v(i) = random_value<double>();
+
+  SparseDirectUMFPACK solver;
+  solver.analyze(A);
+
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      // change the values but not the pattern
+      for (SparseMatrix<double>::iterator entry = A.begin(); entry != A.end();
+           ++entry)
+        if (entry->row() == entry->column())
+          entry->value() += 1.;
+
+      solver.factorize_numeric(A);
+      deallog << "step " << step << std::endl;
+
+      for (const bool transpose : {false, true})
+        {
+          std::vector<Vector<double>> x = b;
+          solver.solve(x, transpose);
+          check_solution(A, x, b, transpose);
+        }
+
+      Vector<double> x = b[0];
+      solver.solve(x);
+      std::vector<Vector<double>> y = b;
+      solver.solve(y);
+      x -= y[0];
+      deallog << "single and multiple solve "
+              << (x.linfty_norm() == 0. ? "agree" : "differ") << std::endl;
+    }
+
+  const SparseDirectUMFPACK::Statistics &statistics = solver.get_statistics();
+  deallog << "analyses: " << statistics.n_analyses
+          << ", numeric factorizations: "
+          << statistics.n_numeric_factorizations
+          << ", solves: " << statistics.n_solves << std::endl;
+}